@@ -3,9 +3,11 @@ package com.example.cylinderworks
 import android.os.Build
 import com.example.cylinderworks.engine.EngineDiagnosticsRegistry
 import com.example.cylinderworks.engine.EngineRendererViewFactory
+import com.example.cylinderworks.engine.NativeBridge
 import io.flutter.embedding.android.FlutterActivity
 import io.flutter.embedding.engine.FlutterEngine
 import io.flutter.plugin.common.MethodChannel
+import java.io.File
 
 class MainActivity : FlutterActivity() {
 	override fun configureFlutterEngine(flutterEngine: FlutterEngine) {
@@ -30,6 +32,13 @@ class MainActivity : FlutterActivity() {
 						}
 						result.success(enriched)
 					}
+					// Only record with a build configured with -DENGINE_TRACE=ON.
+					"startTrace" -> result.success(NativeBridge.nativeStartTrace())
+					"dumpTrace" -> {
+						NativeBridge.nativeStopTrace()
+						val file = File(cacheDir, "engine_trace.json")
+						result.success(if (NativeBridge.nativeDumpTrace(file.absolutePath)) file.absolutePath else null)
+					}
 					else -> result.notImplemented()
 				}
 			}
@@ -21,6 +21,8 @@ class EngineRendererView(context: Context) : PlatformView, SurfaceHolder.Callbac
 
     companion object {
         private const val TAG = "EngineRendererView"
+        // Flutter packs pubspec assets under flutter_assets/ in the APK.
+        private const val DEFAULT_MODEL = "flutter_assets/assets/3d/Assem1.glb"
     }
 
     private val surfaceView: SurfaceView
@@ -34,6 +36,18 @@ class EngineRendererView(context: Context) : PlatformView, SurfaceHolder.Callbac
     init {
     rendererHandle = NativeBridge.nativeCreateRenderer()
     EngineDiagnosticsRegistry.register(this)
+    val shaderCacheDir = java.io.File(context.cacheDir, "shaders")
+    if (shaderCacheDir.isDirectory || shaderCacheDir.mkdirs()) {
+        NativeBridge.nativeSetCacheDirectory(rendererHandle, shaderCacheDir.absolutePath)
+    }
+    val assetCacheDir = java.io.File(context.cacheDir, "assets")
+    if (assetCacheDir.isDirectory || assetCacheDir.mkdirs()) {
+        NativeBridge.nativeSetAssetCacheDirectory(rendererHandle, assetCacheDir.absolutePath)
+    }
+    // The application's AssetManager lives as long as the process, which the
+    // native side relies on.
+    NativeBridge.nativeSetAssetManager(rendererHandle, context.applicationContext.assets)
+    NativeBridge.nativeLoadModel(rendererHandle, DEFAULT_MODEL)
 
         surfaceView = object : SurfaceView(context) {
             override fun onTouchEvent(event: MotionEvent): Boolean {
@@ -80,6 +94,7 @@ class EngineRendererView(context: Context) : PlatformView, SurfaceHolder.Callbac
             Log.e(TAG, "Failed to attach renderer surface")
             return
         }
+        // Only while something moves; the renderer stops requesting frames when idle.
         NativeBridge.nativeSetPreferredFps(rendererHandle, 120)
         NativeBridge.nativeStart(rendererHandle)
     }
@@ -16,5 +16,12 @@ object NativeBridge {
     external fun nativePan(handle: Long, dx: Float, dy: Float)
     external fun nativeZoom(handle: Long, delta: Float)
     external fun nativeSetPreferredFps(handle: Long, fps: Int)
+    external fun nativeSetCacheDirectory(handle: Long, path: String)
+    external fun nativeSetAssetCacheDirectory(handle: Long, path: String)
+    external fun nativeSetAssetManager(handle: Long, assetManager: android.content.res.AssetManager)
+    external fun nativeLoadModel(handle: Long, path: String)
     external fun nativeGetDiagnostics(handle: Long): Map<String, Any?>?
+    external fun nativeStartTrace(): Boolean
+    external fun nativeStopTrace()
+    external fun nativeDumpTrace(path: String): Boolean
 }
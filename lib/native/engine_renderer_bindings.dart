@@ -1,6 +1,8 @@
 import 'dart:ffi' as ffi;
 import 'dart:io' show Platform;
 
+import 'package:ffi/ffi.dart';
+
 typedef _CreateNative = ffi.Int64 Function();
 typedef _CreateDart = int Function();
 typedef _DestroyNative = ffi.Void Function(ffi.Int64);
@@ -19,6 +21,12 @@ typedef _StartNative = ffi.Void Function(ffi.Int64);
 typedef _StartDart = void Function(int);
 typedef _StopNative = ffi.Void Function(ffi.Int64);
 typedef _StopDart = void Function(int);
+typedef _TraceStartNative = ffi.Int32 Function();
+typedef _TraceStartDart = int Function();
+typedef _TraceStopNative = ffi.Void Function();
+typedef _TraceStopDart = void Function();
+typedef _TraceDumpNative = ffi.Int32 Function(ffi.Pointer<Utf8>);
+typedef _TraceDumpDart = int Function(ffi.Pointer<Utf8>);
 
 /// Thin wrapper around the native renderer library for use via FFI.
 /// The Android platform view already talks to these entrypoints through JNI,
@@ -39,6 +47,9 @@ class EngineRendererBindings {
   _FpsDart? _setFps;
   _StartDart? _start;
   _StopDart? _stop;
+  _TraceStartDart? _traceStart;
+  _TraceStopDart? _traceStop;
+  _TraceDumpDart? _traceDump;
 
   bool get isLoaded => _library != null;
 
@@ -63,6 +74,9 @@ class EngineRendererBindings {
   _setFps = _library!.lookupFunction<_FpsNative, _FpsDart>('engine_renderer_set_preferred_fps');
   _start = _library!.lookupFunction<_StartNative, _StartDart>('engine_renderer_start');
   _stop = _library!.lookupFunction<_StopNative, _StopDart>('engine_renderer_stop');
+  _traceStart = _library!.lookupFunction<_TraceStartNative, _TraceStartDart>('engine_trace_start');
+  _traceStop = _library!.lookupFunction<_TraceStopNative, _TraceStopDart>('engine_trace_stop');
+  _traceDump = _library!.lookupFunction<_TraceDumpNative, _TraceDumpDart>('engine_trace_dump');
     } on Object {
       // FFI is optional on platforms where we cannot load a native library yet.
       _library = null;
@@ -106,6 +120,32 @@ class EngineRendererBindings {
     _stop?.call(handle);
   }
 
+  /// Starts recording trace zones and counters in the native library. False
+  /// when it was built without tracing (-DENGINE_TRACE=ON).
+  bool startTrace() {
+    loadIfNeeded();
+    return (_traceStart?.call() ?? 0) != 0;
+  }
+
+  void stopTrace() {
+    _traceStop?.call();
+  }
+
+  /// Writes what has been recorded as Chrome trace JSON, for
+  /// chrome://tracing or ui.perfetto.dev.
+  bool dumpTrace(String path) {
+    final dump = _traceDump;
+    if (dump == null) {
+      return false;
+    }
+    final nativePath = path.toNativeUtf8();
+    try {
+      return dump(nativePath) != 0;
+    } finally {
+      malloc.free(nativePath);
+    }
+  }
+
   String? _resolveLibraryName() {
     if (Platform.isAndroid) {
       return 'libengine_renderer.so';
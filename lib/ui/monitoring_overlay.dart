@@ -7,10 +7,45 @@ import '../native/engine_renderer_bindings.dart';
 
 const _kDiagnosticsChannel = MethodChannel('engine/diagnostics');
 
+/// Rolling percentiles of one per-frame time, from the native histogram.
+class FrameTimeStats {
+  const FrameTimeStats({this.p50Ms, this.p90Ms, this.p99Ms, this.maxMs});
+
+  final double? p50Ms;
+  final double? p90Ms;
+  final double? p99Ms;
+  final double? maxMs;
+
+  String? get label {
+    if (p50Ms == null || p99Ms == null || maxMs == null || maxMs! <= 0) {
+      return null;
+    }
+    return '${p50Ms!.toStringAsFixed(1)} · ${p99Ms!.toStringAsFixed(1)} · ${maxMs!.toStringAsFixed(1)} ms';
+  }
+
+  static FrameTimeStats? fromMap(Map<Object?, Object?> map, String prefix) {
+    double? value(String suffix) {
+      final Object? raw = map['$prefix$suffix'];
+      return raw is num ? raw.toDouble() : null;
+    }
+
+    if (value('P50Ms') == null) {
+      return null;
+    }
+    return FrameTimeStats(
+      p50Ms: value('P50Ms'),
+      p90Ms: value('P90Ms'),
+      p99Ms: value('P99Ms'),
+      maxMs: value('MaxMs'),
+    );
+  }
+}
+
 class DiagnosticsSnapshot {
   DiagnosticsSnapshot({
     this.fps,
     this.frameTimeMs,
+    this.drawCalls,
     this.surfaceWidth,
     this.surfaceHeight,
     this.frameCount,
@@ -23,10 +58,35 @@ class DiagnosticsSnapshot {
     this.deviceModel,
     this.deviceManufacturer,
     this.eglReady,
+    this.inputLatencyMs,
+    this.droppedInputCount,
+    this.resumeToFirstFrameMs,
+    this.contextPreserved,
+    this.shaderCacheHits,
+    this.shaderCacheMisses,
+    this.shaderBuildMs,
+    this.trianglesSubmitted,
+    this.instancesCulled,
+    this.assetsPending,
+    this.uploadMs,
+    this.glStateIssued,
+    this.glStateElided,
+    this.idleFrames,
+    this.renderIdle,
+    this.renderScale,
+    this.vsyncPeriodMs,
+    this.swapInterval,
+    this.missedDeadlines,
+    this.frameInterval,
+    this.cpuTime,
+    this.swapTime,
+    this.jankFrames,
+    this.lowFps,
   });
 
   final double? fps;
   final double? frameTimeMs;
+  final int? drawCalls;
   final int? surfaceWidth;
   final int? surfaceHeight;
   final int? frameCount;
@@ -39,6 +99,30 @@ class DiagnosticsSnapshot {
   final String? deviceModel;
   final String? deviceManufacturer;
   final bool? eglReady;
+  final double? inputLatencyMs;
+  final int? droppedInputCount;
+  final double? resumeToFirstFrameMs;
+  final bool? contextPreserved;
+  final int? shaderCacheHits;
+  final int? shaderCacheMisses;
+  final double? shaderBuildMs;
+  final int? trianglesSubmitted;
+  final int? instancesCulled;
+  final int? assetsPending;
+  final double? uploadMs;
+  final int? glStateIssued;
+  final int? glStateElided;
+  final int? idleFrames;
+  final bool? renderIdle;
+  final double? renderScale;
+  final double? vsyncPeriodMs;
+  final int? swapInterval;
+  final int? missedDeadlines;
+  final FrameTimeStats? frameInterval;
+  final FrameTimeStats? cpuTime;
+  final FrameTimeStats? swapTime;
+  final int? jankFrames;
+  final double? lowFps;
 
   String get renderingLabel {
   final String gpu = (gpuRenderer?.isNotEmpty ?? false) ? gpuRenderer! : 'Unknown GPU';
@@ -54,6 +138,9 @@ class DiagnosticsSnapshot {
   }
 
   String get fpsLabel {
+    if (renderIdle == true) {
+      return 'idle';
+    }
     if (fps == null || fps!.isNaN) {
       return '-- fps';
     }
@@ -67,12 +154,120 @@ class DiagnosticsSnapshot {
     return '${frameTimeMs!.toStringAsFixed(2)} ms/frame';
   }
 
-  String? get frameCountLabel => frameCount?.toString();
+  String get drawCallsLabel {
+    if (drawCalls == null) {
+      return '-- draws';
+    }
+    return '$drawCalls draws';
+  }
+
+  String? get frameCountLabel {
+    if (frameCount == null) {
+      return null;
+    }
+    if (idleFrames == null) {
+      return frameCount.toString();
+    }
+    return '$frameCount rendered · $idleFrames idle';
+  }
+
+  String? get trianglesLabel {
+    if (trianglesSubmitted == null || trianglesSubmitted! <= 0) {
+      return null;
+    }
+    final count = trianglesSubmitted!;
+    if (count >= 1000000) {
+      return '${(count / 1000000).toStringAsFixed(2)} M / frame';
+    }
+    if (count >= 1000) {
+      return '${(count / 1000).toStringAsFixed(1)} k / frame';
+    }
+    return '$count / frame';
+  }
+
+  String? get culledLabel {
+    if (instancesCulled == null) {
+      return null;
+    }
+    return '$instancesCulled parts outside the view';
+  }
+
+  String? get inputLatencyLabel {
+    if (inputLatencyMs == null || inputLatencyMs!.isNaN || inputLatencyMs! <= 0) {
+      return null;
+    }
+    final dropped = droppedInputCount ?? 0;
+    final latency = '${inputLatencyMs!.toStringAsFixed(1)} ms';
+    return dropped > 0 ? '$latency · $dropped dropped' : latency;
+  }
+
+  String? get resumeLabel {
+    if (resumeToFirstFrameMs == null || resumeToFirstFrameMs!.isNaN || resumeToFirstFrameMs! <= 0) {
+      return null;
+    }
+    final context = contextPreserved == true ? 'warm' : 'cold';
+    return '${resumeToFirstFrameMs!.toStringAsFixed(1)} ms · $context';
+  }
+
+  String? get shaderLabel {
+    if (shaderBuildMs == null || shaderBuildMs!.isNaN) {
+      return null;
+    }
+    final hits = shaderCacheHits ?? 0;
+    final misses = shaderCacheMisses ?? 0;
+    return '${shaderBuildMs!.toStringAsFixed(1)} ms · $hits cached · $misses compiled';
+  }
+
+  String? get streamingLabel {
+    final pending = assetsPending ?? 0;
+    if (pending <= 0) {
+      return null;
+    }
+    final upload = uploadMs == null || uploadMs!.isNaN ? '--' : uploadMs!.toStringAsFixed(2);
+    return '$pending loading · $upload ms upload';
+  }
+
+  String? get glStateLabel {
+    if (glStateIssued == null || glStateElided == null) {
+      return null;
+    }
+    final total = glStateIssued! + glStateElided!;
+    if (total <= 0) {
+      return null;
+    }
+    final percent = (glStateElided! * 100 / total).toStringAsFixed(0);
+    return '$glStateIssued issued · $glStateElided skipped ($percent%)';
+  }
+
+  String? get renderScaleLabel {
+    if (renderScale == null || renderScale!.isNaN || renderScale! >= 1.0) {
+      return null;
+    }
+    return '${(renderScale! * 100).toStringAsFixed(0)}% resolution';
+  }
+
+  String? get pacingLabel {
+    if (vsyncPeriodMs == null || vsyncPeriodMs!.isNaN || vsyncPeriodMs! <= 0) {
+      return null;
+    }
+    final hz = (1000 / vsyncPeriodMs!).toStringAsFixed(0);
+    final interval = swapInterval ?? 1;
+    final cadence = interval > 1 ? ' · 1 in $interval' : '';
+    return '$hz Hz$cadence · ${missedDeadlines ?? 0} missed';
+  }
+
+  String? get smoothnessLabel {
+    if (lowFps == null || lowFps!.isNaN || lowFps! <= 0) {
+      return null;
+    }
+    return '1% low ${lowFps!.toStringAsFixed(1)} fps · ${jankFrames ?? 0} jank';
+  }
 
   DiagnosticsSnapshot merge(DiagnosticsSnapshot other) {
     return DiagnosticsSnapshot(
       fps: other.fps ?? fps,
       frameTimeMs: other.frameTimeMs ?? frameTimeMs,
+      drawCalls: other.drawCalls ?? drawCalls,
       surfaceWidth: other.surfaceWidth ?? surfaceWidth,
       surfaceHeight: other.surfaceHeight ?? surfaceHeight,
       frameCount: other.frameCount ?? frameCount,
@@ -85,6 +280,30 @@ class DiagnosticsSnapshot {
       deviceModel: other.deviceModel ?? deviceModel,
       deviceManufacturer: other.deviceManufacturer ?? deviceManufacturer,
       eglReady: other.eglReady ?? eglReady,
+      inputLatencyMs: other.inputLatencyMs ?? inputLatencyMs,
+      droppedInputCount: other.droppedInputCount ?? droppedInputCount,
+      resumeToFirstFrameMs: other.resumeToFirstFrameMs ?? resumeToFirstFrameMs,
+      contextPreserved: other.contextPreserved ?? contextPreserved,
+      shaderCacheHits: other.shaderCacheHits ?? shaderCacheHits,
+      shaderCacheMisses: other.shaderCacheMisses ?? shaderCacheMisses,
+      shaderBuildMs: other.shaderBuildMs ?? shaderBuildMs,
+      trianglesSubmitted: other.trianglesSubmitted ?? trianglesSubmitted,
+      instancesCulled: other.instancesCulled ?? instancesCulled,
+      assetsPending: other.assetsPending ?? assetsPending,
+      uploadMs: other.uploadMs ?? uploadMs,
+      glStateIssued: other.glStateIssued ?? glStateIssued,
+      glStateElided: other.glStateElided ?? glStateElided,
+      idleFrames: other.idleFrames ?? idleFrames,
+      renderIdle: other.renderIdle ?? renderIdle,
+      renderScale: other.renderScale ?? renderScale,
+      vsyncPeriodMs: other.vsyncPeriodMs ?? vsyncPeriodMs,
+      swapInterval: other.swapInterval ?? swapInterval,
+      missedDeadlines: other.missedDeadlines ?? missedDeadlines,
+      frameInterval: other.frameInterval ?? frameInterval,
+      cpuTime: other.cpuTime ?? cpuTime,
+      swapTime: other.swapTime ?? swapTime,
+      jankFrames: other.jankFrames ?? jankFrames,
+      lowFps: other.lowFps ?? lowFps,
     );
   }
 
@@ -117,6 +336,7 @@ class DiagnosticsSnapshot {
     return DiagnosticsSnapshot(
       fps: _asDouble(map['fps']),
       frameTimeMs: _asDouble(map['frameTimeMs']),
+      drawCalls: _asInt(map['drawCalls']),
       surfaceWidth: _asInt(map['surfaceWidth']),
       surfaceHeight: _asInt(map['surfaceHeight']),
       frameCount: _asInt(map['frameCount']),
@@ -129,6 +349,30 @@ class DiagnosticsSnapshot {
       deviceModel: _cast<String>(map['deviceModel']),
       deviceManufacturer: _cast<String>(map['deviceManufacturer']),
       eglReady: _cast<bool>(map['eglReady']),
+      inputLatencyMs: _asDouble(map['inputLatencyMs']),
+      droppedInputCount: _asInt(map['droppedInputCount']),
+      resumeToFirstFrameMs: _asDouble(map['resumeToFirstFrameMs']),
+      contextPreserved: _cast<bool>(map['contextPreserved']),
+      shaderCacheHits: _asInt(map['shaderCacheHits']),
+      shaderCacheMisses: _asInt(map['shaderCacheMisses']),
+      shaderBuildMs: _asDouble(map['shaderBuildMs']),
+      trianglesSubmitted: _asInt(map['trianglesSubmitted']),
+      instancesCulled: _asInt(map['instancesCulled']),
+      assetsPending: _asInt(map['assetsPending']),
+      uploadMs: _asDouble(map['uploadMs']),
+      glStateIssued: _asInt(map['glStateIssued']),
+      glStateElided: _asInt(map['glStateElided']),
+      idleFrames: _asInt(map['idleFrames']),
+      renderIdle: _cast<bool>(map['renderIdle']),
+      renderScale: _asDouble(map['renderScale']),
+      vsyncPeriodMs: _asDouble(map['vsyncPeriodMs']),
+      swapInterval: _asInt(map['swapInterval']),
+      missedDeadlines: _asInt(map['missedDeadlines']),
+      frameInterval: FrameTimeStats.fromMap(map, 'frameInterval'),
+      cpuTime: FrameTimeStats.fromMap(map, 'cpuTime'),
+      swapTime: FrameTimeStats.fromMap(map, 'swapTime'),
+      jankFrames: _asInt(map['jankFrames']),
+      lowFps: _asDouble(map['lowFps']),
     );
   }
 }
@@ -185,7 +429,10 @@ class _MonitoringOverlayState extends State<MonitoringOverlay> {
     final bool ffiEnabled = EngineRendererBindings.instance.isLoaded;
 
     final surfaceLabel = _snapshot.surfaceWidth != null && _snapshot.surfaceHeight != null
-        ? '${_snapshot.surfaceWidth}×${_snapshot.surfaceHeight}'
+        ? [
+            '${_snapshot.surfaceWidth}×${_snapshot.surfaceHeight}',
+            if (_snapshot.renderScaleLabel != null) _snapshot.renderScaleLabel!,
+          ].join(' · ')
         : null;
     final vendorLabel = (_snapshot.gpuVendor?.isNotEmpty ?? false) ? _snapshot.gpuVendor : null;
     final deviceParts = <String>[];
@@ -253,6 +500,8 @@ class _MonitoringOverlayState extends State<MonitoringOverlay> {
                   Expanded(child: _MetricTile(title: 'FPS', value: _snapshot.fpsLabel)),
                   const SizedBox(width: 8),
                   Expanded(child: _MetricTile(title: 'Frame', value: _snapshot.frameTimeLabel)),
+                  const SizedBox(width: 8),
+                  Expanded(child: _MetricTile(title: 'Draws', value: _snapshot.drawCallsLabel)),
                 ],
               ),
               if (surfaceLabel != null) ...[
@@ -263,6 +512,31 @@ class _MonitoringOverlayState extends State<MonitoringOverlay> {
                 const SizedBox(height: 8),
                 _InfoLine(label: 'Frames', value: _snapshot.frameCountLabel!),
               ],
+              if (_snapshot.trianglesLabel != null)
+                _InfoLine(label: 'Triangles', value: _snapshot.trianglesLabel!),
+              if (_snapshot.culledLabel != null)
+                _InfoLine(label: 'Culled', value: _snapshot.culledLabel!),
+              if (_snapshot.glStateLabel != null)
+                _InfoLine(label: 'GL state', value: _snapshot.glStateLabel!),
+              if (_snapshot.pacingLabel != null)
+                _InfoLine(label: 'Pacing', value: _snapshot.pacingLabel!),
+              if (_snapshot.smoothnessLabel != null)
+                _InfoLine(label: 'Smoothness', value: _snapshot.smoothnessLabel!),
+              // p50 · p99 · max over the last few seconds.
+              if (_snapshot.frameInterval?.label != null)
+                _InfoLine(label: 'Interval', value: _snapshot.frameInterval!.label!),
+              if (_snapshot.cpuTime?.label != null)
+                _InfoLine(label: 'CPU', value: _snapshot.cpuTime!.label!),
+              if (_snapshot.swapTime?.label != null)
+                _InfoLine(label: 'Swap', value: _snapshot.swapTime!.label!),
+              if (_snapshot.streamingLabel != null)
+                _InfoLine(label: 'Streaming', value: _snapshot.streamingLabel!),
+              if (_snapshot.inputLatencyLabel != null)
+                _InfoLine(label: 'Input', value: _snapshot.inputLatencyLabel!),
+              if (_snapshot.resumeLabel != null)
+                _InfoLine(label: 'Resume', value: _snapshot.resumeLabel!),
+              if (_snapshot.shaderLabel != null)
+                _InfoLine(label: 'Shaders', value: _snapshot.shaderLabel!),
             ],
           ),
         ),
@@ -0,0 +1,322 @@
+#include "asset_cache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "log.h"
+#include "mesh_cooker.h"
+
+namespace engine {
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+
+constexpr const char* kExtension = ".cwm";
+constexpr std::size_t kKeyDigits = 16;
+
+// XXH64 primes. Hashing the source must stay far cheaper than decoding it,
+// so it works on 32-byte stripes in four independent lanes.
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+uint64_t Rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t Round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    return Rotl(acc, 31) * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t lane) {
+    acc ^= Round(0, lane);
+    return acc * kPrime1 + kPrime4;
+}
+
+uint64_t Hash64(const uint8_t* data, std::size_t size, uint64_t seed) {
+    const uint8_t* p = data;
+    const uint8_t* const end = data + size;
+    uint64_t hash;
+    if (size >= 32) {
+        uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+        for (; p + 32 <= end; p += 32) {
+            for (int lane = 0; lane < 4; ++lane) {
+                lanes[lane] = Round(lanes[lane], Read64(p + lane * 8));
+            }
+        }
+        hash = Rotl(lanes[0], 1) + Rotl(lanes[1], 7) + Rotl(lanes[2], 12) + Rotl(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            hash = MergeRound(hash, lane);
+        }
+    } else {
+        hash = seed + kPrime5;
+    }
+    hash += size;
+
+    for (; p + 8 <= end; p += 8) {
+        hash ^= Round(0, Read64(p));
+        hash = Rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+        hash ^= Read32(p) * kPrime1;
+        hash = Rotl(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= *p * kPrime5;
+        hash = Rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+int64_t WallClockNanos() {
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+// Stamps an explicit modification time: timestamps the kernel picks itself
+// are only tick-accurate, which would tie entries used within a few ms.
+void SetModifiedNanos(const std::string& path, int64_t nanos) {
+    timespec times[2]{};
+    times[0].tv_sec = static_cast<time_t>(nanos / 1'000'000'000);
+    times[0].tv_nsec = static_cast<long>(nanos % 1'000'000'000);
+    times[1] = times[0];
+    utimensat(AT_FDCWD, path.c_str(), times, 0);
+}
+
+// Parses "<16 hex digits>.cwm"; anything else in the directory is ignored.
+bool ParseEntryName(const char* name, uint64_t* key) {
+    if (std::strlen(name) != kKeyDigits + std::strlen(kExtension) ||
+        std::strcmp(name + kKeyDigits, kExtension) != 0) {
+        return false;
+    }
+    char* parsedEnd = nullptr;
+    const unsigned long long value = std::strtoull(name, &parsedEnd, 16);
+    if (parsedEnd != name + kKeyDigits) {
+        return false;
+    }
+    *key = static_cast<uint64_t>(value);
+    return true;
+}
+
+bool EndsWith(const char* text, const char* suffix) {
+    const std::size_t length = std::strlen(text);
+    const std::size_t suffixLength = std::strlen(suffix);
+    return length >= suffixLength && std::strcmp(text + length - suffixLength, suffix) == 0;
+}
+
+}  // namespace
+
+bool AssetCache::Open(std::string directory, uint64_t maxBytes) {
+    std::scoped_lock lock(mutex_);
+    directory_ = std::move(directory);
+    maxBytes_ = maxBytes;
+    entries_.clear();
+    stats_.bytes = 0;
+    lastUseNanos_ = 0;
+    if (directory_.empty()) {
+        return false;
+    }
+
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) {
+        ENGINE_LOGW(kTag, "Asset cache directory %s is not readable", directory_.c_str());
+        directory_.clear();
+        return false;
+    }
+    while (const dirent* item = readdir(dir)) {
+        const std::string path = directory_ + "/" + item->d_name;
+        uint64_t key = 0;
+        struct stat info {};
+        if (EndsWith(item->d_name, ".tmp")) {
+            // Left behind by a store that never finished.
+            std::remove(path.c_str());
+        } else if (ParseEntryName(item->d_name, &key) && stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            const int64_t modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1'000'000'000 + info.st_mtim.tv_nsec;
+            entries_[key] = Entry{static_cast<uint64_t>(info.st_size), modified};
+            stats_.bytes += static_cast<uint64_t>(info.st_size);
+            lastUseNanos_ = std::max(lastUseNanos_, modified);
+        }
+    }
+    closedir(dir);
+
+    EvictLocked(0, 0);
+    return true;
+}
+
+bool AssetCache::Enabled() const {
+    std::scoped_lock lock(mutex_);
+    return !directory_.empty();
+}
+
+uint64_t AssetCache::KeyFor(std::span<const uint8_t> source) {
+    const uint64_t seed = (static_cast<uint64_t>(kCookerVersion) << 32) | cooked::kVersion;
+    return Hash64(source.data(), source.size(), seed);
+}
+
+std::string AssetCache::PathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx%s", static_cast<unsigned long long>(key), kExtension);
+    return directory_ + name;
+}
+
+bool AssetCache::Load(uint64_t key, CookedMesh* mesh) {
+    std::string path;
+    {
+        std::scoped_lock lock(mutex_);
+        if (directory_.empty()) {
+            return false;
+        }
+        if (entries_.find(key) == entries_.end()) {
+            ++stats_.misses;
+            return false;
+        }
+        path = PathFor(key);
+    }
+
+    // Mapped and validated outside the lock; a concurrent eviction only
+    // unlinks the file, the mapping stays valid.
+    std::string error;
+    if (!mesh->Open(path.c_str(), &error)) {
+        ENGINE_LOGW(kTag, "Discarding cached asset %016llx: %s", static_cast<unsigned long long>(key), error.c_str());
+        std::scoped_lock lock(mutex_);
+        RemoveLocked(key);
+        ++stats_.misses;
+        return false;
+    }
+
+    std::scoped_lock lock(mutex_);
+    auto entry = entries_.find(key);
+    if (entry != entries_.end()) {
+        // The modification time is the recency the next launch starts from.
+        entry->second.lastUseNanos = NextUseNanosLocked();
+        SetModifiedNanos(path, entry->second.lastUseNanos);
+    }
+    ++stats_.hits;
+    return true;
+}
+
+bool AssetCache::Store(uint64_t key, std::span<const uint8_t> cooked) {
+    std::string path;
+    std::string tempPath;
+    {
+        std::scoped_lock lock(mutex_);
+        if (directory_.empty() || cooked.empty() || cooked.size() > maxBytes_) {
+            return false;
+        }
+        path = PathFor(key);
+        tempPath = path + "." + std::to_string(nextTempId_++) + ".tmp";
+    }
+
+    // Written outside the lock so workers storing different assets do not
+    // serialise on disk I/O.
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        ENGINE_LOGW(kTag, "Cannot write cached asset to %s", tempPath.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(cooked.data(), 1, cooked.size(), file) == cooked.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        ENGINE_LOGW(kTag, "Failed to write cached asset %s", tempPath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::scoped_lock lock(mutex_);
+    auto existing = entries_.find(key);
+    if (existing != entries_.end()) {
+        // Replaced by the rename below.
+        stats_.bytes -= existing->second.bytes;
+        entries_.erase(existing);
+    }
+    EvictLocked(cooked.size(), key);
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ENGINE_LOGW(kTag, "Failed to store cached asset %s", path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    const int64_t useNanos = NextUseNanosLocked();
+    SetModifiedNanos(path, useNanos);
+    entries_[key] = Entry{cooked.size(), useNanos};
+    stats_.bytes += cooked.size();
+    ++stats_.stores;
+    return true;
+}
+
+void AssetCache::Remove(uint64_t key) {
+    std::scoped_lock lock(mutex_);
+    RemoveLocked(key);
+}
+
+AssetCache::Stats AssetCache::GetStats() const {
+    std::scoped_lock lock(mutex_);
+    Stats stats = stats_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+int64_t AssetCache::NextUseNanosLocked() {
+    // Strictly increasing, so two uses never tie even if the clock stalls.
+    lastUseNanos_ = std::max(lastUseNanos_ + 1, WallClockNanos());
+    return lastUseNanos_;
+}
+
+void AssetCache::RemoveLocked(uint64_t key) {
+    if (directory_.empty()) {
+        return;
+    }
+    auto entry = entries_.find(key);
+    if (entry != entries_.end()) {
+        stats_.bytes -= entry->second.bytes;
+        entries_.erase(entry);
+    }
+    std::remove(PathFor(key).c_str());
+}
+
+void AssetCache::EvictLocked(uint64_t incoming, uint64_t keep) {
+    while (stats_.bytes + incoming > maxBytes_) {
+        auto oldest = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->first != keep && (oldest == entries_.end() || it->second.lastUseNanos < oldest->second.lastUseNanos)) {
+                oldest = it;
+            }
+        }
+        if (oldest == entries_.end()) {
+            return;
+        }
+        RemoveLocked(oldest->first);
+        ++stats_.evictions;
+    }
+}
+
+}  // namespace engine
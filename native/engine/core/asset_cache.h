@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "cooked_mesh.h"
+
+namespace engine {
+
+// Persistent cache of cooked meshes. An entry is keyed by a content hash of
+// the source asset plus the cooker and cooked format versions, so editing an
+// asset or changing the importer simply misses. A hit maps the entry straight
+// into a CookedMesh, which skips the read and the decode entirely.
+//
+// The total size is capped. When a store would go over the cap, the least
+// recently used entries are removed. Recency is stored as the file
+// modification time, which Load and Store set, so the order survives
+// restarts. Entries are written to a temporary name and renamed, so a crash
+// never leaves a partial entry. Anything that fails validation is deleted
+// and counted as a miss.
+//
+// Safe to use from several worker threads at once. Disabled until Open.
+class AssetCache {
+public:
+    static constexpr uint64_t kDefaultMaxBytes = 64ull * 1024 * 1024;
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t stores{0};
+        uint64_t evictions{0};
+        uint64_t bytes{0};  // Current size of all entries.
+        std::size_t entries{0};
+    };
+
+    // Uses `directory`, which must already exist, and indexes the entries it
+    // already holds. Evicts down to `maxBytes` at once if needed. An empty
+    // path disables the cache.
+    bool Open(std::string directory, uint64_t maxBytes = kDefaultMaxBytes);
+    bool Enabled() const;
+
+    // Hash of the source bytes (64-bit, XXH64-style), seeded with
+    // kCookerVersion and cooked::kVersion.
+    static uint64_t KeyFor(std::span<const uint8_t> source);
+
+    bool Load(uint64_t key, CookedMesh* mesh);
+    bool Store(uint64_t key, std::span<const uint8_t> cooked);
+    void Remove(uint64_t key);
+
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        uint64_t bytes{0};
+        int64_t lastUseNanos{0};
+    };
+
+    std::string PathFor(uint64_t key) const;
+    int64_t NextUseNanosLocked();
+    void RemoveLocked(uint64_t key);
+    // Drops least recently used entries, never `keep`, until `incoming` more
+    // bytes fit.
+    void EvictLocked(uint64_t incoming, uint64_t keep);
+
+    mutable std::mutex mutex_;
+    std::string directory_;
+    uint64_t maxBytes_{kDefaultMaxBytes};
+    std::unordered_map<uint64_t, Entry> entries_;
+    Stats stats_{};
+    uint64_t nextTempId_{0};
+    int64_t lastUseNanos_{0};
+};
+
+}  // namespace engine
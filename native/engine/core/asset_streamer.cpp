@@ -0,0 +1,110 @@
+#include "asset_streamer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "glb_asset.h"
+#include "mesh_cooker.h"
+#include "trace.h"
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t kGlbMagic = 0x46546C67u;  // "glTF"
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+AssetStreamer::AssetStreamer(unsigned workerCount) : pool_(workerCount) {}
+
+uint64_t AssetStreamer::Request(std::string name, AssetReader reader) {
+    const uint64_t id = nextId_.fetch_add(1, std::memory_order_relaxed);
+    inFlight_.fetch_add(1, std::memory_order_relaxed);
+    pool_.Submit([this, id, name = std::move(name), reader = std::move(reader)]() mutable {
+        auto model = std::make_unique<DecodedModel>();
+        model->id = id;
+        model->name = std::move(name);
+        Decode(model.get(), reader);
+        std::scoped_lock lock(completedMutex_);
+        completed_.push_back(std::move(model));
+    });
+    return id;
+}
+
+void AssetStreamer::TakeCompleted(std::vector<std::unique_ptr<DecodedModel>>* out) {
+    std::scoped_lock lock(completedMutex_);
+    inFlight_.fetch_sub(completed_.size(), std::memory_order_relaxed);
+    for (auto& model : completed_) {
+        out->push_back(std::move(model));
+    }
+    completed_.clear();
+}
+
+AssetReader AssetStreamer::FileReader(std::string path) {
+    return [path = std::move(path)](std::vector<uint8_t>* bytes, std::string* error) {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            *error = "cannot open " + path;
+            return false;
+        }
+        std::fseek(file, 0, SEEK_END);
+        const long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        bytes->resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+        const bool read = std::fread(bytes->data(), 1, bytes->size(), file) == bytes->size();
+        std::fclose(file);
+        if (!read || bytes->empty()) {
+            *error = "cannot read " + path;
+            return false;
+        }
+        return true;
+    };
+}
+
+void AssetStreamer::Decode(DecodedModel* model, const AssetReader& reader) {
+    ENGINE_TRACE_SCOPE("DecodeAsset");
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> source;
+    if (!reader(&source, &model->error)) {
+        return;
+    }
+    model->readMs = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    uint32_t magic = 0;
+    if (source.size() >= sizeof(magic)) {
+        std::memcpy(&magic, source.data(), sizeof(magic));
+    }
+    uint64_t cacheKey = 0;
+    if (magic == kGlbMagic) {
+        cacheKey = cache_.Enabled() ? AssetCache::KeyFor(source) : 0;
+        if (cacheKey != 0 && cache_.Load(cacheKey, &model->mesh)) {
+            model->cached = true;
+            model->decodeMs = MillisecondsSince(start);
+            model->ok = true;
+            return;
+        }
+        GlbAsset asset;
+        if (!asset.Parse(source, &model->error) || !CookGlb(asset, &model->blob, nullptr, &model->error)) {
+            return;
+        }
+    } else {
+        // Already cooked offline.
+        model->blob = std::move(source);
+    }
+    if (!model->mesh.Parse(model->blob, &model->error)) {
+        return;
+    }
+    if (cacheKey != 0) {
+        cache_.Store(cacheKey, model->blob);
+    }
+    model->decodeMs = MillisecondsSince(start);
+    model->ok = true;
+}
+
+}  // namespace engine
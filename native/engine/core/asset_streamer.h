@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "asset_cache.h"
+#include "cooked_mesh.h"
+#include "worker_pool.h"
+
+namespace engine {
+
+// Produces the raw bytes of a source asset (.glb or cooked .cwm). Runs on a
+// worker thread, so it must not touch GL or renderer state.
+using AssetReader = std::function<bool(std::vector<uint8_t>* bytes, std::string* error)>;
+
+// A model decoded off the render thread, ready for GL upload.
+struct DecodedModel {
+    uint64_t id{0};
+    std::string name;
+    bool ok{false};
+    std::string error;
+    // Cooked mesh bytes `mesh` points into; empty when `mesh` maps an
+    // AssetCache entry instead.
+    std::vector<uint8_t> blob;
+    CookedMesh mesh;
+    bool cached{false};
+    double readMs{0.0};
+    double decodeMs{0.0};  // Hash plus cache lookup, or parse, LODs and cooking.
+};
+
+// Loads assets on a worker pool: file read, GLB parse and cooking (index
+// optimisation, LOD chain, quantisation) all happen off the render thread.
+// Cooked GLBs go into Cache() once it is opened, and a later request for the
+// same source bytes maps that entry instead of decoding again. Finished
+// models, including failures, are collected with TakeCompleted.
+class AssetStreamer {
+public:
+    explicit AssetStreamer(unsigned workerCount = WorkerPool::DefaultThreadCount());
+
+    // Queues a load and returns its id, which the DecodedModel carries back.
+    uint64_t Request(std::string name, AssetReader reader);
+
+    // Moves every model finished since the last call into `out`. Never
+    // blocks on decoding.
+    void TakeCompleted(std::vector<std::unique_ptr<DecodedModel>>* out);
+
+    // Requests not yet returned by TakeCompleted.
+    std::size_t InFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+
+    // Open it before the first Request to make every load cacheable.
+    AssetCache& Cache() { return cache_; }
+
+    static AssetReader FileReader(std::string path);
+
+private:
+    void Decode(DecodedModel* model, const AssetReader& reader);
+
+    std::mutex completedMutex_;
+    std::vector<std::unique_ptr<DecodedModel>> completed_;
+    std::atomic<uint64_t> nextId_{1};
+    std::atomic<std::size_t> inFlight_{0};
+    AssetCache cache_;
+    // Declared last so workers are joined before the queue they write to goes.
+    WorkerPool pool_;
+};
+
+}  // namespace engine
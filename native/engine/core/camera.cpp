@@ -23,59 +23,125 @@ void OrbitCamera::Reset() {
     pitch_ = 0.6108652382f;  // 35 degrees
     viewportWidth_ = 1;
     viewportHeight_ = 1;
+    MarkViewDirty();
+    MarkProjectionDirty();
 }
 
 void OrbitCamera::Orbit(float deltaYaw, float deltaPitch) {
+    const float yaw = yaw_;
+    const float pitch = pitch_;
     yaw_ += deltaYaw * kOrbitSensitivity;
     pitch_ -= deltaPitch * kOrbitSensitivity;
     ClampAngles();
+    // Orbiting against the pitch limit is not a camera change.
+    if (yaw_ != yaw || pitch_ != pitch) {
+        MarkViewDirty();
+    }
 }
 
 void OrbitCamera::Pan(float deltaX, float deltaY) {
-    // Translate along camera's right and up axes.
-    const Vec3 eye = Vec3{
-        target_.x + distance_ * std::cos(pitch_) * std::sin(yaw_),
-        target_.y + distance_ * std::sin(pitch_),
-        target_.z + distance_ * std::cos(pitch_) * std::cos(yaw_)
-    };
-
-    const Vec3 forward = Normalize(target_ - eye);
-    const Vec3 worldUp{0.0f, 1.0f, 0.0f};
-    const Vec3 right = Normalize(Cross(forward, worldUp));
-    const Vec3 up = Normalize(Cross(right, forward));
+    if (deltaX == 0.0f && deltaY == 0.0f) {
+        return;
+    }
+    // Translate along camera's right and up axes, which are the first two
+    // rows of the (cached) view rotation.
+    const Mat4& view = ViewMatrix();
+    const Vec3 right{view.data[0], view.data[4], view.data[8]};
+    const Vec3 up{view.data[1], view.data[5], view.data[9]};
 
     const float scale = distance_ * kPanSensitivity;
     target_ += right * (-deltaX * scale);
     target_ += up * (deltaY * scale);
+    MarkViewDirty();
 }
 
 void OrbitCamera::Zoom(float deltaDistance) {
+    const float distance = distance_;
     distance_ *= std::exp(-deltaDistance * kZoomSensitivity);
     ClampDistance();
+    // Pinching against the zoom limit is not a camera change.
+    if (distance_ != distance) {
+        MarkViewDirty();
+    }
 }
 
 void OrbitCamera::SetViewport(int width, int height) {
-    viewportWidth_ = std::max(1, width);
-    viewportHeight_ = std::max(1, height);
+    width = std::max(1, width);
+    height = std::max(1, height);
+    if (width == viewportWidth_ && height == viewportHeight_) {
+        return;
+    }
+    viewportWidth_ = width;
+    viewportHeight_ = height;
+    MarkProjectionDirty();
+}
+
+const Mat4& OrbitCamera::ViewMatrix() const {
+    UpdateCache();
+    return view_;
+}
+
+const Mat4& OrbitCamera::ProjectionMatrix() const {
+    UpdateCache();
+    return projection_;
+}
+
+const Mat4& OrbitCamera::ViewProjectionMatrix() const {
+    UpdateCache();
+    return viewProjection_;
+}
+
+const Mat4& OrbitCamera::InverseViewProjectionMatrix() const {
+    UpdateCache();
+    return inverseViewProjection_;
+}
+
+const Frustum& OrbitCamera::FrustumPlanes() const {
+    UpdateCache();
+    return frustum_;
 }
 
-Mat4 OrbitCamera::ViewMatrix() const {
-    const Vec3 eye = EyePosition();
-    const Vec3 up{0.0f, 1.0f, 0.0f};
-    return LookAt(eye, target_, up);
+const Vec3& OrbitCamera::EyePosition() const {
+    UpdateCache();
+    return eye_;
 }
 
-Mat4 OrbitCamera::ProjectionMatrix() const {
-    const float aspect = static_cast<float>(viewportWidth_) / static_cast<float>(viewportHeight_);
-    return Perspective(Radians(50.0f), aspect, 0.1f, 500.0f);
+void OrbitCamera::MarkViewDirty() {
+    viewDirty_ = true;
+    ++version_;
 }
 
-Vec3 OrbitCamera::EyePosition() const {
-    return Vec3{
-        target_.x + distance_ * std::cos(pitch_) * std::sin(yaw_),
-        target_.y + distance_ * std::sin(pitch_),
-        target_.z + distance_ * std::cos(pitch_) * std::cos(yaw_)
-    };
+void OrbitCamera::MarkProjectionDirty() {
+    projectionDirty_ = true;
+    ++version_;
+}
+
+void OrbitCamera::UpdateCache() const {
+    if (!viewDirty_ && !projectionDirty_) {
+        return;
+    }
+
+    if (viewDirty_) {
+        const float cosPitch = std::cos(pitch_);
+        eye_ = Vec3{
+            target_.x + distance_ * cosPitch * std::sin(yaw_),
+            target_.y + distance_ * std::sin(pitch_),
+            target_.z + distance_ * cosPitch * std::cos(yaw_)
+        };
+        const Vec3 up{0.0f, 1.0f, 0.0f};
+        view_ = LookAt(eye_, target_, up);
+    }
+
+    if (projectionDirty_) {
+        const float aspect = static_cast<float>(viewportWidth_) / static_cast<float>(viewportHeight_);
+        projection_ = Perspective(Radians(50.0f), aspect, 0.1f, 500.0f);
+    }
+
+    viewProjection_ = Multiply(projection_, view_);
+    inverseViewProjection_ = Inverse(viewProjection_);
+    frustum_ = ExtractFrustum(viewProjection_);
+    viewDirty_ = false;
+    projectionDirty_ = false;
 }
 
 void OrbitCamera::ClampAngles() {
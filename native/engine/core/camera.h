@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+
+#include "frustum.h"
 #include "math_types.h"
 
 namespace engine {
@@ -15,11 +18,24 @@ public:
 
     void SetViewport(int width, int height);
 
-    Mat4 ViewMatrix() const;
-    Mat4 ProjectionMatrix() const;
-    Vec3 EyePosition() const;
+    // Derived matrices are cached and only rebuilt after Orbit/Pan/Zoom/
+    // SetViewport/Reset. The returned references stay valid until the next
+    // mutating call.
+    const Mat4& ViewMatrix() const;
+    const Mat4& ProjectionMatrix() const;
+    const Mat4& ViewProjectionMatrix() const;
+    const Mat4& InverseViewProjectionMatrix() const;
+    const Frustum& FrustumPlanes() const;
+    const Vec3& EyePosition() const;
     Vec3 Target() const { return target_; }
 
+    // Incremented on every state change. Consumers (culling, picking,
+    // render-on-demand) can compare against a stored value to skip work.
+    uint64_t Version() const { return version_; }
+
+    int ViewportWidth() const { return viewportWidth_; }
+    int ViewportHeight() const { return viewportHeight_; }
+
     float Distance() const { return distance_; }
     float Yaw() const { return yaw_; }
     float Pitch() const { return pitch_; }
@@ -27,6 +43,9 @@ public:
 private:
     void ClampAngles();
     void ClampDistance();
+    void MarkViewDirty();
+    void MarkProjectionDirty();
+    void UpdateCache() const;
 
     Vec3 target_{0.0f, 0.0f, 0.0f};
     float distance_{6.0f};
@@ -37,6 +56,17 @@ private:
 
     float minDistance_{0.5f};
     float maxDistance_{50.0f};
+
+    uint64_t version_{0};
+
+    mutable bool viewDirty_{true};
+    mutable bool projectionDirty_{true};
+    mutable Vec3 eye_{};
+    mutable Mat4 view_{};
+    mutable Mat4 projection_{};
+    mutable Mat4 viewProjection_{};
+    mutable Mat4 inverseViewProjection_{};
+    mutable Frustum frustum_{};
 };
 
 }  // namespace engine
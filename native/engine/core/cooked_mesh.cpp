@@ -0,0 +1,102 @@
+#include "cooked_mesh.h"
+
+namespace engine {
+
+namespace {
+
+bool Fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+bool SectionFits(std::span<const uint8_t> bytes, uint64_t offset, uint64_t size) {
+    return offset % cooked::kSectionAlignment == 0 && offset <= bytes.size() && size <= bytes.size() - offset;
+}
+
+template <typename T>
+std::span<const T> Table(std::span<const uint8_t> bytes, uint64_t offset, uint32_t count) {
+    return {reinterpret_cast<const T*>(bytes.data() + offset), count};
+}
+
+}  // namespace
+
+bool CookedMesh::Open(const char* path, std::string* error) {
+    file_.Close();
+    if (!file_.Open(path)) {
+        header_ = nullptr;
+        return Fail(error, "cannot map cooked mesh");
+    }
+    const std::span<const uint8_t> bytes = file_.Bytes();
+    if (!Parse(bytes, error)) {
+        file_.Close();
+        return false;
+    }
+    return true;
+}
+
+bool CookedMesh::Parse(std::span<const uint8_t> bytes, std::string* error) {
+    header_ = nullptr;
+    if (bytes.size() < sizeof(cooked::Header) ||
+        reinterpret_cast<uintptr_t>(bytes.data()) % alignof(cooked::Header) != 0) {
+        return Fail(error, "cooked mesh too small or misaligned");
+    }
+
+    const auto* header = reinterpret_cast<const cooked::Header*>(bytes.data());
+    if (header->magic != cooked::kMagic) {
+        return Fail(error, "not a cooked mesh");
+    }
+    if (header->version != cooked::kVersion) {
+        return Fail(error, "cooked mesh version mismatch; re-run the asset cooker");
+    }
+    if (!SectionFits(bytes, header->submeshOffset, uint64_t{header->submeshCount} * sizeof(cooked::Submesh)) ||
+        !SectionFits(bytes, header->instanceOffset, uint64_t{header->instanceCount} * sizeof(cooked::Instance)) ||
+        !SectionFits(bytes, header->materialOffset, uint64_t{header->materialCount} * sizeof(cooked::Material)) ||
+        !SectionFits(bytes, header->vertexOffset, header->vertexSize) ||
+        !SectionFits(bytes, header->indexOffset, header->indexSize)) {
+        return Fail(error, "cooked mesh section out of range");
+    }
+
+    submeshes_ = Table<cooked::Submesh>(bytes, header->submeshOffset, header->submeshCount);
+    instances_ = Table<cooked::Instance>(bytes, header->instanceOffset, header->instanceCount);
+    materials_ = Table<cooked::Material>(bytes, header->materialOffset, header->materialCount);
+    vertices_ = bytes.subspan(header->vertexOffset, header->vertexSize);
+    indices_ = bytes.subspan(header->indexOffset, header->indexSize);
+
+    for (const cooked::Submesh& submesh : submeshes_) {
+        const uint64_t indexSize = submesh.indexType == cooked::kIndexUint16 ? 2 : 4;
+        if ((submesh.indexType != cooked::kIndexUint16 && submesh.indexType != cooked::kIndexUint32) ||
+            submesh.vertexOffset % sizeof(cooked::Vertex) != 0 ||
+            uint64_t{submesh.vertexOffset} + uint64_t{submesh.vertexCount} * sizeof(cooked::Vertex) > vertices_.size() ||
+            submesh.lodCount == 0 || submesh.lodCount > cooked::kMaxLods ||
+            submesh.material >= static_cast<int32_t>(header->materialCount)) {
+            return Fail(error, "cooked submesh out of range");
+        }
+        for (uint32_t i = 0; i < submesh.lodCount; ++i) {
+            const cooked::Lod& lod = submesh.lods[i];
+            if (lod.indexOffset % indexSize != 0 ||
+                uint64_t{lod.indexOffset} + uint64_t{lod.indexCount} * indexSize > indices_.size() ||
+                (i > 0 && lod.error < submesh.lods[i - 1].error)) {
+                return Fail(error, "cooked submesh LOD out of range");
+            }
+            // GLES 3.0 leaves out-of-range vertex fetches undefined, so a
+            // damaged blob must not get as far as the GPU. The cooker records
+            // the largest index; scanning the indices here would cost more
+            // than the rest of the load.
+            if (lod.indexCount > 0 && lod.maxIndex >= submesh.vertexCount) {
+                return Fail(error, "cooked index out of range");
+            }
+        }
+    }
+    for (const cooked::Instance& instance : instances_) {
+        if (instance.submesh >= header->submeshCount) {
+            return Fail(error, "cooked instance references an invalid submesh");
+        }
+    }
+
+    header_ = header;
+    return true;
+}
+
+}  // namespace engine
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "mapped_file.h"
+
+namespace engine {
+
+// GPU-ready mesh blob produced offline by the asset cooker (tools/
+// asset_cooker) from a .glb. All sections are 16-byte aligned and the vertex
+// and index sections can be handed to glBufferData straight from the mapping.
+//
+// Layout: CookedMeshHeader, then the submesh, instance and material tables,
+// then the vertex section, then the index section.
+namespace cooked {
+
+constexpr uint32_t kMagic = 0x534D5743u;  // "CWMS"
+constexpr uint32_t kVersion = 3;
+constexpr std::size_t kSectionAlignment = 16;
+constexpr uint32_t kIndexUint16 = 0x1403;  // GL_UNSIGNED_SHORT
+constexpr uint32_t kIndexUint32 = 0x1405;  // GL_UNSIGNED_INT
+constexpr uint32_t kMaxLods = 4;
+
+// Positions are unorm16 relative to the submesh box (position = posMin +
+// q / 65535 * posExtent); normals are octahedral snorm16. 12 bytes per vertex
+// against 24 for float position + normal.
+struct Vertex {
+    uint16_t position[3];
+    int16_t normal[2];
+    uint16_t padding;
+};
+static_assert(sizeof(Vertex) == 12, "cooked vertex must stay 12 bytes");
+
+// One level of detail: an index range over the submesh's shared vertices.
+// `error` is the object-space deviation from LOD 0 (0 for LOD 0 itself) and
+// never decreases along the chain.
+struct Lod {
+    uint32_t indexOffset;  // Bytes into the index section.
+    uint32_t indexCount;
+    float error;
+    uint32_t maxIndex;  // Highest index in the range, recorded by the cooker.
+};
+
+struct Submesh {
+    uint32_t vertexOffset;  // Bytes into the vertex section.
+    uint32_t vertexCount;
+    uint32_t indexType;     // kIndexUint16 or kIndexUint32.
+    int32_t material;       // -1 for the default material.
+    uint32_t lodCount;      // 1..kMaxLods; lods[0] is full detail.
+    uint32_t padding[3];
+    Lod lods[kMaxLods];
+    float posMin[3];
+    float posExtent[3];
+    float sphereCenter[3];  // Object-space bounding sphere.
+    float sphereRadius;
+};
+
+// One placement of a submesh in the asset, with the node hierarchy already
+// flattened into a world matrix (column-major).
+struct Instance {
+    uint32_t submesh;
+    uint32_t padding[3];
+    float world[16];
+};
+
+struct Material {
+    float baseColor[4];
+    float metallic;
+    float roughness;
+    uint32_t padding[2];
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t submeshCount;
+    uint32_t instanceCount;
+    uint32_t materialCount;
+    uint32_t padding[3];
+    uint64_t submeshOffset;
+    uint64_t instanceOffset;
+    uint64_t materialOffset;
+    uint64_t vertexOffset;
+    uint64_t vertexSize;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+    float boundsMin[3];  // World-space bounds of every instance.
+    float boundsMax[3];
+};
+
+}  // namespace cooked
+
+// Memory-mapped reader for cooked mesh blobs. Open/Parse validate the header
+// and every table entry against the section sizes, and each LOD's recorded
+// maxIndex against its submesh's vertex count; afterwards the spans can be
+// used without further checks. The index data itself is not read, so a load
+// costs the same whatever the mesh size.
+class CookedMesh {
+public:
+    bool Open(const char* path, std::string* error);
+    // Parses caller-owned bytes, which must outlive this object.
+    bool Parse(std::span<const uint8_t> bytes, std::string* error);
+
+    const cooked::Header& Header() const { return *header_; }
+    std::span<const cooked::Submesh> Submeshes() const { return submeshes_; }
+    std::span<const cooked::Instance> Instances() const { return instances_; }
+    std::span<const cooked::Material> Materials() const { return materials_; }
+    std::span<const uint8_t> VertexData() const { return vertices_; }
+    std::span<const uint8_t> IndexData() const { return indices_; }
+
+private:
+    MappedFile file_;
+    const cooked::Header* header_{nullptr};
+    std::span<const cooked::Submesh> submeshes_;
+    std::span<const cooked::Instance> instances_;
+    std::span<const cooked::Material> materials_;
+    std::span<const uint8_t> vertices_;
+    std::span<const uint8_t> indices_;
+};
+
+}  // namespace engine
@@ -0,0 +1,274 @@
+#include "culling.h"
+
+#include <cmath>
+
+namespace engine {
+
+namespace {
+
+inline std::size_t AppendVisible(unsigned mask, uint32_t base, uint32_t* out, std::size_t count) {
+    while (mask != 0) {
+        out[count++] = base + static_cast<uint32_t>(__builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+inline float PlaneDistance(const Vec4& plane, float x, float y, float z) {
+    return plane.x * x + plane.y * y + plane.z * z + plane.w;
+}
+
+#if defined(ENGINE_MATH_SIMD)
+using simd::F4;
+
+constexpr std::size_t kLanes = 4;
+
+F4 LoadLanes(const float* src, std::size_t count) {
+    if (count == kLanes) {
+        return simd::Load(src);
+    }
+    float lanes[kLanes] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (std::size_t i = 0; i < count; ++i) {
+        lanes[i] = src[i];
+    }
+    return simd::Load(lanes);
+}
+
+// Planes with every component broadcast, plus |normal| for box tests.
+struct SplatPlanes {
+    F4 a[Frustum::kPlaneCount];
+    F4 b[Frustum::kPlaneCount];
+    F4 c[Frustum::kPlaneCount];
+    F4 d[Frustum::kPlaneCount];
+    F4 absA[Frustum::kPlaneCount];
+    F4 absB[Frustum::kPlaneCount];
+    F4 absC[Frustum::kPlaneCount];
+};
+
+SplatPlanes Splat(const Frustum& frustum) {
+    SplatPlanes result;
+    for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+        const Vec4& plane = frustum.planes[p];
+        result.a[p] = simd::Splat(plane.x);
+        result.b[p] = simd::Splat(plane.y);
+        result.c[p] = simd::Splat(plane.z);
+        result.d[p] = simd::Splat(plane.w);
+        result.absA[p] = simd::Splat(std::fabs(plane.x));
+        result.absB[p] = simd::Splat(std::fabs(plane.y));
+        result.absC[p] = simd::Splat(std::fabs(plane.z));
+    }
+    return result;
+}
+
+inline F4 PlaneDistanceLanes(const SplatPlanes& planes, int p, F4 x, F4 y, F4 z) {
+    F4 dist = simd::Mul(planes.a[p], x);
+    dist = simd::MulAdd(dist, planes.b[p], y);
+    dist = simd::MulAdd(dist, planes.c[p], z);
+    return simd::Add(dist, planes.d[p]);
+}
+#endif
+
+#if defined(ENGINE_MATH_AVX)
+constexpr std::size_t kWideLanes = 8;
+
+struct WidePlanes {
+    __m256 a[Frustum::kPlaneCount];
+    __m256 b[Frustum::kPlaneCount];
+    __m256 c[Frustum::kPlaneCount];
+    __m256 d[Frustum::kPlaneCount];
+    __m256 absA[Frustum::kPlaneCount];
+    __m256 absB[Frustum::kPlaneCount];
+    __m256 absC[Frustum::kPlaneCount];
+};
+
+WidePlanes SplatWide(const Frustum& frustum) {
+    WidePlanes result;
+    for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+        const Vec4& plane = frustum.planes[p];
+        result.a[p] = _mm256_set1_ps(plane.x);
+        result.b[p] = _mm256_set1_ps(plane.y);
+        result.c[p] = _mm256_set1_ps(plane.z);
+        result.d[p] = _mm256_set1_ps(plane.w);
+        result.absA[p] = _mm256_set1_ps(std::fabs(plane.x));
+        result.absB[p] = _mm256_set1_ps(std::fabs(plane.y));
+        result.absC[p] = _mm256_set1_ps(std::fabs(plane.z));
+    }
+    return result;
+}
+
+inline __m256 PlaneDistanceWide(const WidePlanes& planes, int p, __m256 x, __m256 y, __m256 z) {
+    __m256 dist = _mm256_mul_ps(planes.a[p], x);
+    dist = _mm256_add_ps(dist, _mm256_mul_ps(planes.b[p], y));
+    dist = _mm256_add_ps(dist, _mm256_mul_ps(planes.c[p], z));
+    return _mm256_add_ps(dist, planes.d[p]);
+}
+#endif
+
+}  // namespace
+
+void BoundingSphereSoA::Resize(std::size_t count) {
+    centerX.resize(count, 0.0f);
+    centerY.resize(count, 0.0f);
+    centerZ.resize(count, 0.0f);
+    radius.resize(count, 0.0f);
+}
+
+void BoundingSphereSoA::Set(std::size_t index, const Vec3& center, float r) {
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    radius[index] = r;
+}
+
+void BoundingBoxSoA::Resize(std::size_t count) {
+    centerX.resize(count, 0.0f);
+    centerY.resize(count, 0.0f);
+    centerZ.resize(count, 0.0f);
+    extentX.resize(count, 0.0f);
+    extentY.resize(count, 0.0f);
+    extentZ.resize(count, 0.0f);
+}
+
+void BoundingBoxSoA::Set(std::size_t index, const Vec3& minCorner, const Vec3& maxCorner) {
+    centerX[index] = (minCorner.x + maxCorner.x) * 0.5f;
+    centerY[index] = (minCorner.y + maxCorner.y) * 0.5f;
+    centerZ[index] = (minCorner.z + maxCorner.z) * 0.5f;
+    extentX[index] = (maxCorner.x - minCorner.x) * 0.5f;
+    extentY[index] = (maxCorner.y - minCorner.y) * 0.5f;
+    extentZ[index] = (maxCorner.z - minCorner.z) * 0.5f;
+}
+
+std::size_t CullSpheres(const Frustum& frustum, const BoundingSphereSoA& spheres, uint32_t* outVisible) {
+#if defined(ENGINE_MATH_SIMD)
+    const std::size_t count = spheres.Size();
+    std::size_t visible = 0;
+    std::size_t base = 0;
+
+#if defined(ENGINE_MATH_AVX)
+    const WidePlanes wide = SplatWide(frustum);
+    for (; base + kWideLanes <= count; base += kWideLanes) {
+        const __m256 x = _mm256_loadu_ps(spheres.centerX.data() + base);
+        const __m256 y = _mm256_loadu_ps(spheres.centerY.data() + base);
+        const __m256 z = _mm256_loadu_ps(spheres.centerZ.data() + base);
+        const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius.data() + base));
+        unsigned mask = 0xFFu;
+        for (int p = 0; p < Frustum::kPlaneCount && mask != 0; ++p) {
+            const __m256 dist = PlaneDistanceWide(wide, p, x, y, z);
+            mask &= static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ)));
+        }
+        visible = AppendVisible(mask, static_cast<uint32_t>(base), outVisible, visible);
+    }
+#endif
+
+    const SplatPlanes planes = Splat(frustum);
+    for (; base < count; base += kLanes) {
+        const std::size_t lanes = count - base < kLanes ? count - base : kLanes;
+        const F4 x = LoadLanes(spheres.centerX.data() + base, lanes);
+        const F4 y = LoadLanes(spheres.centerY.data() + base, lanes);
+        const F4 z = LoadLanes(spheres.centerZ.data() + base, lanes);
+        const F4 negRadius = simd::Negate(LoadLanes(spheres.radius.data() + base, lanes));
+        unsigned mask = (1u << lanes) - 1u;
+        for (int p = 0; p < Frustum::kPlaneCount && mask != 0; ++p) {
+            mask &= static_cast<unsigned>(simd::GreaterEqualMask(PlaneDistanceLanes(planes, p, x, y, z), negRadius));
+        }
+        visible = AppendVisible(mask, static_cast<uint32_t>(base), outVisible, visible);
+    }
+    return visible;
+#else
+    return CullSpheresScalar(frustum, spheres, outVisible);
+#endif
+}
+
+std::size_t CullBoxes(const Frustum& frustum, const BoundingBoxSoA& boxes, uint32_t* outVisible) {
+#if defined(ENGINE_MATH_SIMD)
+    const std::size_t count = boxes.Size();
+    std::size_t visible = 0;
+    std::size_t base = 0;
+
+#if defined(ENGINE_MATH_AVX)
+    const WidePlanes wide = SplatWide(frustum);
+    for (; base + kWideLanes <= count; base += kWideLanes) {
+        const __m256 x = _mm256_loadu_ps(boxes.centerX.data() + base);
+        const __m256 y = _mm256_loadu_ps(boxes.centerY.data() + base);
+        const __m256 z = _mm256_loadu_ps(boxes.centerZ.data() + base);
+        const __m256 ex = _mm256_loadu_ps(boxes.extentX.data() + base);
+        const __m256 ey = _mm256_loadu_ps(boxes.extentY.data() + base);
+        const __m256 ez = _mm256_loadu_ps(boxes.extentZ.data() + base);
+        unsigned mask = 0xFFu;
+        for (int p = 0; p < Frustum::kPlaneCount && mask != 0; ++p) {
+            const __m256 dist = PlaneDistanceWide(wide, p, x, y, z);
+            __m256 radius = _mm256_mul_ps(wide.absA[p], ex);
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(wide.absB[p], ey));
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(wide.absC[p], ez));
+            const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), radius);
+            mask &= static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ)));
+        }
+        visible = AppendVisible(mask, static_cast<uint32_t>(base), outVisible, visible);
+    }
+#endif
+
+    const SplatPlanes planes = Splat(frustum);
+    for (; base < count; base += kLanes) {
+        const std::size_t lanes = count - base < kLanes ? count - base : kLanes;
+        const F4 x = LoadLanes(boxes.centerX.data() + base, lanes);
+        const F4 y = LoadLanes(boxes.centerY.data() + base, lanes);
+        const F4 z = LoadLanes(boxes.centerZ.data() + base, lanes);
+        const F4 ex = LoadLanes(boxes.extentX.data() + base, lanes);
+        const F4 ey = LoadLanes(boxes.extentY.data() + base, lanes);
+        const F4 ez = LoadLanes(boxes.extentZ.data() + base, lanes);
+        unsigned mask = (1u << lanes) - 1u;
+        for (int p = 0; p < Frustum::kPlaneCount && mask != 0; ++p) {
+            F4 radius = simd::Mul(planes.absA[p], ex);
+            radius = simd::MulAdd(radius, planes.absB[p], ey);
+            radius = simd::MulAdd(radius, planes.absC[p], ez);
+            mask &= static_cast<unsigned>(
+                simd::GreaterEqualMask(PlaneDistanceLanes(planes, p, x, y, z), simd::Negate(radius)));
+        }
+        visible = AppendVisible(mask, static_cast<uint32_t>(base), outVisible, visible);
+    }
+    return visible;
+#else
+    return CullBoxesScalar(frustum, boxes, outVisible);
+#endif
+}
+
+std::size_t CullSpheresScalar(const Frustum& frustum, const BoundingSphereSoA& spheres, uint32_t* outVisible) {
+    const std::size_t count = spheres.Size();
+    std::size_t visible = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float negRadius = -spheres.radius[i];
+        bool inside = true;
+        for (const Vec4& plane : frustum.planes) {
+            if (PlaneDistance(plane, spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]) < negRadius) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            outVisible[visible++] = static_cast<uint32_t>(i);
+        }
+    }
+    return visible;
+}
+
+std::size_t CullBoxesScalar(const Frustum& frustum, const BoundingBoxSoA& boxes, uint32_t* outVisible) {
+    const std::size_t count = boxes.Size();
+    std::size_t visible = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool inside = true;
+        for (const Vec4& plane : frustum.planes) {
+            const float radius = std::fabs(plane.x) * boxes.extentX[i] + std::fabs(plane.y) * boxes.extentY[i] +
+                                 std::fabs(plane.z) * boxes.extentZ[i];
+            if (PlaneDistance(plane, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]) < -radius) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            outVisible[visible++] = static_cast<uint32_t>(i);
+        }
+    }
+    return visible;
+}
+
+}  // namespace engine
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "frustum.h"
+#include "math_types.h"
+
+namespace engine {
+
+// Structure-of-arrays bounding spheres, one entry per part.
+struct BoundingSphereSoA {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    std::size_t Size() const { return centerX.size(); }
+    void Resize(std::size_t count);
+    void Set(std::size_t index, const Vec3& center, float r);
+};
+
+// Structure-of-arrays axis-aligned boxes stored as center and half-extents.
+struct BoundingBoxSoA {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+
+    std::size_t Size() const { return centerX.size(); }
+    void Resize(std::size_t count);
+    void Set(std::size_t index, const Vec3& minCorner, const Vec3& maxCorner);
+};
+
+// Frustum culling stage. Each call tests every volume against all six planes
+// (eight at a time with AVX, four with NEON/SSE), writes the indices of the
+// volumes that intersect the frustum to `outVisible` in ascending order and
+// returns how many were written. `outVisible` must hold at least Size()
+// entries. Volumes touching a plane count as visible.
+std::size_t CullSpheres(const Frustum& frustum, const BoundingSphereSoA& spheres, uint32_t* outVisible);
+std::size_t CullBoxes(const Frustum& frustum, const BoundingBoxSoA& boxes, uint32_t* outVisible);
+
+// One-at-a-time reference implementations (tools/cull_bench.cpp).
+std::size_t CullSpheresScalar(const Frustum& frustum, const BoundingSphereSoA& spheres, uint32_t* outVisible);
+std::size_t CullBoxesScalar(const Frustum& frustum, const BoundingBoxSoA& boxes, uint32_t* outVisible);
+
+}  // namespace engine
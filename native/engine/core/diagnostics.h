@@ -4,16 +4,56 @@
 
 namespace engine {
 
-struct DiagnosticsSnapshot {
+// Rolling percentiles of one per-frame time (see FrameTimeHistogram).
+struct FrameTimeStats {
+    float p50Ms{0.0f};
+    float p90Ms{0.0f};
+    float p99Ms{0.0f};
+    float maxMs{0.0f};
+};
+
+// Counters the renderer publishes once per frame.
+struct FrameDiagnostics {
     float fps{0.0f};
     float frameTimeMs{0.0f};
+    int32_t drawCalls{0};  // Issued in the last frame; instanced batches count once.
     int32_t surfaceWidth{0};
     int32_t surfaceHeight{0};
     int32_t frameCount{0};
     bool eglReady{false};
+    float inputLatencyMs{0.0f};
+    int32_t droppedInputCount{0};
+    float resumeToFirstFrameMs{0.0f};
+    bool contextPreserved{false};
+    int32_t shaderCacheHits{0};
+    int32_t shaderCacheMisses{0};
+    float shaderBuildMs{0.0f};
+    int32_t trianglesSubmitted{0};  // Triangles in the last frame's draw calls, after LOD selection.
+    int32_t instancesCulled{0};     // Model instances outside the view frustum in the last frame.
+    int32_t assetsPending{0};       // Models still decoding or uploading.
+    float uploadMs{0.0f};           // GL upload time spent in the last frame.
+    int32_t glStateIssued{0};       // State changes GlStateCache passed to GL in the last frame.
+    int32_t glStateElided{0};       // ... and skipped because the state was already current.
+    int32_t idleFrames{0};          // Vsync ticks not rendered while idle; frameCount counts rendered ones.
+    bool renderIdle{false};         // No frames requested until the next input or scene change.
+    float renderScale{1.0f};        // Scene resolution relative to the surface in the last frame.
+    float vsyncPeriodMs{0.0f};      // Display refresh period estimated by FramePacer.
+    int32_t swapInterval{1};        // Refreshes per rendered frame.
+    int32_t missedDeadlines{0};     // Frames queued too late for their refresh.
+    FrameTimeStats frameInterval{}; // Between rendered frames' vsyncs, over the last few seconds.
+    FrameTimeStats cpuTime{};       // Render thread time per frame up to the swap.
+    FrameTimeStats swapTime{};      // Time spent in eglSwapBuffers.
+    int32_t jankFrames{0};          // Frames shown at least one refresh later than paced.
+    float lowFps{0.0f};             // 1% low: fps over the slowest 1% of recent frame intervals.
+};
+
+// Device strings, written once when GL resources are created.
+struct GpuDiagnostics {
     char gpuRenderer[128] = {0};
     char gpuVendor[128] = {0};
     char gpuVersion[128] = {0};
 };
 
+struct DiagnosticsSnapshot : FrameDiagnostics, GpuDiagnostics {};
+
 }  // namespace engine
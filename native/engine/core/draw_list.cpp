@@ -0,0 +1,217 @@
+#include "draw_list.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "gl_state_cache.h"
+
+namespace engine {
+
+namespace {
+
+constexpr int kPassShift = 62;
+constexpr int kDepthShift = 48;
+constexpr int kDepthBits = 14;
+constexpr int kProgramShift = 40;
+constexpr int kProgramBits = 8;
+constexpr int kMaterialShift = 28;
+constexpr int kMaterialBits = 12;
+constexpr int kMeshBits = 28;
+constexpr uint32_t kDepthMax = (1u << kDepthBits) - 1;
+constexpr std::size_t kRadixMinEntries = 1024;
+
+auto BatchTuple(const DrawKey& key) {
+    return std::tie(key.program, key.vao, key.material, key.indexOffset, key.indexCount, key.indexType);
+}
+
+bool SameKey(const DrawKey& a, const DrawKey& b) {
+    return BatchTuple(a) == BatchTuple(b);
+}
+
+uint64_t MeshHash(const DrawKey& key) {
+    uint64_t h = (static_cast<uint64_t>(key.vao) << 32) ^ key.indexOffset ^ (static_cast<uint64_t>(key.indexCount) << 7);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h >> (64 - kMeshBits);
+}
+
+}  // namespace
+
+void RadixSort(std::vector<SortEntry>* entries, std::vector<SortEntry>* scratch) {
+    const std::size_t count = entries->size();
+    if (count < kRadixMinEntries) {
+        // Eight passes over a few cache lines lose to a comparison sort.
+        std::stable_sort(entries->begin(), entries->end(),
+                         [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+        return;
+    }
+    // All eight histograms in one read of the keys.
+    uint32_t histograms[8][256] = {};
+    for (const SortEntry& entry : *entries) {
+        for (int byte = 0; byte < 8; ++byte) {
+            ++histograms[byte][(entry.key >> (byte * 8)) & 0xff];
+        }
+    }
+
+    scratch->resize(count);
+    SortEntry* source = entries->data();
+    SortEntry* destination = scratch->data();
+    for (int byte = 0; byte < 8; ++byte) {
+        uint32_t* histogram = histograms[byte];
+        if (histogram[(source[0].key >> (byte * 8)) & 0xff] == count) {
+            continue;  // Every key has this byte; the pass would not move anything.
+        }
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            const uint32_t n = histogram[digit];
+            histogram[digit] = offset;
+            offset += n;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].key >> (byte * 8)) & 0xff]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+    if (source != entries->data()) {
+        entries->swap(*scratch);
+    }
+}
+
+DrawList::~DrawList() {
+    Destroy();
+}
+
+void DrawList::Clear() {
+    items_.clear();
+    unsortedTransforms_.clear();
+    transforms_.clear();
+    batches_.clear();
+    entries_.clear();
+    uploaded_ = false;
+}
+
+void DrawList::Add(const DrawKey& key, const Mat4& world, const void* state, DrawPass pass, float viewDepth) {
+    items_.push_back(Item{key, state, static_cast<uint32_t>(unsortedTransforms_.size()), pass, viewDepth});
+    unsortedTransforms_.push_back(world);
+}
+
+void DrawList::Build() {
+    float nearest = 0.0f;
+    float farthest = 0.0f;
+    if (!items_.empty()) {
+        auto [minItem, maxItem] = std::minmax_element(
+            items_.begin(), items_.end(), [](const Item& a, const Item& b) { return a.viewDepth < b.viewDepth; });
+        nearest = minItem->viewDepth;
+        farthest = maxItem->viewDepth;
+    }
+    const float depthScale = farthest > nearest ? kDepthMax / (farthest - nearest) : 0.0f;
+    constexpr uint64_t kOpaqueDepthMask = ((1ull << kOpaqueDepthBits) - 1) << (kDepthBits - kOpaqueDepthBits);
+
+    programs_.clear();
+    entries_.resize(items_.size());
+    for (std::size_t i = 0; i < items_.size(); ++i) {
+        const Item& item = items_[i];
+        auto program = std::find(programs_.begin(), programs_.end(), item.key.program);
+        if (program == programs_.end()) {
+            program = programs_.insert(programs_.end(), item.key.program);
+        }
+        const auto programSlot = std::min<uint64_t>(program - programs_.begin(), (1u << kProgramBits) - 1);
+        const auto materialSlot = std::min<uint64_t>(static_cast<uint64_t>(item.key.material + 1),
+                                                     (1u << kMaterialBits) - 1);
+
+        uint64_t depth = std::min(static_cast<uint32_t>((item.viewDepth - nearest) * depthScale), kDepthMax);
+        depth = item.pass == DrawPass::kOpaque ? depth & kOpaqueDepthMask : kDepthMax - depth;
+
+        entries_[i].key = static_cast<uint64_t>(item.pass) << kPassShift | depth << kDepthShift |
+                          programSlot << kProgramShift | materialSlot << kMaterialShift | MeshHash(item.key);
+        entries_[i].index = static_cast<uint32_t>(i);
+    }
+    RadixSort(&entries_, &scratch_);
+
+    transforms_.resize(items_.size());
+    batches_.clear();
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        const Item& item = items_[entries_[i].index];
+        transforms_[i] = unsortedTransforms_[item.transform];
+        // Adjacent equal keys draw in sorted order even across depth buckets.
+        if (batches_.empty() || batches_.back().pass != item.pass || !SameKey(batches_.back().key, item.key)) {
+            batches_.push_back(DrawBatch{item.key, item.pass, item.state, static_cast<uint32_t>(i), 0});
+        }
+        ++batches_.back().instanceCount;
+    }
+    uploaded_ = false;
+}
+
+std::size_t DrawList::TriangleCount() const {
+    std::size_t triangles = 0;
+    for (const DrawBatch& batch : batches_) {
+        triangles += static_cast<std::size_t>(batch.key.indexCount / 3) * batch.instanceCount;
+    }
+    return triangles;
+}
+
+void DrawList::UploadTransforms() {
+    // Orphan and refill so the driver never waits on last frame's draws.
+    if (instanceBuffer_ == 0) {
+        glGenBuffers(1, &instanceBuffer_);
+    }
+    GlStateCache::Current().BindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+    const auto bytes = static_cast<GLsizeiptr>(transforms_.size() * sizeof(Mat4));
+    if (transforms_.size() > instanceCapacity_) {
+        instanceCapacity_ = transforms_.size() + transforms_.size() / 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity_ * sizeof(Mat4)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, transforms_.data());
+    uploaded_ = true;
+}
+
+int DrawList::Submit(DrawPass pass, const std::function<void(const DrawBatch& batch)>& applyState) {
+    if (batches_.empty()) {
+        return 0;
+    }
+    if (!uploaded_) {
+        UploadTransforms();
+    }
+
+    GlStateCache& state = GlStateCache::Current();
+    int drawCalls = 0;
+    for (const DrawBatch& batch : batches_) {
+        if (batch.pass != pass) {
+            continue;
+        }
+        state.UseProgram(batch.key.program);
+        applyState(batch);
+
+        // The instance attributes are VAO state. GLES 3.0 has no base
+        // instance, so the attribute offset selects the batch's matrices.
+        // glVertexAttribPointer reads the GL_ARRAY_BUFFER binding, which
+        // applyState may have changed.
+        state.BindVertexArray(batch.key.vao);
+        state.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+        const uintptr_t first = static_cast<uintptr_t>(batch.firstInstance) * sizeof(Mat4);
+        for (GLuint column = 0; column < 4; ++column) {
+            const GLuint location = kInstanceAttribute + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(Mat4),
+                                  reinterpret_cast<const void*>(first + column * 4 * sizeof(float)));
+            glVertexAttribDivisor(location, 1);
+        }
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(batch.key.indexCount), batch.key.indexType,
+                                reinterpret_cast<const void*>(static_cast<uintptr_t>(batch.key.indexOffset)),
+                                static_cast<GLsizei>(batch.instanceCount));
+        ++drawCalls;
+    }
+    return drawCalls;
+}
+
+void DrawList::Destroy() {
+    if (instanceBuffer_ != 0) {
+        GlStateCache::Current().DeleteBuffers(1, &instanceBuffer_);
+        instanceBuffer_ = 0;
+    }
+    instanceCapacity_ = 0;
+}
+
+}  // namespace engine
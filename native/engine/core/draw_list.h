@@ -0,0 +1,135 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "math_types.h"
+
+namespace engine {
+
+// Submission passes, in draw order.
+enum class DrawPass : uint8_t {
+    kOpaque = 0,       // Front to back in coarse depth buckets, then by state.
+    kTranslucent = 1,  // Back to front; blended, so order wins over batching.
+};
+
+// What a draw needs bound. Items with equal keys in the same pass and depth
+// bucket become one instanced draw.
+struct DrawKey {
+    GLuint program{0};
+    GLuint vao{0};
+    int32_t material{-1};
+    GLenum indexType{GL_UNSIGNED_SHORT};
+    uint32_t indexOffset{0};  // Bytes into the VAO's element buffer (picks the LOD).
+    uint32_t indexCount{0};
+};
+
+// A run of items sharing one key. `state` is the first item's; callers pass
+// per-geometry data (e.g. dequantisation ranges) that is identical for every
+// item drawing the same VAO.
+struct DrawBatch {
+    DrawKey key;
+    DrawPass pass{DrawPass::kOpaque};
+    const void* state{nullptr};
+    uint32_t firstInstance{0};
+    uint32_t instanceCount{0};
+};
+
+// A 64-bit sort key and the item it orders.
+struct SortEntry {
+    uint64_t key;
+    uint32_t index;
+};
+
+// Stable LSD radix sort by key, one byte per pass. Passes where every key
+// has the same byte are skipped, so keys that only use a few bits sort in a
+// few passes. Short lists use std::stable_sort instead. `scratch` is resized
+// as needed and can be reused.
+void RadixSort(std::vector<SortEntry>* entries, std::vector<SortEntry>* scratch);
+
+// Collects the visible draws of a frame, orders them by a 64-bit sort key
+// and submits runs of equal keys as one glDrawElementsInstanced each. World
+// matrices go into a single per-instance buffer read through a mat4
+// attribute at kInstanceAttribute..kInstanceAttribute+3 with divisor 1.
+//
+// Sort key, most significant first:
+//   63..62  pass
+//   61..48  view depth, quantised over the frame's depth range: the top
+//           kOpaqueDepthBits front to back for opaque items, all 14 bits
+//           back to front for translucent ones
+//   47..40  program, in order of first use this frame
+//   39..28  material + 1
+//   27..0   hash of the geometry (VAO and index range)
+// A hash collision can only split a batch; batching compares full keys.
+//
+// Per frame: Clear, Add every visible draw, Build, then Submit each pass on
+// the render thread with the context current.
+class DrawList {
+public:
+    static constexpr GLuint kInstanceAttribute = 2;
+    // Opaque depth buckets: enough for early-Z to reject most hidden parts
+    // while instances of one mesh still mostly share a batch.
+    static constexpr int kOpaqueDepthBits = 4;
+
+    DrawList() = default;
+    ~DrawList();
+
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    void Clear();
+    // `viewDepth` is the item's distance along the view direction; only its
+    // order within the frame matters.
+    void Add(const DrawKey& key, const Mat4& world, const void* state = nullptr,
+             DrawPass pass = DrawPass::kOpaque, float viewDepth = 0.0f);
+    // Sorts the items and forms batches; transforms are laid out batch by
+    // batch. CPU only, so it can be timed or tested without GL.
+    void Build();
+
+    // Issues one instanced draw per batch of `pass`; the first call after
+    // Build uploads the transforms. `applyState` runs before each batch's
+    // draw, with its program already bound, to set per-batch uniforms.
+    // Pass-wide state (blending, depth writes) is the caller's. Returns the
+    // draw calls issued.
+    int Submit(DrawPass pass, const std::function<void(const DrawBatch& batch)>& applyState);
+
+    // Deletes the instance buffer; safe without a context (names are forgotten).
+    void Destroy();
+
+    std::size_t ItemCount() const { return items_.size(); }
+    const std::vector<DrawBatch>& Batches() const { return batches_; }
+    const std::vector<Mat4>& Transforms() const { return transforms_; }
+    // Sort keys in draw order, parallel to the instances in Transforms().
+    const std::vector<SortEntry>& SortedKeys() const { return entries_; }
+    // Triangles of every instance in the built batches.
+    std::size_t TriangleCount() const;
+
+private:
+    struct Item {
+        DrawKey key;
+        const void* state;
+        uint32_t transform;
+        DrawPass pass;
+        float viewDepth;
+    };
+
+    void UploadTransforms();
+
+    std::vector<Item> items_;
+    std::vector<SortEntry> entries_;
+    std::vector<SortEntry> scratch_;
+    std::vector<GLuint> programs_;
+    std::vector<Mat4> unsortedTransforms_;
+    std::vector<Mat4> transforms_;
+    std::vector<DrawBatch> batches_;
+
+    GLuint instanceBuffer_{0};
+    std::size_t instanceCapacity_{0};
+    bool uploaded_{false};
+};
+
+}  // namespace engine
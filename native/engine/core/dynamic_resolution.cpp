@@ -0,0 +1,52 @@
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+float DynamicResolution::Update(float frameMs, float budgetMs) {
+    if (!(frameMs > 0.0f) || !(budgetMs > 0.0f)) {
+        return scale_;
+    }
+    smoothedMs_ = smoothedMs_ > 0.0f ? smoothedMs_ + kSmoothing * (frameMs - smoothedMs_) : frameMs;
+    if (settleFrames_ > 0) {
+        --settleFrames_;
+        return scale_;
+    }
+
+    if (smoothedMs_ > budgetMs) {
+        ++overBudgetFrames_;
+        underBudgetFrames_ = 0;
+    } else if (smoothedMs_ < budgetMs * kUpFraction) {
+        ++underBudgetFrames_;
+        overBudgetFrames_ = 0;
+    } else {
+        overBudgetFrames_ = 0;
+        underBudgetFrames_ = 0;
+    }
+
+    if (overBudgetFrames_ >= kDownFrames && scale_ > kMinScale) {
+        // Predicted cost at scale s: smoothed * (s / scale)^2.
+        const float wanted = scale_ * std::sqrt(budgetMs * kTargetFraction / smoothedMs_);
+        SetScale(std::min(std::floor(wanted / kStep) * kStep, scale_ - kStep));
+    } else if (underBudgetFrames_ >= kUpFrames && scale_ < kMaxScale) {
+        SetScale(scale_ + kStep);
+    }
+    return scale_;
+}
+
+void DynamicResolution::Reset() {
+    *this = DynamicResolution();
+}
+
+void DynamicResolution::SetScale(float scale) {
+    // Snap to the kStep grid; repeated float additions drift off it.
+    scale_ = std::clamp(std::round(scale / kStep) * kStep, kMinScale, kMaxScale);
+    overBudgetFrames_ = 0;
+    underBudgetFrames_ = 0;
+    settleFrames_ = kSettleFrames;
+    ++changes_;
+}
+
+}  // namespace engine
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace engine {
+
+// Chooses the scale the scene is rendered at from each frame's measured cost
+// and the frame budget. Cost is assumed to grow with pixel count (scale^2),
+// which holds once the frame is fill-rate bound.
+//
+// Hysteresis keeps the scale from oscillating:
+//   - it drops only after kDownFrames frames over budget, straight to the
+//     scale whose predicted cost is kTargetFraction of the budget;
+//   - it rises one kStep at a time, only after kUpFrames frames under
+//     kUpFraction of the budget. A step up never predicts a cost over
+//     budget, so it cannot trigger the next step down;
+//   - after any change it waits kSettleFrames while the average catches up.
+// Scales are multiples of kStep so render sizes repeat.
+class DynamicResolution {
+public:
+    static constexpr float kMinScale = 0.5f;
+    static constexpr float kMaxScale = 1.0f;
+    static constexpr float kStep = 0.05f;
+    static constexpr float kTargetFraction = 0.85f;
+    static constexpr float kUpFraction = 0.7f;
+    static constexpr int kDownFrames = 6;
+    static constexpr int kUpFrames = 45;
+    static constexpr int kSettleFrames = 10;
+    // Weight of the newest frame in the moving average.
+    static constexpr float kSmoothing = 0.2f;
+
+    // Feeds one frame's cost and returns the scale for the next frame.
+    float Update(float frameMs, float budgetMs);
+    void Reset();
+
+    float Scale() const { return scale_; }
+    float SmoothedMs() const { return smoothedMs_; }
+    // Scale changes since the last Reset().
+    int Changes() const { return changes_; }
+
+private:
+    void SetScale(float scale);
+
+    float scale_{kMaxScale};
+    float smoothedMs_{0.0f};
+    int overBudgetFrames_{0};
+    int underBudgetFrames_{0};
+    int settleFrames_{0};
+    int changes_{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,129 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+// Plausible refresh periods: 250 Hz down to 20 Hz.
+constexpr int64_t kMinPeriodNanos = 4'000'000;
+constexpr int64_t kMaxPeriodNanos = 50'000'000;
+// Longer gaps (a pause, an idle renderer) say nothing about the period.
+constexpr int64_t kMaxTicksPerDelta = 8;
+// Weight of each new measurement in the period estimate.
+constexpr double kPeriodSmoothing = 0.1;
+constexpr int kRateChangeDeltas = 8;
+// The swap interval is the fewest refreshes per frame that do not exceed the
+// target rate by more than kIntervalSlack of a refresh, so 60 fps on 90 Hz
+// is paced at 45 fps, not 90. The interval only moves once the estimate is
+// kIntervalHysteresis clear of the boundary, so jitter cannot flip it.
+constexpr double kIntervalSlack = 0.1;
+constexpr double kIntervalHysteresis = 0.05;
+
+}  // namespace
+
+int64_t SteadyClockNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+FramePacer::FramePacer(PacerClock clock) : clock_(std::move(clock)) {}
+
+void FramePacer::SetTargetFps(int fps) {
+    targetFps_ = std::max(1, fps);
+}
+
+void FramePacer::Reset() {
+    periodNanos_ = 0;
+    interval_ = 1;
+    lastVsyncNanos_ = 0;
+    lastRenderVsyncNanos_ = 0;
+    irregularDeltas_ = 0;
+}
+
+void FramePacer::UpdatePeriod(int64_t delta) {
+    if (delta < kMinPeriodNanos || delta > kMaxPeriodNanos * kMaxTicksPerDelta) {
+        return;
+    }
+    if (periodNanos_ == 0) {
+        if (delta <= kMaxPeriodNanos) {
+            periodNanos_ = delta;
+        }
+        return;
+    }
+
+    // A delta spanning several periods means ticks were not delivered.
+    const int64_t ticks = std::max<int64_t>(1, std::llround(static_cast<double>(delta) / periodNanos_));
+    const int64_t perTick = delta / ticks;
+    const bool fits = std::abs(perTick - periodNanos_) <= periodNanos_ / 4;
+    irregularDeltas_ = ticks == 1 && fits ? 0 : irregularDeltas_ + 1;
+    if (irregularDeltas_ >= kRateChangeDeltas && delta <= kMaxPeriodNanos) {
+        // Every recent tick was off the estimate: the display switched rate.
+        periodNanos_ = delta;
+        irregularDeltas_ = 0;
+    } else if (fits) {
+        periodNanos_ += std::llround((perTick - periodNanos_) * kPeriodSmoothing);
+    }
+}
+
+FramePacer::Frame FramePacer::OnVsync(int64_t vsyncNanos) {
+    Frame frame;
+    frame.vsyncNanos = vsyncNanos;
+    if (lastVsyncNanos_ > 0 && vsyncNanos > lastVsyncNanos_) {
+        UpdatePeriod(vsyncNanos - lastVsyncNanos_);
+    }
+    lastVsyncNanos_ = vsyncNanos;
+
+    if (periodNanos_ == 0) {
+        // Nothing to pace against yet; render and present as soon as possible.
+        frame.render = true;
+        lastRenderVsyncNanos_ = vsyncNanos;
+        ++stats_.framesPaced;
+        return frame;
+    }
+
+    const double ratio = 1e9 / targetFps_ / static_cast<double>(periodNanos_);
+    auto intervalFor = [ratio](double slack) { return std::max(1, static_cast<int>(std::ceil(ratio - slack))); };
+    if (interval_ != intervalFor(kIntervalSlack - kIntervalHysteresis) &&
+        interval_ != intervalFor(kIntervalSlack + kIntervalHysteresis)) {
+        interval_ = intervalFor(kIntervalSlack);
+    }
+    const int64_t sinceRender =
+        lastRenderVsyncNanos_ > 0
+            ? std::llround(static_cast<double>(vsyncNanos - lastRenderVsyncNanos_) / periodNanos_)
+            : interval_;
+    if (sinceRender < interval_) {
+        ++stats_.vsyncsSkipped;
+        return frame;
+    }
+
+    frame.render = true;
+    lastRenderVsyncNanos_ = vsyncNanos;
+    ++stats_.framesPaced;
+    const int64_t displayNanos = vsyncNanos + (kPipelineVsyncs + interval_ - 1) * periodNanos_;
+    frame.deadlineNanos = displayNanos - periodNanos_;
+    // The compositor shows a buffer at the first refresh at or after its
+    // presentation time; half a period early absorbs vsync jitter without
+    // letting it go out a refresh sooner.
+    frame.presentNanos = displayNanos - periodNanos_ / 2;
+    return frame;
+}
+
+void FramePacer::OnFrameQueued(const Frame& frame) {
+    if (!frame.render || frame.deadlineNanos == 0 || periodNanos_ == 0) {
+        return;
+    }
+    const int64_t lateNanos = clock_() - frame.deadlineNanos;
+    const int64_t late = lateNanos > 0 ? 1 + (lateNanos - 1) / periodNanos_ : 0;
+    ++stats_.lateVsyncs[std::min<int64_t>(late, kLateBuckets - 1)];
+    if (late > 0) {
+        ++stats_.missedDeadlines;
+    }
+}
+
+}  // namespace engine
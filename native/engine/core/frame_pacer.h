@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+namespace engine {
+
+// Monotonic nanoseconds; the same timebase as Choreographer frame times.
+using PacerClock = std::function<int64_t()>;
+
+int64_t SteadyClockNanos();
+
+// Paces rendering to whole display refreshes. Fed the vsync timestamp of
+// every tick, it
+//   - estimates the refresh period, tolerating ticks that never arrive
+//     (a busy looper) and following refresh rate switches;
+//   - renders on every Nth vsync only, N the fewest refreshes per frame
+//     that keep to the target fps, so each frame is shown for the same number of refreshes
+//     instead of alternating (judder). N counts from the last rendered
+//     vsync, so a tick that never came delays one frame by a refresh and the
+//     first tick after a pause renders at once;
+//   - gives each frame the vsync it should appear at. Passed to
+//     eglPresentationTimeANDROID, it makes the compositor hold a frame that
+//     is ready early rather than show it a refresh too soon;
+//   - records, per frame, how many refreshes too late it was queued.
+//
+// A frame started at vsync V is latched by the compositor kPipelineVsyncs - 1
+// refreshes later at the earliest, so with interval N it is meant to appear
+// at V + (kPipelineVsyncs + N - 1) periods and must be queued one period
+// before that.
+//
+// Not thread safe; OnVsync and OnFrameQueued run on the render thread.
+class FramePacer {
+public:
+    static constexpr int kPipelineVsyncs = 2;
+    // Late frames by refreshes missed: on time, 1, 2, ... and the last
+    // bucket for anything later.
+    static constexpr int kLateBuckets = 5;
+
+    struct Frame {
+        bool render{false};
+        int64_t vsyncNanos{0};
+        int64_t presentNanos{0};   // For eglPresentationTimeANDROID.
+        int64_t deadlineNanos{0};  // Latest time to queue the swap.
+    };
+
+    struct Stats {
+        uint64_t framesPaced{0};
+        uint64_t vsyncsSkipped{0};  // Ticks between paced frames.
+        uint64_t missedDeadlines{0};
+        std::array<uint64_t, kLateBuckets> lateVsyncs{};
+    };
+
+    explicit FramePacer(PacerClock clock = SteadyClockNanos);
+
+    void SetTargetFps(int fps);
+
+    // Called with every vsync tick, in order. Decides whether to render on it.
+    Frame OnVsync(int64_t vsyncNanos);
+    // After the swap of a frame OnVsync chose to render; reads the clock.
+    void OnFrameQueued(const Frame& frame);
+
+    // Forgets the vsync grid and period, e.g. when the surface changes.
+    void Reset();
+    void ResetStats() { stats_ = {}; }
+
+    int64_t VsyncPeriodNanos() const { return periodNanos_; }
+    // Refreshes per rendered frame.
+    int SwapInterval() const { return interval_; }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    void UpdatePeriod(int64_t delta);
+
+    PacerClock clock_;
+    int targetFps_{60};
+    int64_t periodNanos_{0};
+    int interval_{1};
+    int64_t lastVsyncNanos_{0};
+    int64_t lastRenderVsyncNanos_{0};
+    // Consecutive deltas that were not one period; enough of them in a row
+    // mean the refresh rate changed.
+    int irregularDeltas_{0};
+    Stats stats_{};
+};
+
+}  // namespace engine
@@ -0,0 +1,87 @@
+#include "frame_time_histogram.h"
+
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+int BucketOf(float ms) {
+    const int bucket = static_cast<int>(ms / FrameTimeHistogram::kBucketMs);
+    return std::clamp(bucket, 0, FrameTimeHistogram::kBuckets - 1);
+}
+
+}  // namespace
+
+void FrameTimeHistogram::Add(float ms) {
+    if (!(ms >= 0.0f)) {
+        return;
+    }
+    if (count_ == kWindowFrames) {
+        --buckets_[BucketOf(samples_[next_])];
+    } else {
+        ++count_;
+    }
+    samples_[next_] = ms;
+    ++buckets_[BucketOf(ms)];
+    next_ = (next_ + 1) % kWindowFrames;
+}
+
+void FrameTimeHistogram::Reset() {
+    buckets_.fill(0);
+    next_ = 0;
+    count_ = 0;
+}
+
+float FrameTimeHistogram::BucketMs(int bucket, float maxMs) const {
+    // The last bucket is open-ended: stalls that long are reported at the
+    // maximum. Elsewhere the centre, but never above the maximum.
+    if (bucket == kBuckets - 1) {
+        return maxMs;
+    }
+    return std::min((static_cast<float>(bucket) + 0.5f) * kBucketMs, maxMs);
+}
+
+FrameTimeStats FrameTimeHistogram::Summarize() const {
+    FrameTimeStats stats;
+    if (count_ == 0) {
+        return stats;
+    }
+    stats.maxMs = *std::max_element(samples_.begin(), samples_.begin() + count_);
+
+    // Ranks of p50, p90 and p99, found in one pass from the fastest bucket.
+    const float fractions[] = {0.50f, 0.90f, 0.99f};
+    float* results[] = {&stats.p50Ms, &stats.p90Ms, &stats.p99Ms};
+    int target = 0;
+    int seen = 0;
+    for (int bucket = 0; bucket < kBuckets && target < 3; ++bucket) {
+        seen += buckets_[bucket];
+        while (target < 3) {
+            const int rank = std::max(1, static_cast<int>(fractions[target] * static_cast<float>(count_) + 0.999f));
+            if (seen < rank) {
+                break;
+            }
+            *results[target] = BucketMs(bucket, stats.maxMs);
+            ++target;
+        }
+    }
+    return stats;
+}
+
+float FrameTimeHistogram::SlowestMeanMs(float percent) const {
+    if (count_ == 0) {
+        return 0.0f;
+    }
+    const float maxMs = *std::max_element(samples_.begin(), samples_.begin() + count_);
+    const int wanted = std::max(1, static_cast<int>(static_cast<float>(count_) * percent / 100.0f));
+    int taken = 0;
+    double total = 0.0;
+    for (int bucket = kBuckets - 1; bucket >= 0 && taken < wanted; --bucket) {
+        const int take = std::min<int>(buckets_[bucket], wanted - taken);
+        total += static_cast<double>(take) * BucketMs(bucket, maxMs);
+        taken += take;
+    }
+    return static_cast<float>(total / taken);
+}
+
+}  // namespace engine
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "diagnostics.h"
+
+namespace engine {
+
+// Rolling histogram of the last kWindowFrames samples of one per-frame time,
+// in kBucketMs buckets up to kBuckets * kBucketMs; longer samples share the
+// last bucket. Adding a sample evicts the oldest one from its bucket, so
+// percentiles never need a sort and cost one pass over the buckets.
+//
+// Single writer: the render thread adds samples and summarises once per
+// frame; the summary reaches other threads through the diagnostics seqlock,
+// so neither side ever waits on the other.
+class FrameTimeHistogram {
+public:
+    static constexpr int kWindowFrames = 600;  // 5 s at 120 fps, 10 s at 60.
+    static constexpr float kBucketMs = 0.1f;
+    static constexpr int kBuckets = 1000;
+
+    void Add(float ms);
+    void Reset();
+
+    int Count() const { return count_; }
+    // Nearest-rank percentiles, reported at the bucket centre; the maximum
+    // is exact.
+    FrameTimeStats Summarize() const;
+    // Mean of the slowest `percent` of the window, at least one sample.
+    float SlowestMeanMs(float percent) const;
+
+private:
+    float BucketMs(int bucket, float maxMs) const;
+
+    std::array<uint16_t, kBuckets> buckets_{};
+    std::array<float, kWindowFrames> samples_{};
+    int next_{0};
+    int count_{0};
+};
+
+}  // namespace engine
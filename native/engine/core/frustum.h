@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+
+#include "math_types.h"
+
+namespace engine {
+
+// Six normalized planes (a, b, c, d) with inward-facing normals: a point p is
+// inside a plane when a * p.x + b * p.y + c * p.z + d >= 0.
+struct Frustum {
+    enum PlaneIndex { kLeft = 0, kRight, kBottom, kTop, kNear, kFar, kPlaneCount };
+
+    std::array<Vec4, kPlaneCount> planes{};
+};
+
+// Gribb/Hartmann extraction from a column-major view-projection matrix.
+inline Frustum ExtractFrustum(const Mat4& viewProj) {
+    const float* m = viewProj.Ptr();
+    auto row = [m](int r) { return Vec4{m[r], m[4 + r], m[8 + r], m[12 + r]}; };
+    const Vec4 r0 = row(0);
+    const Vec4 r1 = row(1);
+    const Vec4 r2 = row(2);
+    const Vec4 r3 = row(3);
+
+    auto add = [](const Vec4& a, const Vec4& b) { return Vec4{a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w}; };
+    auto sub = [](const Vec4& a, const Vec4& b) { return Vec4{a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w}; };
+
+    Frustum frustum;
+    frustum.planes[Frustum::kLeft] = add(r3, r0);
+    frustum.planes[Frustum::kRight] = sub(r3, r0);
+    frustum.planes[Frustum::kBottom] = add(r3, r1);
+    frustum.planes[Frustum::kTop] = sub(r3, r1);
+    frustum.planes[Frustum::kNear] = add(r3, r2);
+    frustum.planes[Frustum::kFar] = sub(r3, r2);
+
+    for (Vec4& plane : frustum.planes) {
+        const float len = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (len > 0.0f) {
+            const float inv = 1.0f / len;
+            plane = Vec4{plane.x * inv, plane.y * inv, plane.z * inv, plane.w * inv};
+        }
+    }
+    return frustum;
+}
+
+}  // namespace engine
@@ -0,0 +1,240 @@
+#include "gl_state_cache.h"
+
+namespace engine {
+
+namespace {
+
+template <typename T, std::size_t N>
+int IndexOf(const T (&values)[N], T value) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (values[i] == value) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+GlStateCache& GlStateCache::Current() {
+    thread_local GlStateCache cache;
+    return cache;
+}
+
+void GlStateCache::Invalidate() {
+    state_ = {};
+}
+
+template <typename T>
+bool GlStateCache::Changes(std::optional<T>& cached, const T& value) {
+    if (cached == value) {
+        ++counters_.elided;
+        return false;
+    }
+    cached = value;
+    ++counters_.issued;
+    return true;
+}
+
+std::optional<GLuint> GlStateCache::Buffer(GLenum target) const {
+    const int index = IndexOf(kBufferTargets, target);
+    return index >= 0 ? state_.buffers[index] : std::nullopt;
+}
+
+void GlStateCache::UseProgram(GLuint program) {
+    if (Changes(state_.program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void GlStateCache::BindVertexArray(GLuint vao) {
+    if (Changes(state_.vao, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void GlStateCache::BindBuffer(GLenum target, GLuint buffer) {
+    const int index = IndexOf(kBufferTargets, target);
+    if (index < 0) {
+        ++counters_.issued;
+        glBindBuffer(target, buffer);
+    } else if (Changes(state_.buffers[index], buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void GlStateCache::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    const int generic = IndexOf(kBufferTargets, target);
+    if (target == GL_UNIFORM_BUFFER && index < kUniformBindings) {
+        if (!Changes(state_.uniformRanges[index], BufferRange{buffer, offset, size})) {
+            return;
+        }
+    } else {
+        ++counters_.issued;
+    }
+    glBindBufferRange(target, index, buffer, offset, size);
+    // The indexed bind also binds the generic target.
+    if (generic >= 0) {
+        state_.buffers[generic] = buffer;
+    }
+}
+
+void GlStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture) {
+    const GLenum textureUnit = GL_TEXTURE0 + unit;
+    const int index = IndexOf(kTextureTargets, target);
+    if (unit >= kTextureUnits || index < 0) {
+        if (Changes(state_.activeTexture, textureUnit)) {
+            glActiveTexture(textureUnit);
+        }
+        ++counters_.issued;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (!Changes(state_.textures[unit][index], texture)) {
+        return;
+    }
+    // The active unit only matters when something is bound.
+    if (Changes(state_.activeTexture, textureUnit)) {
+        glActiveTexture(textureUnit);
+    }
+    glBindTexture(target, texture);
+}
+
+void GlStateCache::BindFramebuffer(GLenum target, GLuint framebuffer) {
+    const bool draw = target != GL_READ_FRAMEBUFFER;
+    const bool read = target != GL_DRAW_FRAMEBUFFER;
+    if ((!draw || state_.drawFramebuffer == framebuffer) && (!read || state_.readFramebuffer == framebuffer)) {
+        ++counters_.elided;
+        return;
+    }
+    if (draw) {
+        state_.drawFramebuffer = framebuffer;
+    }
+    if (read) {
+        state_.readFramebuffer = framebuffer;
+    }
+    ++counters_.issued;
+    glBindFramebuffer(target, framebuffer);
+}
+
+void GlStateCache::SetEnabled(GLenum capability, bool enabled) {
+    const int index = IndexOf(kCapabilities, capability);
+    if (index >= 0 && !Changes(state_.capabilities[index], enabled)) {
+        return;
+    }
+    if (index < 0) {
+        ++counters_.issued;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void GlStateCache::DepthFunc(GLenum func) {
+    if (Changes(state_.depthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void GlStateCache::DepthMask(bool write) {
+    if (Changes(state_.depthMask, write)) {
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void GlStateCache::BlendFunc(GLenum source, GLenum destination) {
+    if (Changes(state_.blendFunc, std::pair(source, destination))) {
+        glBlendFunc(source, destination);
+    }
+}
+
+void GlStateCache::CullFace(GLenum mode) {
+    if (Changes(state_.cullFace, mode)) {
+        glCullFace(mode);
+    }
+}
+
+void GlStateCache::ClearColor(float r, float g, float b, float a) {
+    if (Changes(state_.clearColor, std::array<float, 4>{r, g, b, a})) {
+        glClearColor(r, g, b, a);
+    }
+}
+
+void GlStateCache::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (Changes(state_.viewport, std::array<GLint, 4>{x, y, width, height})) {
+        glViewport(x, y, width, height);
+    }
+}
+
+void GlStateCache::DeleteProgram(GLuint program) {
+    // A current program stays current until replaced, but its name may be
+    // reused afterwards; forget it either way.
+    if (state_.program == program) {
+        state_.program.reset();
+    }
+    glDeleteProgram(program);
+}
+
+void GlStateCache::DeleteVertexArrays(GLsizei count, const GLuint* vaos) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (vaos[i] != 0 && state_.vao == vaos[i]) {
+            state_.vao = 0u;
+        }
+    }
+    glDeleteVertexArrays(count, vaos);
+}
+
+void GlStateCache::DeleteBuffers(GLsizei count, const GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (buffers[i] == 0) {
+            continue;
+        }
+        for (std::optional<GLuint>& bound : state_.buffers) {
+            if (bound == buffers[i]) {
+                bound = 0u;
+            }
+        }
+        for (std::optional<BufferRange>& range : state_.uniformRanges) {
+            if (range && range->buffer == buffers[i]) {
+                range.reset();
+            }
+        }
+    }
+    glDeleteBuffers(count, buffers);
+}
+
+void GlStateCache::DeleteTextures(GLsizei count, const GLuint* textures) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (textures[i] == 0) {
+            continue;
+        }
+        for (auto& unit : state_.textures) {
+            for (std::optional<GLuint>& bound : unit) {
+                if (bound == textures[i]) {
+                    bound = 0u;
+                }
+            }
+        }
+    }
+    glDeleteTextures(count, textures);
+}
+
+void GlStateCache::DeleteFramebuffers(GLsizei count, const GLuint* framebuffers) {
+    // A bound framebuffer that is deleted reverts to the default one.
+    for (GLsizei i = 0; i < count; ++i) {
+        if (framebuffers[i] == 0) {
+            continue;
+        }
+        if (state_.drawFramebuffer == framebuffers[i]) {
+            state_.drawFramebuffer = 0u;
+        }
+        if (state_.readFramebuffer == framebuffers[i]) {
+            state_.readFramebuffer = 0u;
+        }
+    }
+    glDeleteFramebuffers(count, framebuffers);
+}
+
+}  // namespace engine
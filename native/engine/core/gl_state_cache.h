@@ -0,0 +1,119 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace engine {
+
+// Shadow copy of the GL state the engine changes, so a bind or enable that
+// would not change anything is skipped. GL state belongs to the context
+// current on the calling thread, and so does the cache: Current() is
+// per thread.
+//
+// The shadow is only as good as the calls that go through it:
+//   - Invalidate() after making a context current (new, lost or shared) and
+//     after any code changes covered state directly.
+//   - Delete objects through the Delete* helpers, because GL silently
+//     unbinds deleted names and may hand them out again.
+//
+// GL_ELEMENT_ARRAY_BUFFER is vertex array state, so BindBuffer passes it
+// straight through. BindFramebuffer(GL_FRAMEBUFFER) sets both the draw and
+// the read binding, as in GL. State nobody has set since the last Invalidate() is
+// unknown, and the first call always reaches GL.
+class GlStateCache {
+public:
+    static constexpr int kUniformBindings = 16;
+    static constexpr int kTextureUnits = 16;
+
+    struct Counters {
+        uint64_t issued{0};
+        uint64_t elided{0};
+    };
+
+    static GlStateCache& Current();
+
+    void Invalidate();
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindBuffer(GLenum target, GLuint buffer);
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void BindTexture(GLuint unit, GLenum target, GLuint texture);
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+
+    // GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE or GL_SCISSOR_TEST; other
+    // capabilities are passed through.
+    void SetEnabled(GLenum capability, bool enabled);
+    void DepthFunc(GLenum func);
+    void DepthMask(bool write);
+    void BlendFunc(GLenum source, GLenum destination);
+    void CullFace(GLenum mode);
+    void ClearColor(float r, float g, float b, float a);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    void DeleteProgram(GLuint program);
+    void DeleteVertexArrays(GLsizei count, const GLuint* vaos);
+    void DeleteBuffers(GLsizei count, const GLuint* buffers);
+    void DeleteTextures(GLsizei count, const GLuint* textures);
+    void DeleteFramebuffers(GLsizei count, const GLuint* framebuffers);
+
+    // GL calls made and skipped since the last ResetCounters().
+    Counters GetCounters() const { return counters_; }
+    void ResetCounters() { counters_ = {}; }
+
+    // The cached binding, or nullopt when unknown. For checks against glGet.
+    std::optional<GLuint> Program() const { return state_.program; }
+    std::optional<GLuint> VertexArray() const { return state_.vao; }
+    std::optional<GLuint> Buffer(GLenum target) const;
+
+private:
+    // Targets BindBuffer tracks; GL_ELEMENT_ARRAY_BUFFER is deliberately absent.
+    static constexpr GLenum kBufferTargets[] = {GL_ARRAY_BUFFER,      GL_UNIFORM_BUFFER,
+                                                GL_COPY_READ_BUFFER,  GL_COPY_WRITE_BUFFER,
+                                                GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER,
+                                                GL_TRANSFORM_FEEDBACK_BUFFER};
+    static constexpr int kBufferTargetCount = sizeof(kBufferTargets) / sizeof(kBufferTargets[0]);
+    static constexpr GLenum kTextureTargets[] = {GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_3D,
+                                                 GL_TEXTURE_2D_ARRAY};
+    static constexpr int kTextureTargetCount = sizeof(kTextureTargets) / sizeof(kTextureTargets[0]);
+    static constexpr GLenum kCapabilities[] = {GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST};
+    static constexpr int kCapabilityCount = sizeof(kCapabilities) / sizeof(kCapabilities[0]);
+
+    struct BufferRange {
+        GLuint buffer{0};
+        GLintptr offset{0};
+        GLsizeiptr size{0};
+
+        bool operator==(const BufferRange&) const = default;
+    };
+
+    struct State {
+        std::optional<GLuint> program;
+        std::optional<GLuint> vao;
+        std::optional<GLuint> buffers[kBufferTargetCount];
+        std::optional<BufferRange> uniformRanges[kUniformBindings];
+        std::optional<GLenum> activeTexture;
+        std::optional<GLuint> textures[kTextureUnits][kTextureTargetCount];
+        std::optional<GLuint> drawFramebuffer;
+        std::optional<GLuint> readFramebuffer;
+        std::optional<bool> capabilities[kCapabilityCount];
+        std::optional<GLenum> depthFunc;
+        std::optional<bool> depthMask;
+        std::optional<std::pair<GLenum, GLenum>> blendFunc;
+        std::optional<GLenum> cullFace;
+        std::optional<std::array<float, 4>> clearColor;
+        std::optional<std::array<GLint, 4>> viewport;
+    };
+
+    template <typename T>
+    bool Changes(std::optional<T>& cached, const T& value);
+
+    State state_{};
+    Counters counters_{};
+};
+
+}  // namespace engine
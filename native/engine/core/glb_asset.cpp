@@ -0,0 +1,459 @@
+#include "glb_asset.h"
+
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+#include "json.h"
+#include "transform_batch.h"
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t kGlbMagic = 0x46546C67u;      // "glTF"
+constexpr uint32_t kChunkJson = 0x4E4F534Au;     // "JSON"
+constexpr uint32_t kChunkBin = 0x004E4942u;      // "BIN\0"
+constexpr std::size_t kHeaderSize = 12;
+constexpr std::size_t kChunkHeaderSize = 8;
+// Exclusive bound for JSON numbers read into uint32_t; GLB lengths are
+// 32-bit, so every size and offset fits too, even where size_t is 32-bit.
+constexpr double kUint32Limit = 4294967296.0;
+
+uint32_t ReadU32(const uint8_t* bytes) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+bool Fail(std::string* error, std::string message) {
+    if (error) {
+        *error = std::move(message);
+    }
+    return false;
+}
+
+uint32_t ComponentCount(std::string_view type) {
+    if (type == "SCALAR") {
+        return 1;
+    }
+    if (type == "VEC2") {
+        return 2;
+    }
+    if (type == "VEC3") {
+        return 3;
+    }
+    if (type == "VEC4" || type == "MAT2") {
+        return 4;
+    }
+    if (type == "MAT3") {
+        return 9;
+    }
+    if (type == "MAT4") {
+        return 16;
+    }
+    return 0;
+}
+
+// An integral number in [0, limit), so casting it is defined. NaN fails
+// every comparison and infinities fail the bound.
+bool IsInteger(const JsonValue& value, double limit) {
+    return value.IsNumber() && value.number >= 0.0 && value.number < limit && value.number == std::floor(value.number);
+}
+
+// Reads an optional non-negative integer index below `limit`. Returns false
+// only when the member is present but invalid.
+bool ReadIndex(const JsonValue& object, std::string_view key, std::size_t limit, int32_t* out) {
+    const JsonValue* value = object.Find(key);
+    if (!value) {
+        return true;
+    }
+    if (!IsInteger(*value, static_cast<double>(limit))) {
+        return false;
+    }
+    *out = static_cast<int32_t>(value->number);
+    return true;
+}
+
+// Reads an optional non-negative integer below `limit` (at most
+// kUint32Limit); `*out` keeps its value when the member is absent. Returns
+// false only when the member is present but invalid.
+template <typename T>
+bool ReadUnsigned(const JsonValue& object, std::string_view key, double limit, T* out) {
+    const JsonValue* value = object.Find(key);
+    if (!value) {
+        return true;
+    }
+    if (!IsInteger(*value, limit)) {
+        return false;
+    }
+    *out = static_cast<T>(value->number);
+    return true;
+}
+
+bool ReadFloats(const JsonValue* value, float* out, std::size_t count) {
+    if (!value || !value->IsArray() || value->array.size() != count) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!value->array[i].IsNumber()) {
+            return false;
+        }
+        out[i] = static_cast<float>(value->array[i].number);
+    }
+    return true;
+}
+
+const std::vector<JsonValue>* ArrayMember(const JsonValue& object, std::string_view key) {
+    const JsonValue* value = object.Find(key);
+    return value && value->IsArray() ? &value->array : nullptr;
+}
+
+}  // namespace
+
+uint32_t GltfAccessor::ComponentSize(uint32_t type) {
+    switch (type) {
+        case kGltfByte:
+        case kGltfUnsignedByte:
+            return 1;
+        case kGltfShort:
+        case kGltfUnsignedShort:
+            return 2;
+        case kGltfUnsignedInt:
+        case kGltfFloat:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+uint32_t GltfAccessor::ElementSize() const {
+    return ComponentSize(componentType) * componentCount;
+}
+
+uint32_t GltfAccessor::UintAt(std::size_t i) const {
+    const uint8_t* element = data.data() + i * stride;
+    switch (componentType) {
+        case kGltfUnsignedByte:
+            return *element;
+        case kGltfUnsignedShort:
+            return *reinterpret_cast<const uint16_t*>(element);
+        default:
+            return *reinterpret_cast<const uint32_t*>(element);
+    }
+}
+
+Vec3 GltfAccessor::Vec3At(std::size_t i) const {
+    const auto* element = reinterpret_cast<const float*>(data.data() + i * stride);
+    return Vec3(element[0], element[1], element[2]);
+}
+
+void GlbAsset::Reset() {
+    bin_ = {};
+    bufferViews_.clear();
+    accessors_.clear();
+    meshes_.clear();
+    nodes_.clear();
+    materials_.clear();
+    sceneRoots_.clear();
+}
+
+bool GlbAsset::Open(const char* path, std::string* error) {
+    Reset();
+    file_.Close();
+    if (!file_.Open(path)) {
+        return Fail(error, std::string("cannot map ") + path);
+    }
+    const std::span<const uint8_t> bytes = file_.Bytes();
+    if (!Parse(bytes, error)) {
+        file_.Close();
+        return false;
+    }
+    return true;
+}
+
+bool GlbAsset::Parse(std::span<const uint8_t> bytes, std::string* error) {
+    Reset();
+
+    // Header and chunk layout.
+    if (bytes.size() < kHeaderSize + kChunkHeaderSize) {
+        return Fail(error, "file too small for a GLB header");
+    }
+    if (ReadU32(bytes.data()) != kGlbMagic) {
+        return Fail(error, "not a GLB file");
+    }
+    if (ReadU32(bytes.data() + 4) != 2) {
+        return Fail(error, "unsupported GLB version");
+    }
+    const std::size_t totalLength = ReadU32(bytes.data() + 8);
+    if (totalLength > bytes.size()) {
+        return Fail(error, "GLB length exceeds file size");
+    }
+
+    std::string_view jsonText;
+    std::size_t offset = kHeaderSize;
+    while (offset + kChunkHeaderSize <= totalLength) {
+        const std::size_t chunkLength = ReadU32(bytes.data() + offset);
+        const uint32_t chunkType = ReadU32(bytes.data() + offset + 4);
+        const std::size_t chunkStart = offset + kChunkHeaderSize;
+        if (chunkLength > totalLength - chunkStart) {
+            return Fail(error, "chunk extends past end of file");
+        }
+        if (offset == kHeaderSize) {
+            if (chunkType != kChunkJson) {
+                return Fail(error, "first chunk is not JSON");
+            }
+            jsonText = std::string_view(reinterpret_cast<const char*>(bytes.data() + chunkStart), chunkLength);
+        } else if (chunkType == kChunkBin && bin_.empty()) {
+            bin_ = bytes.subspan(chunkStart, chunkLength);
+        }
+        // Chunks are 4-byte aligned; unknown chunk types are skipped.
+        offset = chunkStart + ((chunkLength + 3u) & ~std::size_t{3});
+    }
+
+    JsonValue root;
+    std::string jsonError;
+    if (!ParseJson(jsonText, &root, &jsonError)) {
+        return Fail(error, "invalid JSON chunk: " + jsonError);
+    }
+    if (!root.IsObject()) {
+        return Fail(error, "JSON chunk is not an object");
+    }
+    const JsonValue* asset = root.Find("asset");
+    if (!asset || asset->StringOr("version", "").substr(0, 2) != "2.") {
+        return Fail(error, "missing or unsupported asset.version");
+    }
+
+    // Buffers: only the embedded BIN chunk (buffer 0 without a uri) is supported.
+    std::size_t binBufferLength = 0;
+    if (const auto* buffers = ArrayMember(root, "buffers")) {
+        if (!buffers->empty()) {
+            const JsonValue& buffer = buffers->front();
+            if (buffer.Find("uri")) {
+                return Fail(error, "external buffers are not supported");
+            }
+            if (!ReadUnsigned(buffer, "byteLength", kUint32Limit, &binBufferLength) ||
+                binBufferLength > bin_.size()) {
+                return Fail(error, "buffer 0 is larger than the BIN chunk");
+            }
+        }
+    }
+
+    if (const auto* views = ArrayMember(root, "bufferViews")) {
+        bufferViews_.reserve(views->size());
+        for (const JsonValue& view : *views) {
+            if (view.NumberOr("buffer", -1.0) != 0.0) {
+                return Fail(error, "bufferView references an unsupported buffer");
+            }
+            std::size_t viewOffset = 0;
+            std::size_t viewLength = 0;
+            if (!view.Find("byteLength") || !ReadUnsigned(view, "byteOffset", kUint32Limit, &viewOffset) ||
+                !ReadUnsigned(view, "byteLength", kUint32Limit, &viewLength) || viewOffset > binBufferLength ||
+                viewLength > binBufferLength - viewOffset) {
+                return Fail(error, "bufferView out of range");
+            }
+            GltfBufferView out;
+            out.data = bin_.subspan(viewOffset, viewLength);
+            if (!ReadUnsigned(view, "byteStride", kUint32Limit, &out.byteStride) ||
+                (out.byteStride != 0 && (out.byteStride < 4 || out.byteStride > 252 || out.byteStride % 4 != 0))) {
+                return Fail(error, "invalid bufferView.byteStride");
+            }
+            if (!ReadUnsigned(view, "target", kUint32Limit, &out.target)) {
+                return Fail(error, "invalid bufferView.target");
+            }
+            bufferViews_.push_back(out);
+        }
+    }
+
+    if (const auto* accessors = ArrayMember(root, "accessors")) {
+        accessors_.reserve(accessors->size());
+        for (const JsonValue& accessor : *accessors) {
+            GltfAccessor out;
+            if (accessor.Find("sparse")) {
+                return Fail(error, "sparse accessors are not supported");
+            }
+            if (!accessor.Find("bufferView") || !ReadIndex(accessor, "bufferView", bufferViews_.size(), &out.bufferView)) {
+                return Fail(error, "accessor without a valid bufferView");
+            }
+            out.componentCount = ComponentCount(accessor.StringOr("type", ""));
+            out.normalized = accessor.BoolOr("normalized", false);
+            const bool readable = ReadUnsigned(accessor, "componentType", kUint32Limit, &out.componentType) &&
+                                  ReadUnsigned(accessor, "count", kUint32Limit, &out.count);
+            const uint32_t componentSize = GltfAccessor::ComponentSize(out.componentType);
+            if (!readable || componentSize == 0 || out.componentCount == 0 || out.count == 0) {
+                return Fail(error, "accessor has an invalid type, componentType or count");
+            }
+
+            const GltfBufferView& view = bufferViews_[static_cast<std::size_t>(out.bufferView)];
+            const std::size_t elementSize = out.ElementSize();
+            out.stride = view.byteStride != 0 ? view.byteStride : static_cast<uint32_t>(elementSize);
+            std::size_t accessorOffset = 0;
+            // 64-bit so a huge count cannot wrap where size_t is 32-bit.
+            const uint64_t extent = static_cast<uint64_t>(out.stride) * (out.count - 1) + elementSize;
+            if (!ReadUnsigned(accessor, "byteOffset", kUint32Limit, &accessorOffset) ||
+                accessorOffset % componentSize != 0 || accessorOffset > view.data.size() ||
+                extent > view.data.size() - accessorOffset) {
+                return Fail(error, "accessor out of range of its bufferView");
+            }
+            out.data = view.data.subspan(accessorOffset, static_cast<std::size_t>(extent));
+            if (reinterpret_cast<uintptr_t>(out.data.data()) % componentSize != 0) {
+                return Fail(error, "accessor data is misaligned");
+            }
+
+            if (out.componentCount == 3) {
+                float bounds[6];
+                out.hasBounds = ReadFloats(accessor.Find("min"), bounds, 3) && ReadFloats(accessor.Find("max"), bounds + 3, 3);
+                if (out.hasBounds) {
+                    out.min = Vec3(bounds[0], bounds[1], bounds[2]);
+                    out.max = Vec3(bounds[3], bounds[4], bounds[5]);
+                }
+            }
+            accessors_.push_back(out);
+        }
+    }
+
+    if (const auto* materials = ArrayMember(root, "materials")) {
+        materials_.reserve(materials->size());
+        for (const JsonValue& material : *materials) {
+            GltfMaterial out;
+            out.name = std::string(material.StringOr("name", ""));
+            if (const JsonValue* pbr = material.Find("pbrMetallicRoughness")) {
+                float color[4];
+                if (ReadFloats(pbr->Find("baseColorFactor"), color, 4)) {
+                    out.baseColor = Vec4(color[0], color[1], color[2], color[3]);
+                }
+                out.metallic = static_cast<float>(pbr->NumberOr("metallicFactor", 1.0));
+                out.roughness = static_cast<float>(pbr->NumberOr("roughnessFactor", 1.0));
+            }
+            materials_.push_back(std::move(out));
+        }
+    }
+
+    if (const auto* meshes = ArrayMember(root, "meshes")) {
+        meshes_.reserve(meshes->size());
+        for (const JsonValue& mesh : *meshes) {
+            GltfMesh out;
+            out.name = std::string(mesh.StringOr("name", ""));
+            const auto* primitives = ArrayMember(mesh, "primitives");
+            if (!primitives) {
+                return Fail(error, "mesh without primitives");
+            }
+            for (const JsonValue& primitive : *primitives) {
+                GltfPrimitive prim;
+                const JsonValue* attributes = primitive.Find("attributes");
+                if (!attributes || !attributes->IsObject() ||
+                    !ReadIndex(*attributes, "POSITION", accessors_.size(), &prim.position) ||
+                    !ReadIndex(*attributes, "NORMAL", accessors_.size(), &prim.normal) ||
+                    !ReadIndex(*attributes, "TEXCOORD_0", accessors_.size(), &prim.texcoord0) ||
+                    !ReadIndex(primitive, "indices", accessors_.size(), &prim.indices) ||
+                    !ReadIndex(primitive, "material", materials_.size(), &prim.material)) {
+                    return Fail(error, "primitive references an invalid accessor or material");
+                }
+                if (!ReadUnsigned(primitive, "mode", kUint32Limit, &prim.mode)) {
+                    return Fail(error, "invalid primitive mode");
+                }
+
+                if (prim.position < 0) {
+                    return Fail(error, "primitive without POSITION");
+                }
+                const GltfAccessor& position = accessors_[static_cast<std::size_t>(prim.position)];
+                if (position.componentType != kGltfFloat || position.componentCount != 3) {
+                    return Fail(error, "POSITION must be float VEC3");
+                }
+                if (prim.normal >= 0) {
+                    const GltfAccessor& normal = accessors_[static_cast<std::size_t>(prim.normal)];
+                    if (normal.componentCount != 3 || normal.count != position.count) {
+                        return Fail(error, "NORMAL does not match POSITION");
+                    }
+                }
+                if (prim.indices >= 0) {
+                    const GltfAccessor& indices = accessors_[static_cast<std::size_t>(prim.indices)];
+                    if (indices.componentCount != 1 ||
+                        (indices.componentType != kGltfUnsignedByte && indices.componentType != kGltfUnsignedShort &&
+                         indices.componentType != kGltfUnsignedInt)) {
+                        return Fail(error, "indices must be unsigned SCALAR");
+                    }
+                }
+                out.primitives.push_back(prim);
+            }
+            meshes_.push_back(std::move(out));
+        }
+    }
+
+    if (const auto* nodes = ArrayMember(root, "nodes")) {
+        nodes_.reserve(nodes->size());
+        for (const JsonValue& node : *nodes) {
+            GltfNode out;
+            out.name = std::string(node.StringOr("name", ""));
+            if (!ReadIndex(node, "mesh", meshes_.size(), &out.mesh)) {
+                return Fail(error, "node references an invalid mesh");
+            }
+            if (const auto* children = ArrayMember(node, "children")) {
+                for (const JsonValue& child : *children) {
+                    if (!IsInteger(child, static_cast<double>(nodes->size()))) {
+                        return Fail(error, "node references an invalid child");
+                    }
+                    out.children.push_back(static_cast<int32_t>(child.number));
+                }
+            }
+
+            // glTF matrices are column-major, like Mat4.
+            if (!ReadFloats(node.Find("matrix"), out.local.Ptr(), 16)) {
+                float t[3] = {0.0f, 0.0f, 0.0f};
+                float r[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+                float s[3] = {1.0f, 1.0f, 1.0f};
+                ReadFloats(node.Find("translation"), t, 3);
+                ReadFloats(node.Find("rotation"), r, 4);
+                ReadFloats(node.Find("scale"), s, 3);
+                out.local = ComposeTransform(Vec3(t[0], t[1], t[2]), Vec4(r[0], r[1], r[2], r[3]), Vec3(s[0], s[1], s[2]));
+            }
+            nodes_.push_back(std::move(out));
+        }
+    }
+
+    // The node graph must be a forest so traversals terminate.
+    std::vector<int32_t> parent(nodes_.size(), -1);
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        for (const int32_t child : nodes_[i].children) {
+            if (parent[static_cast<std::size_t>(child)] != -1 || child == static_cast<int32_t>(i)) {
+                return Fail(error, "node has more than one parent");
+            }
+            parent[static_cast<std::size_t>(child)] = static_cast<int32_t>(i);
+        }
+    }
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        std::size_t steps = 0;
+        for (int32_t n = parent[i]; n != -1; n = parent[static_cast<std::size_t>(n)]) {
+            if (++steps > nodes_.size()) {
+                return Fail(error, "node hierarchy contains a cycle");
+            }
+        }
+    }
+
+    // Scene roots: the default scene's nodes, or every parentless node.
+    const auto* scenes = ArrayMember(root, "scenes");
+    if (scenes && !scenes->empty()) {
+        int32_t sceneIndex = 0;
+        if (!ReadIndex(root, "scene", scenes->size(), &sceneIndex)) {
+            return Fail(error, "invalid default scene");
+        }
+        if (const auto* sceneNodes = ArrayMember((*scenes)[static_cast<std::size_t>(sceneIndex)], "nodes")) {
+            for (const JsonValue& node : *sceneNodes) {
+                if (!IsInteger(node, static_cast<double>(nodes_.size()))) {
+                    return Fail(error, "scene references an invalid node");
+                }
+                sceneRoots_.push_back(static_cast<int32_t>(node.number));
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            if (parent[i] == -1) {
+                sceneRoots_.push_back(static_cast<int32_t>(i));
+            }
+        }
+    }
+
+    return true;
+}
+
+}  // namespace engine
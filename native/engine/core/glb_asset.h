@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+#include "math_types.h"
+
+namespace engine {
+
+// glTF component types (accessor.componentType).
+enum GltfComponentType : uint32_t {
+    kGltfByte = 5120,
+    kGltfUnsignedByte = 5121,
+    kGltfShort = 5122,
+    kGltfUnsignedShort = 5123,
+    kGltfUnsignedInt = 5125,
+    kGltfFloat = 5126,
+};
+
+struct GltfBufferView {
+    std::span<const uint8_t> data;  // Points into the BIN chunk.
+    uint32_t byteStride{0};         // 0 when tightly packed.
+    uint32_t target{0};
+};
+
+struct GltfAccessor {
+    int32_t bufferView{-1};
+    uint32_t componentType{0};
+    uint32_t componentCount{0};  // 1 for SCALAR, 3 for VEC3, ...
+    uint32_t count{0};
+    uint32_t stride{0};          // Effective stride in bytes.
+    bool normalized{false};
+    // From the first element through the end of the last one, straight out of
+    // the BIN chunk. Strided data also covers the bytes in between.
+    std::span<const uint8_t> data;
+    bool hasBounds{false};
+    Vec3 min{};
+    Vec3 max{};
+
+    uint32_t ElementSize() const;
+    bool IsPacked() const { return stride == ElementSize(); }
+
+    // Element readers for the common cases; `i` must be below count. UintAt
+    // handles unsigned SCALAR (index) accessors, Vec3At float VEC3 ones.
+    uint32_t UintAt(std::size_t i) const;
+    Vec3 Vec3At(std::size_t i) const;
+
+    // Typed view of tightly packed data, e.g. As<float>() for a VEC3 float
+    // accessor yields count * 3 floats. Empty when the data is interleaved.
+    template <typename T>
+    std::span<const T> As() const {
+        if (!IsPacked() || sizeof(T) != ComponentSize(componentType)) {
+            return {};
+        }
+        return {reinterpret_cast<const T*>(data.data()), static_cast<std::size_t>(count) * componentCount};
+    }
+
+    static uint32_t ComponentSize(uint32_t type);
+};
+
+struct GltfPrimitive {
+    int32_t position{-1};
+    int32_t normal{-1};
+    int32_t texcoord0{-1};
+    int32_t indices{-1};
+    int32_t material{-1};
+    uint32_t mode{4};  // GL_TRIANGLES
+};
+
+struct GltfMesh {
+    std::string name;
+    std::vector<GltfPrimitive> primitives;
+};
+
+struct GltfNode {
+    std::string name;
+    int32_t mesh{-1};
+    std::vector<int32_t> children;
+    Mat4 local{Mat4::Identity()};
+};
+
+struct GltfMaterial {
+    std::string name;
+    Vec4 baseColor{1.0f, 1.0f, 1.0f, 1.0f};
+    float metallic{1.0f};
+    float roughness{1.0f};
+};
+
+// Binary glTF 2.0 (.glb) reader. The file is memory-mapped and never copied:
+// buffer views and accessors are spans into the mapped BIN chunk that can be
+// handed to glBufferData as they are. Everything referenced from the JSON is
+// bounds-checked against the chunk during Open/Parse, so a successful load
+// guarantees every span is valid.
+class GlbAsset {
+public:
+    bool Open(const char* path, std::string* error);
+
+    // Parses GLB bytes owned by the caller (e.g. an uncompressed APK asset);
+    // they must outlive this object.
+    bool Parse(std::span<const uint8_t> bytes, std::string* error);
+
+    std::span<const uint8_t> BinChunk() const { return bin_; }
+    const std::vector<GltfBufferView>& BufferViews() const { return bufferViews_; }
+    const std::vector<GltfAccessor>& Accessors() const { return accessors_; }
+    const std::vector<GltfMesh>& Meshes() const { return meshes_; }
+    const std::vector<GltfNode>& Nodes() const { return nodes_; }
+    const std::vector<GltfMaterial>& Materials() const { return materials_; }
+    const std::vector<int32_t>& SceneRoots() const { return sceneRoots_; }
+
+private:
+    void Reset();
+
+    MappedFile file_;
+    std::span<const uint8_t> bin_;
+    std::vector<GltfBufferView> bufferViews_;
+    std::vector<GltfAccessor> accessors_;
+    std::vector<GltfMesh> meshes_;
+    std::vector<GltfNode> nodes_;
+    std::vector<GltfMaterial> materials_;
+    std::vector<int32_t> sceneRoots_;
+};
+
+}  // namespace engine
@@ -0,0 +1,115 @@
+#include "gpu_model.h"
+
+#include <algorithm>
+
+#include "gl_state_cache.h"
+
+namespace engine {
+
+GpuModel::GpuModel(std::unique_ptr<DecodedModel> model) : model_(std::move(model)) {
+    const CookedMesh& mesh = model_->mesh;
+    id_ = model_->id;
+    submeshes_.assign(mesh.Submeshes().begin(), mesh.Submeshes().end());
+    instances_.assign(mesh.Instances().begin(), mesh.Instances().end());
+    materials_.assign(mesh.Materials().begin(), mesh.Materials().end());
+    boundsMin_ = Vec3(mesh.Header().boundsMin[0], mesh.Header().boundsMin[1], mesh.Header().boundsMin[2]);
+    boundsMax_ = Vec3(mesh.Header().boundsMax[0], mesh.Header().boundsMax[1], mesh.Header().boundsMax[2]);
+    vertexSize_ = mesh.VertexData().size();
+    indexSize_ = mesh.IndexData().size();
+}
+
+GpuModel::~GpuModel() {
+    Destroy();
+}
+
+std::size_t GpuModel::RemainingBytes() const {
+    return (vertexSize_ - vertexUploaded_) + (indexSize_ - indexUploaded_);
+}
+
+std::size_t GpuModel::Upload(std::size_t budgetBytes) {
+    GlStateCache& state = GlStateCache::Current();
+    std::size_t copied = 0;
+    switch (stage_) {
+        case Stage::kAllocate:
+            // Storage only; the data follows in chunks. The element buffer
+            // binding belongs to the bound VAO, so that must be VAO 0.
+            state.BindVertexArray(0);
+            glGenBuffers(1, &vbo_);
+            state.BindBuffer(GL_ARRAY_BUFFER, vbo_);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexSize_), nullptr, GL_STATIC_DRAW);
+            glGenBuffers(1, &ibo_);
+            state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexSize_), nullptr, GL_STATIC_DRAW);
+            stage_ = Stage::kVertices;
+            break;
+
+        case Stage::kVertices:
+        case Stage::kIndices: {
+            const bool vertices = stage_ == Stage::kVertices;
+            const GLenum target = vertices ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+            const std::span<const uint8_t> source = vertices ? model_->mesh.VertexData() : model_->mesh.IndexData();
+            std::size_t& uploaded = vertices ? vertexUploaded_ : indexUploaded_;
+
+            state.BindVertexArray(0);
+            state.BindBuffer(target, vertices ? vbo_ : ibo_);
+            while (uploaded < source.size() && copied < budgetBytes) {
+                const std::size_t size = std::min({kChunkBytes, source.size() - uploaded, budgetBytes - copied});
+                glBufferSubData(target, static_cast<GLintptr>(uploaded), static_cast<GLsizeiptr>(size),
+                                source.data() + uploaded);
+                uploaded += size;
+                copied += size;
+            }
+            if (uploaded == source.size()) {
+                stage_ = vertices ? Stage::kIndices : Stage::kVertexArrays;
+            }
+            break;
+        }
+
+        case Stage::kVertexArrays:
+            vaos_.resize(submeshes_.size());
+            glGenVertexArrays(static_cast<GLsizei>(vaos_.size()), vaos_.data());
+            for (std::size_t i = 0; i < submeshes_.size(); ++i) {
+                const auto base = static_cast<uintptr_t>(submeshes_[i].vertexOffset);
+                state.BindVertexArray(vaos_[i]);
+                state.BindBuffer(GL_ARRAY_BUFFER, vbo_);
+                glEnableVertexAttribArray(0);
+                glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(cooked::Vertex),
+                                      reinterpret_cast<const void*>(base + offsetof(cooked::Vertex, position)));
+                glEnableVertexAttribArray(1);
+                glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(cooked::Vertex),
+                                      reinterpret_cast<const void*>(base + offsetof(cooked::Vertex, normal)));
+                state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+            }
+            state.BindVertexArray(0);
+            // The driver has its copy; drop ours.
+            model_.reset();
+            stage_ = Stage::kReady;
+            break;
+
+        case Stage::kReady:
+            break;
+    }
+    return copied;
+}
+
+void GpuModel::Bind(std::size_t submesh) const {
+    GlStateCache::Current().BindVertexArray(vaos_[submesh]);
+}
+
+void GpuModel::Destroy() {
+    GlStateCache& state = GlStateCache::Current();
+    if (!vaos_.empty()) {
+        state.DeleteVertexArrays(static_cast<GLsizei>(vaos_.size()), vaos_.data());
+        vaos_.clear();
+    }
+    if (vbo_ != 0) {
+        state.DeleteBuffers(1, &vbo_);
+        vbo_ = 0;
+    }
+    if (ibo_ != 0) {
+        state.DeleteBuffers(1, &ibo_);
+        ibo_ = 0;
+    }
+}
+
+}  // namespace engine
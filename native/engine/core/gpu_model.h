@@ -0,0 +1,73 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "asset_streamer.h"
+#include "cooked_mesh.h"
+#include "math_types.h"
+
+namespace engine {
+
+// GL buffers for one streamed model, filled a slice at a time so a large
+// model never stalls a frame. Upload() runs on the render thread with the
+// context current; once Ready() the decoded CPU copy is released and only the
+// small submesh/instance/material tables are kept.
+class GpuModel {
+public:
+    explicit GpuModel(std::unique_ptr<DecodedModel> model);
+    ~GpuModel();
+
+    GpuModel(const GpuModel&) = delete;
+    GpuModel& operator=(const GpuModel&) = delete;
+
+    // Copies at most `budgetBytes` of vertex/index data into the buffers, in
+    // slices of up to kChunkBytes, and returns the bytes copied. Buffer storage
+    // is allocated and the VAOs are built in calls of their own (which copy
+    // nothing), so a caller looping until its budget is spent always advances.
+    std::size_t Upload(std::size_t budgetBytes);
+    bool Ready() const { return stage_ == Stage::kReady; }
+    std::size_t RemainingBytes() const;
+
+    // Binds the VAO of `submesh` (vertex attributes and index buffer).
+    void Bind(std::size_t submesh) const;
+    GLuint VertexArray(std::size_t submesh) const { return vaos_[submesh]; }
+    // Deletes the GL objects; safe without a context (names are forgotten).
+    void Destroy();
+
+    uint64_t Id() const { return id_; }
+    const std::vector<cooked::Submesh>& Submeshes() const { return submeshes_; }
+    const std::vector<cooked::Instance>& Instances() const { return instances_; }
+    const std::vector<cooked::Material>& Materials() const { return materials_; }
+    Vec3 BoundsMin() const { return boundsMin_; }
+    Vec3 BoundsMax() const { return boundsMax_; }
+
+    // Largest single glBufferSubData Upload() issues.
+    static constexpr std::size_t kChunkBytes = 256 * 1024;
+
+private:
+    enum class Stage { kAllocate, kVertices, kIndices, kVertexArrays, kReady };
+
+    std::unique_ptr<DecodedModel> model_;
+    uint64_t id_{0};
+    Stage stage_{Stage::kAllocate};
+    std::size_t vertexUploaded_{0};
+    std::size_t indexUploaded_{0};
+    std::size_t vertexSize_{0};
+    std::size_t indexSize_{0};
+
+    GLuint vbo_{0};
+    GLuint ibo_{0};
+    std::vector<GLuint> vaos_;
+
+    std::vector<cooked::Submesh> submeshes_;
+    std::vector<cooked::Instance> instances_;
+    std::vector<cooked::Material> materials_;
+    Vec3 boundsMin_;
+    Vec3 boundsMax_;
+};
+
+}  // namespace engine
@@ -1,5 +1,7 @@
 #include "grid_plane.h"
 
+#include "gl_state_cache.h"
+
 namespace engine {
 
 GridPlane::~GridPlane() {
@@ -16,33 +18,33 @@ void GridPlane::Initialize() {
         1.0f, 0.0f, 1.0f,
     };
 
+    GlStateCache& state = GlStateCache::Current();
     glGenVertexArrays(1, &vao_);
-    glBindVertexArray(vao_);
+    state.BindVertexArray(vao_);
 
     glGenBuffers(1, &vbo_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    state.BindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(0));
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Later element-buffer binds must not land in this VAO.
+    state.BindVertexArray(0);
 }
 
 void GridPlane::Draw() const {
-    glBindVertexArray(vao_);
+    GlStateCache::Current().BindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
 
 void GridPlane::Destroy() {
     if (vbo_ != 0) {
-        glDeleteBuffers(1, &vbo_);
+        GlStateCache::Current().DeleteBuffers(1, &vbo_);
         vbo_ = 0;
     }
     if (vao_ != 0) {
-        glDeleteVertexArrays(1, &vao_);
+        GlStateCache::Current().DeleteVertexArrays(1, &vao_);
         vao_ = 0;
     }
 }
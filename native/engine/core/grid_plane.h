@@ -13,6 +13,9 @@ public:
     void Destroy();
     void Draw() const;
 
+    // Triangles issued by each Draw().
+    static constexpr int kTriangleCount = 2;
+
 private:
     GLuint vao_{0};
     GLuint vbo_{0};
@@ -0,0 +1,44 @@
+#include "input_queue.h"
+
+namespace engine {
+
+InputCommandQueue::InputCommandQueue() {
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool InputCommandQueue::Push(const InputCommand& command) {
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots_[pos & kMask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.command = command;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool InputCommandQueue::Pop(InputCommand* outCommand) {
+    Slot& slot = slots_[dequeuePos_ & kMask];
+    const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeuePos_ + 1) {
+        return false;
+    }
+    *outCommand = slot.command;
+    slot.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+}  // namespace engine
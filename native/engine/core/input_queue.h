@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+enum class InputCommandType : uint8_t {
+    kOrbit,
+    kPan,
+    kZoom,
+};
+
+struct InputCommand {
+    InputCommandType type{InputCommandType::kOrbit};
+    float x{0.0f};
+    float y{0.0f};
+    int64_t timestampNanos{0};
+};
+
+// Bounded lock-free multi-producer / single-consumer ring with per-slot
+// sequence numbers. Producers (JNI touch handlers, FFI callers) never block:
+// Push fails and bumps DroppedCount() when the ring is full. Only the render
+// thread may call Pop/DrainCoalesced.
+class InputCommandQueue {
+public:
+    static constexpr std::size_t kCapacity = 256;
+
+    InputCommandQueue();
+
+    bool Push(const InputCommand& command);
+    bool Pop(InputCommand* outCommand);
+
+    // Pops everything currently queued, merging runs of consecutive commands
+    // of the same type by summing their deltas, and passes each merged
+    // command to `apply` in submission order. Returns the timestamp of the
+    // oldest command drained, or 0 when the queue was empty.
+    template <typename Apply>
+    int64_t DrainCoalesced(Apply&& apply);
+
+    uint64_t DroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+    static constexpr std::size_t kMask = kCapacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        InputCommand command{};
+    };
+
+    std::array<Slot, kCapacity> slots_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::size_t dequeuePos_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+template <typename Apply>
+int64_t InputCommandQueue::DrainCoalesced(Apply&& apply) {
+    InputCommand command;
+    if (!Pop(&command)) {
+        return 0;
+    }
+
+    const int64_t oldest = command.timestampNanos;
+    InputCommand pending = command;
+    while (Pop(&command)) {
+        if (command.type == pending.type) {
+            pending.x += command.x;
+            pending.y += command.y;
+            pending.timestampNanos = command.timestampNanos;
+            continue;
+        }
+        apply(pending);
+        pending = command;
+    }
+    apply(pending);
+    return oldest;
+}
+
+}  // namespace engine
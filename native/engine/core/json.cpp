@@ -0,0 +1,343 @@
+#include "json.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace engine {
+
+namespace {
+
+constexpr int kMaxDepth = 64;
+
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    bool ParseDocument(JsonValue* out) {
+        SkipWhitespace();
+        if (!ParseValue(out, 0)) {
+            return false;
+        }
+        SkipWhitespace();
+        // The GLB JSON chunk is padded with spaces; trailing NULs are tolerated
+        // for writers that pad incorrectly.
+        while (pos_ < text_.size() && text_[pos_] == '\0') {
+            ++pos_;
+        }
+        return pos_ == text_.size() || Fail("trailing characters after document");
+    }
+
+    const std::string& Error() const { return error_; }
+
+private:
+    bool Fail(const char* message) {
+        if (error_.empty()) {
+            char buffer[128];
+            std::snprintf(buffer, sizeof(buffer), "%s at offset %zu", message, pos_);
+            error_ = buffer;
+        }
+        return false;
+    }
+
+    void SkipWhitespace() {
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++pos_;
+        }
+    }
+
+    bool Consume(char expected) {
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConsumeLiteral(std::string_view literal) {
+        if (text_.substr(pos_, literal.size()) == literal) {
+            pos_ += literal.size();
+            return true;
+        }
+        return Fail("invalid literal");
+    }
+
+    bool ParseValue(JsonValue* out, int depth) {
+        if (depth > kMaxDepth) {
+            return Fail("nesting too deep");
+        }
+        if (pos_ >= text_.size()) {
+            return Fail("unexpected end of input");
+        }
+
+        switch (text_[pos_]) {
+            case '{':
+                return ParseObject(out, depth);
+            case '[':
+                return ParseArray(out, depth);
+            case '"':
+                out->type = JsonValue::Type::kString;
+                return ParseString(&out->string);
+            case 't':
+                out->type = JsonValue::Type::kBool;
+                out->boolean = true;
+                return ConsumeLiteral("true");
+            case 'f':
+                out->type = JsonValue::Type::kBool;
+                out->boolean = false;
+                return ConsumeLiteral("false");
+            case 'n':
+                out->type = JsonValue::Type::kNull;
+                return ConsumeLiteral("null");
+            default:
+                return ParseNumber(out);
+        }
+    }
+
+    bool ParseObject(JsonValue* out, int depth) {
+        out->type = JsonValue::Type::kObject;
+        ++pos_;
+        SkipWhitespace();
+        if (Consume('}')) {
+            return true;
+        }
+        for (;;) {
+            SkipWhitespace();
+            JsonMember member;
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return Fail("expected member name");
+            }
+            if (!ParseString(&member.key)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (!Consume(':')) {
+                return Fail("expected ':'");
+            }
+            SkipWhitespace();
+            if (!ParseValue(&member.value, depth + 1)) {
+                return false;
+            }
+            out->members.push_back(std::move(member));
+            SkipWhitespace();
+            if (Consume('}')) {
+                return true;
+            }
+            if (!Consume(',')) {
+                return Fail("expected ',' or '}'");
+            }
+        }
+    }
+
+    bool ParseArray(JsonValue* out, int depth) {
+        out->type = JsonValue::Type::kArray;
+        ++pos_;
+        SkipWhitespace();
+        if (Consume(']')) {
+            return true;
+        }
+        for (;;) {
+            SkipWhitespace();
+            out->array.emplace_back();
+            if (!ParseValue(&out->array.back(), depth + 1)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (Consume(']')) {
+                return true;
+            }
+            if (!Consume(',')) {
+                return Fail("expected ',' or ']'");
+            }
+        }
+    }
+
+    static int HexDigit(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    bool ParseHex4(uint32_t* out) {
+        if (pos_ + 4 > text_.size()) {
+            return Fail("truncated \\u escape");
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int digit = HexDigit(text_[pos_++]);
+            if (digit < 0) {
+                return Fail("invalid \\u escape");
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        *out = value;
+        return true;
+    }
+
+    static void AppendUtf8(uint32_t codepoint, std::string* out) {
+        if (codepoint < 0x80) {
+            out->push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            out->push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            out->push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else if (codepoint < 0x10000) {
+            out->push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            out->push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else {
+            out->push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+            out->push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    bool ParseString(std::string* out) {
+        ++pos_;  // opening quote
+        out->clear();
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_++];
+            if (c == '"') {
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return Fail("control character in string");
+            }
+            if (c != '\\') {
+                out->push_back(c);
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                break;
+            }
+            const char escape = text_[pos_++];
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    out->push_back(escape);
+                    break;
+                case 'b':
+                    out->push_back('\b');
+                    break;
+                case 'f':
+                    out->push_back('\f');
+                    break;
+                case 'n':
+                    out->push_back('\n');
+                    break;
+                case 'r':
+                    out->push_back('\r');
+                    break;
+                case 't':
+                    out->push_back('\t');
+                    break;
+                case 'u': {
+                    uint32_t codepoint = 0;
+                    if (!ParseHex4(&codepoint)) {
+                        return false;
+                    }
+                    if (codepoint >= 0xD800 && codepoint < 0xDC00) {
+                        uint32_t low = 0;
+                        if (!Consume('\\') || !Consume('u') || !ParseHex4(&low) || low < 0xDC00 || low >= 0xE000) {
+                            return Fail("unpaired surrogate");
+                        }
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(codepoint, out);
+                    break;
+                }
+                default:
+                    return Fail("invalid escape");
+            }
+        }
+        return Fail("unterminated string");
+    }
+
+    bool ParseNumber(JsonValue* out) {
+        const std::size_t start = pos_;
+        Consume('-');
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_];
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                ++pos_;
+            } else {
+                break;
+            }
+        }
+
+        // strtod needs a terminated buffer; JSON numbers are short.
+        char buffer[64];
+        const std::size_t length = pos_ - start;
+        if (length == 0 || length >= sizeof(buffer)) {
+            pos_ = start;
+            return Fail("invalid value");
+        }
+        text_.copy(buffer, length, start);
+        buffer[length] = '\0';
+
+        char* end = nullptr;
+        out->type = JsonValue::Type::kNumber;
+        out->number = std::strtod(buffer, &end);
+        if (end != buffer + length) {
+            pos_ = start;
+            return Fail("invalid number");
+        }
+        return true;
+    }
+
+    std::string_view text_;
+    std::size_t pos_{0};
+    std::string error_;
+};
+
+}  // namespace
+
+const JsonValue* JsonValue::Find(std::string_view key) const {
+    for (const JsonMember& member : members) {
+        if (member.key == key) {
+            return &member.value;
+        }
+    }
+    return nullptr;
+}
+
+double JsonValue::NumberOr(std::string_view key, double fallback) const {
+    const JsonValue* value = Find(key);
+    return value && value->IsNumber() ? value->number : fallback;
+}
+
+bool JsonValue::BoolOr(std::string_view key, bool fallback) const {
+    const JsonValue* value = Find(key);
+    return value && value->type == Type::kBool ? value->boolean : fallback;
+}
+
+std::string_view JsonValue::StringOr(std::string_view key, std::string_view fallback) const {
+    const JsonValue* value = Find(key);
+    return value && value->IsString() ? std::string_view(value->string) : fallback;
+}
+
+bool ParseJson(std::string_view text, JsonValue* out, std::string* error) {
+    Parser parser(text);
+    *out = JsonValue{};
+    if (!parser.ParseDocument(out)) {
+        if (error) {
+            *error = parser.Error();
+        }
+        return false;
+    }
+    return true;
+}
+
+}  // namespace engine
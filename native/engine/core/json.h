@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+
+struct JsonMember;
+
+// Minimal JSON document model, enough for glTF. Objects keep their members
+// in file order; lookups are linear, which is fine for glTF-sized objects.
+class JsonValue {
+public:
+    enum class Type : unsigned char {
+        kNull,
+        kBool,
+        kNumber,
+        kString,
+        kArray,
+        kObject,
+    };
+
+    Type type{Type::kNull};
+    bool boolean{false};
+    double number{0.0};
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<JsonMember> members;
+
+    bool IsNumber() const { return type == Type::kNumber; }
+    bool IsString() const { return type == Type::kString; }
+    bool IsArray() const { return type == Type::kArray; }
+    bool IsObject() const { return type == Type::kObject; }
+
+    // Member lookup; null if this is not an object or the key is absent.
+    const JsonValue* Find(std::string_view key) const;
+
+    double NumberOr(std::string_view key, double fallback) const;
+    bool BoolOr(std::string_view key, bool fallback) const;
+    std::string_view StringOr(std::string_view key, std::string_view fallback) const;
+};
+
+struct JsonMember {
+    std::string key;
+    JsonValue value;
+};
+
+// Parses a complete JSON document. On failure returns false and, if `error`
+// is non-null, describes the problem and its byte offset.
+bool ParseJson(std::string_view text, JsonValue* out, std::string* error);
+
+}  // namespace engine
@@ -0,0 +1,50 @@
+#include "lod_selector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+LodView MakeLodView(const OrbitCamera& camera, float maxErrorPixels) {
+    LodView view;
+    view.eye = camera.EyePosition();
+    // Projection row 1 holds 1 / tan(fovy / 2); half the viewport height maps
+    // to that many units at distance 1.
+    view.pixelsPerUnit = static_cast<float>(camera.ViewportHeight()) * 0.5f * camera.ProjectionMatrix().data[5];
+    view.maxErrorPixels = maxErrorPixels;
+    return view;
+}
+
+float MaxAxisScale(const Mat4& world) {
+    float scale = 0.0f;
+    for (int column = 0; column < 3; ++column) {
+        const Vec3 axis(world.data[column * 4], world.data[column * 4 + 1], world.data[column * 4 + 2]);
+        scale = std::max(scale, Length(axis));
+    }
+    return scale;
+}
+
+uint32_t SelectLod(const cooked::Submesh& submesh, const Mat4& world, const LodView& view) {
+    if (submesh.lodCount <= 1) {
+        return 0;
+    }
+
+    const Vec4 center = Multiply(world, Vec4(submesh.sphereCenter[0], submesh.sphereCenter[1],
+                                             submesh.sphereCenter[2], 1.0f));
+    const float scale = MaxAxisScale(world);
+
+    const float distance = Length(Vec3(center.x, center.y, center.z) - view.eye) - submesh.sphereRadius * scale;
+    if (distance <= 0.0f || scale <= 0.0f || view.pixelsPerUnit <= 0.0f) {
+        return 0;
+    }
+
+    // Largest error that still projects under the pixel budget.
+    const float allowedError = view.maxErrorPixels * distance / (view.pixelsPerUnit * scale);
+    uint32_t level = 0;
+    while (level + 1 < submesh.lodCount && submesh.lods[level + 1].error <= allowedError) {
+        ++level;
+    }
+    return level;
+}
+
+}  // namespace engine
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+#include "camera.h"
+#include "cooked_mesh.h"
+#include "math_types.h"
+
+namespace engine {
+
+// Per-frame inputs for screen-space error LOD selection.
+struct LodView {
+    Vec3 eye;
+    // Pixels covered by one world unit at distance 1 in front of the eye.
+    float pixelsPerUnit{0.0f};
+    // Largest on-screen deviation from full detail that is accepted.
+    float maxErrorPixels{1.0f};
+};
+
+LodView MakeLodView(const OrbitCamera& camera, float maxErrorPixels);
+
+// Largest axis scale of an instance transform; bounding radii and
+// simplification errors grow by it.
+float MaxAxisScale(const Mat4& world);
+
+// Picks the coarsest level of `submesh` whose simplification error, placed
+// at the nearest point of the instance's bounding sphere, projects to at
+// most view.maxErrorPixels. Returns 0 when the eye is inside the sphere.
+uint32_t SelectLod(const cooked::Submesh& submesh, const Mat4& world, const LodView& view);
+
+}  // namespace engine
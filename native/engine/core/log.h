@@ -0,0 +1,25 @@
+#pragma once
+
+// Logging shim so engine_core also builds for host tools. On Android this
+// forwards to logcat; elsewhere it writes to stderr.
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+
+#define ENGINE_LOGI(tag, ...) __android_log_print(ANDROID_LOG_INFO, tag, __VA_ARGS__)
+#define ENGINE_LOGW(tag, ...) __android_log_print(ANDROID_LOG_WARN, tag, __VA_ARGS__)
+#define ENGINE_LOGE(tag, ...) __android_log_print(ANDROID_LOG_ERROR, tag, __VA_ARGS__)
+#else
+#include <cstdio>
+
+#define ENGINE_LOG_HOST(level, tag, ...)                 \
+    do {                                                 \
+        std::fprintf(stderr, "%s/%s: ", level, tag);     \
+        std::fprintf(stderr, __VA_ARGS__);               \
+        std::fputc('\n', stderr);                        \
+    } while (0)
+
+#define ENGINE_LOGI(tag, ...) ENGINE_LOG_HOST("I", tag, __VA_ARGS__)
+#define ENGINE_LOGW(tag, ...) ENGINE_LOG_HOST("W", tag, __VA_ARGS__)
+#define ENGINE_LOGE(tag, ...) ENGINE_LOG_HOST("E", tag, __VA_ARGS__)
+#endif
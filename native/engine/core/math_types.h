@@ -3,6 +3,34 @@
 #include <array>
 #include <cmath>
 
+// Compile-time SIMD backend selection. Define ENGINE_MATH_FORCE_SCALAR to pin
+// every kernel to the scalar reference path (useful when bisecting precision
+// issues on device).
+#if !defined(ENGINE_MATH_FORCE_SCALAR)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ENGINE_MATH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define ENGINE_MATH_SSE 1
+#if defined(__AVX__)
+#define ENGINE_MATH_AVX 1
+#endif
+#endif
+#endif
+
+#if defined(ENGINE_MATH_NEON) || defined(ENGINE_MATH_SSE)
+#define ENGINE_MATH_SIMD 1
+#endif
+
+// Mat4 x Mat4 through SSE alone measures no faster than the compiler's own
+// vectorisation of the scalar loop (tools/math_bench.cpp), so plain SSE
+// builds keep the scalar reference; AVX (two columns at once) and NEON use
+// the SIMD kernel.
+#if defined(ENGINE_MATH_NEON) || defined(ENGINE_MATH_AVX)
+#define ENGINE_MATH_SIMD_MAT4_MULTIPLY 1
+#endif
+
 namespace engine {
 
 struct Vec2 {
@@ -19,7 +47,7 @@ struct Vec3 {
     Vec3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
 };
 
-struct Vec4 {
+struct alignas(16) Vec4 {
     float x{0.0f};
     float y{0.0f};
     float z{0.0f};
@@ -84,7 +112,7 @@ inline Vec3 Normalize(const Vec3& v) {
     return v / len;
 }
 
-struct Mat4 {
+struct alignas(16) Mat4 {
     std::array<float, 16> data{0.0f};
 
     float* Ptr() { return data.data(); }
@@ -102,6 +130,21 @@ struct Mat4 {
     }
 };
 
+#if defined(ENGINE_MATH_NEON)
+constexpr const char* kMathBackend = "neon";
+#elif defined(ENGINE_MATH_AVX)
+constexpr const char* kMathBackend = "avx";
+#elif defined(ENGINE_MATH_SSE)
+constexpr const char* kMathBackend = "sse";
+#else
+constexpr const char* kMathBackend = "scalar";
+#endif
+
+// Scalar reference implementations. They are the ground truth the SIMD
+// kernels are checked against (tools/math_bench.cpp) and the fallback on
+// targets without NEON/SSE.
+namespace scalar {
+
 inline Mat4 Multiply(const Mat4& a, const Mat4& b) {
     Mat4 result;
     for (int row = 0; row < 4; ++row) {
@@ -116,6 +159,19 @@ inline Mat4 Multiply(const Mat4& a, const Mat4& b) {
     return result;
 }
 
+inline Vec4 Multiply(const Mat4& m, const Vec4& v) {
+    const float in[4] = {v.x, v.y, v.z, v.w};
+    float out[4];
+    for (int row = 0; row < 4; ++row) {
+        float sum = 0.0f;
+        for (int k = 0; k < 4; ++k) {
+            sum += m.data[k * 4 + row] * in[k];
+        }
+        out[row] = sum;
+    }
+    return Vec4{out[0], out[1], out[2], out[3]};
+}
+
 inline Mat4 Perspective(float fovyRadians, float aspect, float zNear, float zFar) {
     const float tanHalfFovy = std::tan(fovyRadians * 0.5f);
     Mat4 result{};
@@ -153,6 +209,270 @@ inline Mat4 LookAt(const Vec3& eye, const Vec3& center, const Vec3& up) {
     return result;
 }
 
+}  // namespace scalar
+
+#if defined(ENGINE_MATH_SIMD)
+// SIMD kernels. A thin four-lane layer (F4) abstracts NEON and SSE so the
+// matrix kernels below are written once. Operation order mirrors the scalar
+// reference so SSE results are bit-identical; NEON on arm64 uses fused
+// multiply-add and stays within a few ULP.
+namespace simd {
+
+#if defined(ENGINE_MATH_NEON)
+using F4 = float32x4_t;
+
+inline F4 Load(const float* p) { return vld1q_f32(p); }
+inline void Store(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 Set(float x, float y, float z, float w) {
+    const float lanes[4] = {x, y, z, w};
+    return vld1q_f32(lanes);
+}
+inline F4 Splat(float s) { return vdupq_n_f32(s); }
+inline F4 Add(F4 a, F4 b) { return vaddq_f32(a, b); }
+inline F4 Sub(F4 a, F4 b) { return vsubq_f32(a, b); }
+inline F4 Mul(F4 a, F4 b) { return vmulq_f32(a, b); }
+inline F4 Negate(F4 v) { return vnegq_f32(v); }
+inline F4 Abs(F4 v) { return vabsq_f32(v); }
+inline F4 MulAdd(F4 acc, F4 a, F4 b) {
+#if defined(__aarch64__)
+    return vfmaq_f32(acc, a, b);
+#else
+    return vmlaq_f32(acc, a, b);
+#endif
+}
+
+template <int Lane>
+inline F4 Broadcast(F4 v) {
+    if constexpr (Lane < 2) {
+        return vdupq_lane_f32(vget_low_f32(v), Lane);
+    } else {
+        return vdupq_lane_f32(vget_high_f32(v), Lane - 2);
+    }
+}
+
+template <int Lane>
+inline float Extract(F4 v) { return vgetq_lane_f32(v, Lane); }
+
+// Bit i of the result is set when lane i of a >= lane i of b.
+inline int GreaterEqualMask(F4 a, F4 b) {
+    static const uint32_t kLaneBits[4] = {1u, 2u, 4u, 8u};
+    const uint32x4_t bits = vandq_u32(vcgeq_f32(a, b), vld1q_u32(kLaneBits));
+    const uint32x2_t pair = vorr_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return static_cast<int>(vget_lane_u32(pair, 0) | vget_lane_u32(pair, 1));
+}
+
+// (x, y, z, w) -> (y, z, x, y)
+inline F4 Yzx(F4 v) {
+    return vcombine_f32(vext_f32(vget_low_f32(v), vget_high_f32(v), 1), vget_low_f32(v));
+}
+
+inline void Transpose(F4& r0, F4& r1, F4& r2, F4& r3) {
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#else
+using F4 = __m128;
+
+inline F4 Load(const float* p) { return _mm_loadu_ps(p); }
+inline void Store(float* p, F4 v) { _mm_storeu_ps(p, v); }
+inline F4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline F4 Splat(float s) { return _mm_set1_ps(s); }
+inline F4 Add(F4 a, F4 b) { return _mm_add_ps(a, b); }
+inline F4 Sub(F4 a, F4 b) { return _mm_sub_ps(a, b); }
+inline F4 Mul(F4 a, F4 b) { return _mm_mul_ps(a, b); }
+inline F4 Negate(F4 v) { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+inline F4 Abs(F4 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+inline F4 MulAdd(F4 acc, F4 a, F4 b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+
+template <int Lane>
+inline F4 Broadcast(F4 v) {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+template <int Lane>
+inline float Extract(F4 v) { return _mm_cvtss_f32(Broadcast<Lane>(v)); }
+
+// Bit i of the result is set when lane i of a >= lane i of b.
+inline int GreaterEqualMask(F4 a, F4 b) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+
+// (x, y, z, w) -> (y, z, x, w)
+inline F4 Yzx(F4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+
+inline void Transpose(F4& r0, F4& r1, F4& r2, F4& r3) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+#endif
+
+// Helpers below only look at the xyz lanes; w is treated as don't-care.
+inline float Dot3(F4 a, F4 b) {
+    const F4 m = Mul(a, b);
+    return Extract<0>(m) + Extract<1>(m) + Extract<2>(m);
+}
+
+inline F4 Cross3(F4 a, F4 b) {
+    const F4 zxy = Sub(Mul(a, Yzx(b)), Mul(Yzx(a), b));
+    return Yzx(zxy);
+}
+
+inline F4 Normalize3(F4 v) {
+    const float len = std::sqrt(Dot3(v, v));
+    if (len <= 0.0f) {
+        return Set(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    return Mul(v, Splat(1.0f / len));
+}
+
+inline Mat4 Multiply(const Mat4& a, const Mat4& b) {
+    Mat4 result;
+#if defined(ENGINE_MATH_AVX)
+    // Two output columns per iteration: each 128-bit half of the 256-bit
+    // registers carries one column of b.
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.Ptr()));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.Ptr() + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.Ptr() + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.Ptr() + 12));
+    for (int col = 0; col < 4; col += 2) {
+        const __m256 bc = _mm256_loadu_ps(b.Ptr() + col * 4);
+        __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(bc, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(bc, 0xAA)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(bc, 0xFF)));
+        _mm256_storeu_ps(result.Ptr() + col * 4, r);
+    }
+#else
+    const F4 a0 = Load(a.Ptr());
+    const F4 a1 = Load(a.Ptr() + 4);
+    const F4 a2 = Load(a.Ptr() + 8);
+    const F4 a3 = Load(a.Ptr() + 12);
+    for (int col = 0; col < 4; ++col) {
+        const F4 bc = Load(b.Ptr() + col * 4);
+        F4 r = Mul(a0, Broadcast<0>(bc));
+        r = MulAdd(r, a1, Broadcast<1>(bc));
+        r = MulAdd(r, a2, Broadcast<2>(bc));
+        r = MulAdd(r, a3, Broadcast<3>(bc));
+        Store(result.Ptr() + col * 4, r);
+    }
+#endif
+    return result;
+}
+
+inline Vec4 Multiply(const Mat4& m, const Vec4& v) {
+    const F4 in = Load(&v.x);
+    F4 r = Mul(Load(m.Ptr()), Broadcast<0>(in));
+    r = MulAdd(r, Load(m.Ptr() + 4), Broadcast<1>(in));
+    r = MulAdd(r, Load(m.Ptr() + 8), Broadcast<2>(in));
+    r = MulAdd(r, Load(m.Ptr() + 12), Broadcast<3>(in));
+    Vec4 result;
+    Store(&result.x, r);
+    return result;
+}
+
+inline Mat4 Perspective(float fovyRadians, float aspect, float zNear, float zFar) {
+    const float tanHalfFovy = std::tan(fovyRadians * 0.5f);
+    Mat4 result;
+    Store(result.Ptr(), Set(1.0f / (aspect * tanHalfFovy), 0.0f, 0.0f, 0.0f));
+    Store(result.Ptr() + 4, Set(0.0f, 1.0f / tanHalfFovy, 0.0f, 0.0f));
+    Store(result.Ptr() + 8, Set(0.0f, 0.0f, -(zFar + zNear) / (zFar - zNear), -1.0f));
+    Store(result.Ptr() + 12, Set(0.0f, 0.0f, -(2.0f * zFar * zNear) / (zFar - zNear), 0.0f));
+    return result;
+}
+
+inline Mat4 LookAt(const Vec3& eye, const Vec3& center, const Vec3& up) {
+    const F4 e = Set(eye.x, eye.y, eye.z, 0.0f);
+    const F4 f = Normalize3(Sub(Set(center.x, center.y, center.z, 0.0f), e));
+    const F4 s = Normalize3(Cross3(f, Set(up.x, up.y, up.z, 0.0f)));
+    const F4 u = Cross3(s, f);
+
+    // Rows of the rotation are s, u, -f; transposing yields the columns.
+    F4 c0 = s;
+    F4 c1 = u;
+    F4 c2 = Negate(f);
+    F4 c3 = Set(0.0f, 0.0f, 0.0f, 1.0f);
+    Transpose(c0, c1, c2, c3);
+
+    Mat4 result;
+    Store(result.Ptr(), c0);
+    Store(result.Ptr() + 4, c1);
+    Store(result.Ptr() + 8, c2);
+    Store(result.Ptr() + 12, Set(-Dot3(s, e), -Dot3(u, e), Dot3(f, e), 1.0f));
+    return result;
+}
+
+}  // namespace simd
+#endif
+
+inline Mat4 Multiply(const Mat4& a, const Mat4& b) {
+#if defined(ENGINE_MATH_SIMD_MAT4_MULTIPLY)
+    return simd::Multiply(a, b);
+#else
+    return scalar::Multiply(a, b);
+#endif
+}
+
+inline Vec4 Multiply(const Mat4& m, const Vec4& v) {
+#if defined(ENGINE_MATH_SIMD)
+    return simd::Multiply(m, v);
+#else
+    return scalar::Multiply(m, v);
+#endif
+}
+
+inline Mat4 Perspective(float fovyRadians, float aspect, float zNear, float zFar) {
+#if defined(ENGINE_MATH_SIMD)
+    return simd::Perspective(fovyRadians, aspect, zNear, zFar);
+#else
+    return scalar::Perspective(fovyRadians, aspect, zNear, zFar);
+#endif
+}
+
+inline Mat4 LookAt(const Vec3& eye, const Vec3& center, const Vec3& up) {
+#if defined(ENGINE_MATH_SIMD)
+    return simd::LookAt(eye, center, up);
+#else
+    return scalar::LookAt(eye, center, up);
+#endif
+}
+
+// General 4x4 inverse via cofactor expansion. Returns identity when the
+// matrix is singular.
+inline Mat4 Inverse(const Mat4& m) {
+    const float* a = m.Ptr();
+    Mat4 result;
+    float* r = result.Ptr();
+
+    r[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    r[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    r[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    r[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    r[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    r[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    r[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    r[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    r[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    r[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    r[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    r[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    r[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    r[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    r[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    r[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    const float det = a[0] * r[0] + a[1] * r[4] + a[2] * r[8] + a[3] * r[12];
+    if (det == 0.0f) {
+        return Mat4::Identity();
+    }
+
+    const float invDet = 1.0f / det;
+    for (float& value : result.data) {
+        value *= invDet;
+    }
+    return result;
+}
+
 inline float Clamp(float value, float minValue, float maxValue) {
     return value < minValue ? minValue : (value > maxValue ? maxValue : value);
 }
@@ -0,0 +1,411 @@
+#include "mesh_cooker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "cooked_mesh.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t kTriangles = 4;
+constexpr float kUnorm16Max = 65535.0f;
+constexpr float kSnorm16Max = 32767.0f;
+constexpr float kMinExtent = 1e-12f;
+// Overdraw ordering may cost at most this much vertex cache efficiency.
+constexpr float kOverdrawThreshold = 1.05f;
+constexpr unsigned kReportCacheSize = 32;
+// Each LOD aims for half the triangles of the previous one, within an
+// object-space error budget relative to the submesh's bounding radius. A
+// level that saves less than a fifth of its parent's triangles ends the chain.
+constexpr float kLodTriangleRatio = 0.5f;
+constexpr float kLodMaxRelativeError = 0.05f;
+constexpr float kLodMinReduction = 0.8f;
+constexpr std::size_t kLodMinTriangles = 32;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+float SignNotZero(float v) {
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+int16_t ToSnorm16(float v) {
+    return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * kSnorm16Max));
+}
+
+// Area-weighted vertex normals, for primitives exported without NORMAL.
+std::vector<Vec3> ComputeNormals(const std::vector<Vec3>& positions, const std::vector<uint32_t>& indices) {
+    std::vector<Vec3> normals(positions.size());
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vec3& a = positions[indices[i]];
+        const Vec3& b = positions[indices[i + 1]];
+        const Vec3& c = positions[indices[i + 2]];
+        const Vec3 faceNormal = Cross(b - a, c - a);
+        normals[indices[i]] += faceNormal;
+        normals[indices[i + 1]] += faceNormal;
+        normals[indices[i + 2]] += faceNormal;
+    }
+    return normals;
+}
+
+struct CookedSubmeshData {
+    cooked::Submesh submesh{};
+    std::vector<cooked::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<std::vector<uint32_t>> lods;  // LOD 1 and coarser.
+};
+
+// Simplified index lists over LOD 0's vertices, coarsest last. Errors are
+// written to submesh->lods[1..].
+std::vector<std::vector<uint32_t>> BuildLodChain(const std::vector<uint32_t>& indices,
+                                                 const std::vector<Vec3>& positions,
+                                                 const std::vector<Vec3>& normals,
+                                                 float radius,
+                                                 cooked::Submesh* submesh) {
+    std::vector<std::vector<uint32_t>> lods;
+    std::vector<uint32_t> scratch(indices.size());
+    std::size_t previousCount = indices.size();
+    float previousError = 0.0f;
+    float ratio = 1.0f;
+    for (uint32_t level = 1; level < cooked::kMaxLods; ++level) {
+        ratio *= kLodTriangleRatio;
+        const std::size_t target = static_cast<std::size_t>(static_cast<float>(indices.size() / 3) * ratio) * 3;
+        if (target / 3 < kLodMinTriangles) {
+            break;
+        }
+        // Always simplify from LOD 0 so errors are measured against the source.
+        float error = 0.0f;
+        const std::size_t count = SimplifyMesh(scratch.data(), indices.data(), indices.size(), positions.data(),
+                                               normals.data(), positions.size(), target,
+                                               radius * kLodMaxRelativeError, &error);
+        if (count == 0 || static_cast<float>(count) > static_cast<float>(previousCount) * kLodMinReduction) {
+            break;
+        }
+        std::vector<uint32_t> lod(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(count));
+        OptimizeVertexCache(lod.data(), lod.size(), positions.size());
+
+        previousError = std::max(previousError, error);
+        submesh->lods[level].error = previousError;
+        previousCount = count;
+        lods.push_back(std::move(lod));
+    }
+    return lods;
+}
+
+CookedSubmeshData CookPrimitive(const GlbAsset& asset, const GltfPrimitive& primitive, CookStats* stats) {
+    const auto& accessors = asset.Accessors();
+    const GltfAccessor& positionAccessor = accessors[static_cast<std::size_t>(primitive.position)];
+    std::size_t vertexCount = positionAccessor.count;
+
+    std::vector<Vec3> positions(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        positions[i] = positionAccessor.Vec3At(i);
+    }
+
+    CookedSubmeshData out;
+    if (primitive.indices >= 0) {
+        const GltfAccessor& indexAccessor = accessors[static_cast<std::size_t>(primitive.indices)];
+        out.indices.resize(indexAccessor.count);
+        for (std::size_t i = 0; i < out.indices.size(); ++i) {
+            out.indices[i] = indexAccessor.UintAt(i);
+        }
+    } else {
+        out.indices.resize(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            out.indices[i] = static_cast<uint32_t>(i);
+        }
+    }
+    out.indices.resize(out.indices.size() / 3 * 3);
+    // Triangles that reference missing vertices are dropped.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < out.indices.size(); i += 3) {
+        if (out.indices[i] < vertexCount && out.indices[i + 1] < vertexCount && out.indices[i + 2] < vertexCount) {
+            std::copy_n(out.indices.begin() + static_cast<std::ptrdiff_t>(i), 3,
+                        out.indices.begin() + static_cast<std::ptrdiff_t>(kept));
+            kept += 3;
+        }
+    }
+    out.indices.resize(kept);
+
+    std::vector<Vec3> normals;
+    const GltfAccessor* normalAccessor =
+        primitive.normal >= 0 ? &accessors[static_cast<std::size_t>(primitive.normal)] : nullptr;
+    if (normalAccessor && normalAccessor->componentType == kGltfFloat) {
+        normals.resize(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            normals[i] = normalAccessor->Vec3At(i);
+        }
+    } else {
+        normals = ComputeNormals(positions, out.indices);
+    }
+
+    // Post-transform cache order, then overdraw order within that, then
+    // renumber vertices by first use so fetch follows the index stream.
+    // Unreferenced vertices are dropped by the renumbering.
+    stats->cacheMissesBefore +=
+        AnalyzeVertexCache(out.indices.data(), out.indices.size(), vertexCount, kReportCacheSize).transformed;
+    OptimizeVertexCache(out.indices.data(), out.indices.size(), vertexCount);
+    OptimizeOverdraw(out.indices.data(), out.indices.size(), positions.data(), vertexCount, kOverdrawThreshold);
+    stats->cacheMissesAfter +=
+        AnalyzeVertexCache(out.indices.data(), out.indices.size(), vertexCount, kReportCacheSize).transformed;
+
+    std::vector<uint32_t> oldToNew;
+    const std::size_t usedCount = OptimizeVertexFetch(out.indices.data(), out.indices.size(), vertexCount, &oldToNew);
+    {
+        std::vector<Vec3> fetchPositions(usedCount);
+        std::vector<Vec3> fetchNormals(usedCount);
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            if (oldToNew[i] != kUnusedVertex) {
+                fetchPositions[oldToNew[i]] = positions[i];
+                fetchNormals[oldToNew[i]] = normals[i];
+            }
+        }
+        positions.swap(fetchPositions);
+        normals.swap(fetchNormals);
+    }
+    vertexCount = usedCount;
+
+    Vec3 minCorner = positions.empty() ? Vec3() : positions.front();
+    Vec3 maxCorner = minCorner;
+    for (const Vec3& p : positions) {
+        minCorner = Vec3(std::min(minCorner.x, p.x), std::min(minCorner.y, p.y), std::min(minCorner.z, p.z));
+        maxCorner = Vec3(std::max(maxCorner.x, p.x), std::max(maxCorner.y, p.y), std::max(maxCorner.z, p.z));
+    }
+    const Vec3 extent(std::max(maxCorner.x - minCorner.x, kMinExtent), std::max(maxCorner.y - minCorner.y, kMinExtent),
+                      std::max(maxCorner.z - minCorner.z, kMinExtent));
+    const Vec3 center = (minCorner + maxCorner) * 0.5f;
+
+    cooked::Submesh& submesh = out.submesh;
+    submesh.vertexCount = static_cast<uint32_t>(vertexCount);
+    submesh.lodCount = 1;
+    submesh.indexType = vertexCount <= 0xFFFFu ? cooked::kIndexUint16 : cooked::kIndexUint32;
+    submesh.material = primitive.material;
+    std::memcpy(submesh.posMin, &minCorner, sizeof(submesh.posMin));
+    std::memcpy(submesh.posExtent, &extent, sizeof(submesh.posExtent));
+    std::memcpy(submesh.sphereCenter, &center, sizeof(submesh.sphereCenter));
+
+    out.vertices.resize(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        const Vec3& p = positions[i];
+        cooked::Vertex& v = out.vertices[i];
+        v.position[0] = static_cast<uint16_t>(std::lround((p.x - minCorner.x) / extent.x * kUnorm16Max));
+        v.position[1] = static_cast<uint16_t>(std::lround((p.y - minCorner.y) / extent.y * kUnorm16Max));
+        v.position[2] = static_cast<uint16_t>(std::lround((p.z - minCorner.z) / extent.z * kUnorm16Max));
+        v.padding = 0;
+
+        const float length = Length(normals[i]);
+        const Vec3 n = length > 0.0f ? normals[i] / length : Vec3(0.0f, 1.0f, 0.0f);
+        EncodeOctahedral(n, v.normal);
+
+        submesh.sphereRadius = std::max(submesh.sphereRadius, Length(p - center));
+
+        // Report what quantization costs against the source data.
+        const Vec3 decoded(minCorner.x + v.position[0] / kUnorm16Max * extent.x,
+                           minCorner.y + v.position[1] / kUnorm16Max * extent.y,
+                           minCorner.z + v.position[2] / kUnorm16Max * extent.z);
+        stats->maxPositionError = std::max(stats->maxPositionError, Length(decoded - p));
+        const float cosine = std::clamp(Dot(DecodeOctahedral(v.normal), n), -1.0f, 1.0f);
+        stats->maxNormalErrorDegrees = std::max(stats->maxNormalErrorDegrees, std::acos(cosine) * 57.2957795f);
+    }
+
+    out.lods = BuildLodChain(out.indices, positions, normals, submesh.sphereRadius, &submesh);
+    submesh.lodCount = static_cast<uint32_t>(1 + out.lods.size());
+
+    stats->vertices += vertexCount;
+    stats->triangles += out.indices.size() / 3;
+    stats->lodTriangles[0] += out.indices.size() / 3;
+    for (std::size_t i = 0; i < out.lods.size(); ++i) {
+        stats->lodTriangles[i + 1] += out.lods[i].size() / 3;
+    }
+    stats->wideIndexSubmeshes += submesh.indexType == cooked::kIndexUint32 ? 1 : 0;
+    return out;
+}
+
+void AddInstances(const GlbAsset& asset,
+                  const std::vector<std::vector<int32_t>>& submeshOfPrimitive,
+                  int32_t nodeIndex,
+                  const Mat4& parent,
+                  std::vector<cooked::Instance>* instances) {
+    const GltfNode& node = asset.Nodes()[static_cast<std::size_t>(nodeIndex)];
+    const Mat4 world = Multiply(parent, node.local);
+    if (node.mesh >= 0) {
+        for (const int32_t submesh : submeshOfPrimitive[static_cast<std::size_t>(node.mesh)]) {
+            if (submesh < 0) {
+                continue;
+            }
+            cooked::Instance instance{};
+            instance.submesh = static_cast<uint32_t>(submesh);
+            std::memcpy(instance.world, world.Ptr(), sizeof(instance.world));
+            instances->push_back(instance);
+        }
+    }
+    for (const int32_t child : node.children) {
+        AddInstances(asset, submeshOfPrimitive, child, world, instances);
+    }
+}
+
+template <typename T>
+void AppendSection(std::vector<uint8_t>* blob, const T* data, std::size_t bytes, uint64_t* outOffset) {
+    blob->resize(AlignUp(blob->size(), cooked::kSectionAlignment), 0);
+    *outOffset = blob->size();
+    const auto* raw = reinterpret_cast<const uint8_t*>(data);
+    blob->insert(blob->end(), raw, raw + bytes);
+}
+
+}  // namespace
+
+void EncodeOctahedral(const Vec3& normal, int16_t out[2]) {
+    const float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    float x = l1 > 0.0f ? normal.x / l1 : 0.0f;
+    float y = l1 > 0.0f ? normal.y / l1 : 0.0f;
+    if (normal.z < 0.0f) {
+        const float foldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float foldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+Vec3 DecodeOctahedral(const int16_t encoded[2]) {
+    const float x = std::max(encoded[0] / kSnorm16Max, -1.0f);
+    const float y = std::max(encoded[1] / kSnorm16Max, -1.0f);
+    Vec3 n(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+    if (n.z < 0.0f) {
+        n.x = (1.0f - std::fabs(y)) * SignNotZero(x);
+        n.y = (1.0f - std::fabs(x)) * SignNotZero(y);
+    }
+    return Normalize(n);
+}
+
+bool CookGlb(const GlbAsset& asset, std::vector<uint8_t>* out, CookStats* stats, std::string* error) {
+    CookStats localStats;
+    if (!stats) {
+        stats = &localStats;
+    }
+    *stats = CookStats{};
+
+    std::vector<CookedSubmeshData> submeshes;
+    std::vector<std::vector<int32_t>> submeshOfPrimitive(asset.Meshes().size());
+    for (std::size_t m = 0; m < asset.Meshes().size(); ++m) {
+        for (const GltfPrimitive& primitive : asset.Meshes()[m].primitives) {
+            if (primitive.mode != kTriangles) {
+                submeshOfPrimitive[m].push_back(-1);
+                continue;
+            }
+            submeshOfPrimitive[m].push_back(static_cast<int32_t>(submeshes.size()));
+            submeshes.push_back(CookPrimitive(asset, primitive, stats));
+        }
+    }
+    if (submeshes.empty()) {
+        if (error) {
+            *error = "asset has no triangle primitives";
+        }
+        return false;
+    }
+
+    std::vector<cooked::Instance> instances;
+    for (const int32_t root : asset.SceneRoots()) {
+        AddInstances(asset, submeshOfPrimitive, root, Mat4::Identity(), &instances);
+    }
+    if (instances.empty()) {
+        // No node references a mesh: place each submesh once at the origin.
+        const Mat4 identity = Mat4::Identity();
+        for (std::size_t i = 0; i < submeshes.size(); ++i) {
+            cooked::Instance instance{};
+            instance.submesh = static_cast<uint32_t>(i);
+            std::memcpy(instance.world, identity.Ptr(), sizeof(instance.world));
+            instances.push_back(instance);
+        }
+    }
+
+    std::vector<cooked::Material> materials;
+    for (const GltfMaterial& material : asset.Materials()) {
+        cooked::Material cookedMaterial{};
+        std::memcpy(cookedMaterial.baseColor, &material.baseColor, sizeof(cookedMaterial.baseColor));
+        cookedMaterial.metallic = material.metallic;
+        cookedMaterial.roughness = material.roughness;
+        materials.push_back(cookedMaterial);
+    }
+
+    // Vertex and index payloads, each submesh aligned for its element type.
+    std::vector<uint8_t> vertexBytes;
+    std::vector<uint8_t> indexBytes;
+    std::vector<cooked::Submesh> table;
+    for (CookedSubmeshData& data : submeshes) {
+        cooked::Submesh submesh = data.submesh;
+        submesh.vertexOffset = static_cast<uint32_t>(vertexBytes.size());
+        const auto* vertexRaw = reinterpret_cast<const uint8_t*>(data.vertices.data());
+        vertexBytes.insert(vertexBytes.end(), vertexRaw, vertexRaw + data.vertices.size() * sizeof(cooked::Vertex));
+
+        for (uint32_t level = 0; level < submesh.lodCount; ++level) {
+            const std::vector<uint32_t>& indices = level == 0 ? data.indices : data.lods[level - 1];
+            indexBytes.resize(AlignUp(indexBytes.size(), 4), 0);
+            submesh.lods[level].indexOffset = static_cast<uint32_t>(indexBytes.size());
+            submesh.lods[level].indexCount = static_cast<uint32_t>(indices.size());
+            submesh.lods[level].maxIndex =
+                indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+            if (submesh.indexType == cooked::kIndexUint16) {
+                for (const uint32_t index : indices) {
+                    const uint16_t narrow = static_cast<uint16_t>(index);
+                    const auto* raw = reinterpret_cast<const uint8_t*>(&narrow);
+                    indexBytes.insert(indexBytes.end(), raw, raw + sizeof(narrow));
+                }
+            } else {
+                const auto* raw = reinterpret_cast<const uint8_t*>(indices.data());
+                indexBytes.insert(indexBytes.end(), raw, raw + indices.size() * sizeof(uint32_t));
+            }
+        }
+        table.push_back(submesh);
+    }
+
+    cooked::Header header{};
+    header.magic = cooked::kMagic;
+    header.version = cooked::kVersion;
+    header.submeshCount = static_cast<uint32_t>(table.size());
+    header.instanceCount = static_cast<uint32_t>(instances.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+
+    // World bounds from the eight corners of every placed submesh box.
+    Vec3 boundsMin(INFINITY, INFINITY, INFINITY);
+    Vec3 boundsMax(-INFINITY, -INFINITY, -INFINITY);
+    for (const cooked::Instance& instance : instances) {
+        const cooked::Submesh& submesh = table[instance.submesh];
+        Mat4 world;
+        std::memcpy(world.Ptr(), instance.world, sizeof(instance.world));
+        for (int corner = 0; corner < 8; ++corner) {
+            const Vec4 local(submesh.posMin[0] + ((corner & 1) ? submesh.posExtent[0] : 0.0f),
+                             submesh.posMin[1] + ((corner & 2) ? submesh.posExtent[1] : 0.0f),
+                             submesh.posMin[2] + ((corner & 4) ? submesh.posExtent[2] : 0.0f), 1.0f);
+            const Vec4 p = Multiply(world, local);
+            boundsMin = Vec3(std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z));
+            boundsMax = Vec3(std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z));
+        }
+    }
+    std::memcpy(header.boundsMin, &boundsMin, sizeof(header.boundsMin));
+    std::memcpy(header.boundsMax, &boundsMax, sizeof(header.boundsMax));
+
+    std::vector<uint8_t>& blob = *out;
+    blob.assign(sizeof(header), 0);
+    AppendSection(&blob, table.data(), table.size() * sizeof(cooked::Submesh), &header.submeshOffset);
+    AppendSection(&blob, instances.data(), instances.size() * sizeof(cooked::Instance), &header.instanceOffset);
+    AppendSection(&blob, materials.data(), materials.size() * sizeof(cooked::Material), &header.materialOffset);
+    AppendSection(&blob, vertexBytes.data(), vertexBytes.size(), &header.vertexOffset);
+    AppendSection(&blob, indexBytes.data(), indexBytes.size(), &header.indexOffset);
+    header.vertexSize = vertexBytes.size();
+    header.indexSize = indexBytes.size();
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    stats->submeshes = table.size();
+    stats->instances = instances.size();
+    return true;
+}
+
+}  // namespace engine
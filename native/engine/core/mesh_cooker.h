@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cooked_mesh.h"
+#include "glb_asset.h"
+#include "math_types.h"
+
+namespace engine {
+
+// Bump whenever CookGlb produces different output for the same input; it is
+// part of every AssetCache key, so stale cached cooks are never loaded.
+constexpr uint32_t kCookerVersion = 1;
+
+struct CookStats {
+    std::size_t submeshes{0};
+    std::size_t instances{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    std::size_t wideIndexSubmeshes{0};  // Submeshes that needed 32-bit indices.
+    // Vertices transformed by a 32-entry FIFO post-transform cache before and
+    // after index optimisation; divide by triangles for ACMR.
+    std::size_t cacheMissesBefore{0};
+    std::size_t cacheMissesAfter{0};
+    std::size_t lodTriangles[cooked::kMaxLods]{};  // Summed over submeshes that have the level.
+    float maxPositionError{0.0f};       // Object-space units.
+    float maxNormalErrorDegrees{0.0f};
+};
+
+// Converts a parsed .glb into a cooked mesh blob (see cooked_mesh.h): one
+// submesh per triangle primitive, the node hierarchy flattened into
+// instances, quantized vertices, 16-bit indices wherever the vertex count
+// allows. Index buffers are reordered for the vertex cache and overdraw and
+// vertices renumbered for fetch locality (mesh_optimizer.h), and up to
+// cooked::kMaxLods levels of detail are simplified from each submesh
+// (mesh_simplifier.h). Non-triangle primitives are skipped.
+bool CookGlb(const GlbAsset& asset, std::vector<uint8_t>* out, CookStats* stats, std::string* error);
+
+// Octahedral normal encoding used by cooked vertices (snorm16 pair).
+void EncodeOctahedral(const Vec3& normal, int16_t out[2]);
+Vec3 DecodeOctahedral(const int16_t encoded[2]);
+
+}  // namespace engine
@@ -0,0 +1,324 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace engine {
+
+namespace {
+
+// Forsyth's published tuning.
+constexpr int kForsythCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr int kMaxScoredValence = 32;
+
+constexpr unsigned kOverdrawClusterCache = 16;
+constexpr std::size_t kFetchCacheLines = 128;
+constexpr std::size_t kFetchLineSize = 64;
+
+struct ScoreTables {
+    std::array<float, kForsythCacheSize> cache{};
+    std::array<float, kMaxScoredValence + 1> valence{};
+
+    ScoreTables() {
+        for (int i = 0; i < kForsythCacheSize; ++i) {
+            if (i < 3) {
+                // The last triangle's vertices get a fixed score so the next
+                // triangle does not just reuse the same edge.
+                cache[i] = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / static_cast<float>(kForsythCacheSize - 3);
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        for (int v = 1; v <= kMaxScoredValence; ++v) {
+            valence[v] = kValenceBoostScale * std::pow(static_cast<float>(v), -kValenceBoostPower);
+        }
+    }
+};
+
+float VertexScore(const ScoreTables& tables, int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+    float score = cachePosition >= 0 ? tables.cache[static_cast<std::size_t>(cachePosition)] : 0.0f;
+    // Boost vertices with few triangles left so lone triangles get finished.
+    score += tables.valence[std::min<uint32_t>(remainingTriangles, kMaxScoredValence)];
+    return score;
+}
+
+float TriangleArea(const Vec3& a, const Vec3& b, const Vec3& c) {
+    return Length(Cross(b - a, c - a)) * 0.5f;
+}
+
+}  // namespace
+
+void OptimizeVertexCache(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount) {
+    const std::size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    static const ScoreTables tables;
+
+    // Vertex -> triangle adjacency. The first remaining[v] entries of each
+    // vertex's range are its triangles not yet emitted.
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+        ++remaining[indices[i]];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(offsets[vertexCount]);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int32_t> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = VertexScore(tables, -1, remaining[v]);
+    }
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    uint32_t best = 0;
+    float bestScore = -1.0f;
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (score > bestScore) {
+            bestScore = score;
+            best = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::array<uint32_t, kForsythCacheSize + 3> cache{};
+    std::array<uint32_t, kForsythCacheSize + 3> nextCache{};
+    std::size_t cacheCount = 0;
+    std::size_t scanCursor = 0;
+
+    for (std::size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (best == kUnusedVertex) {
+            // Dead end: nothing in the cache has triangles left; restart from
+            // the next triangle in input order.
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            best = static_cast<uint32_t>(scanCursor);
+        }
+
+        const uint32_t* tri = indices + static_cast<std::size_t>(best) * 3;
+        emitted[best] = 1;
+        output.insert(output.end(), tri, tri + 3);
+
+        // New cache: this triangle's vertices first, then the previous
+        // contents minus duplicates. Entries past the cache size fall out.
+        std::size_t nextCount = 0;
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = tri[k];
+            nextCache[nextCount++] = v;
+
+            uint32_t* begin = adjacency.data() + offsets[v];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* found = std::find(begin, end, best);
+            if (found != end) {
+                *found = *(end - 1);
+                --remaining[v];
+            }
+        }
+        for (std::size_t i = 0; i < cacheCount; ++i) {
+            const uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                nextCache[nextCount++] = v;
+            }
+        }
+        std::swap(cache, nextCache);
+        cacheCount = std::min<std::size_t>(nextCount, kForsythCacheSize);
+
+        for (std::size_t i = 0; i < nextCount; ++i) {
+            const uint32_t v = cache[i];
+            cachePosition[v] = i < kForsythCacheSize ? static_cast<int32_t>(i) : -1;
+            vertexScore[v] = VertexScore(tables, cachePosition[v], remaining[v]);
+        }
+
+        // Rescore triangles touching the cache and pick the best of them.
+        best = kUnusedVertex;
+        bestScore = -1.0f;
+        for (std::size_t i = 0; i < nextCount; ++i) {
+            const uint32_t v = cache[i];
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                const uint32_t t = adjacency[a];
+                const uint32_t* candidate = indices + static_cast<std::size_t>(t) * 3;
+                const float score = vertexScore[candidate[0]] + vertexScore[candidate[1]] + vertexScore[candidate[2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+void OptimizeOverdraw(uint32_t* indices, std::size_t indexCount, const Vec3* positions, std::size_t vertexCount,
+                      float threshold) {
+    const std::size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // Cluster boundaries: triangles where all three vertices miss the FIFO
+    // cache, i.e. the cache-optimised order started over.
+    std::vector<std::size_t> clusterStart;
+    {
+        std::vector<uint32_t> stamp(vertexCount, 0);
+        uint32_t time = kOverdrawClusterCache + 1;
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (time - stamp[v] > kOverdrawClusterCache) {
+                    stamp[v] = time++;
+                    ++misses;
+                }
+            }
+            if (t == 0 || misses == 3) {
+                clusterStart.push_back(t);
+            }
+        }
+    }
+    const std::size_t clusterCount = clusterStart.size();
+    if (clusterCount < 2) {
+        return;
+    }
+    clusterStart.push_back(triangleCount);
+
+    // Area-weighted centroid and normal per cluster, and for the mesh.
+    std::vector<Vec3> clusterCentroid(clusterCount);
+    std::vector<Vec3> clusterNormal(clusterCount);
+    Vec3 meshCentroid;
+    float meshArea = 0.0f;
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        Vec3 centroid;
+        Vec3 normal;
+        float area = 0.0f;
+        for (std::size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+            const Vec3& a = positions[indices[t * 3]];
+            const Vec3& b = positions[indices[t * 3 + 1]];
+            const Vec3& d = positions[indices[t * 3 + 2]];
+            const float triangleArea = TriangleArea(a, b, d);
+            centroid += (a + b + d) * (triangleArea / 3.0f);
+            normal += Cross(b - a, d - a);
+            area += triangleArea;
+        }
+        clusterCentroid[c] = area > 0.0f ? centroid / area : positions[indices[clusterStart[c] * 3]];
+        clusterNormal[c] = normal;
+        meshCentroid += centroid;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid = meshCentroid / meshArea;
+    }
+
+    // Clusters far out along their own normal are likely to occlude the rest,
+    // so they are drawn first.
+    std::vector<float> sortKey(clusterCount);
+    std::vector<uint32_t> order(clusterCount);
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        const float length = Length(clusterNormal[c]);
+        sortKey[c] = length > 0.0f ? Dot(clusterCentroid[c] - meshCentroid, clusterNormal[c] / length) : 0.0f;
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(triangleCount * 3);
+    for (const uint32_t c : order) {
+        reordered.insert(reordered.end(), indices + clusterStart[c] * 3, indices + clusterStart[c + 1] * 3);
+    }
+
+    const float before = AnalyzeVertexCache(indices, triangleCount * 3, vertexCount, kOverdrawClusterCache).acmr;
+    const float after = AnalyzeVertexCache(reordered.data(), reordered.size(), vertexCount, kOverdrawClusterCache).acmr;
+    if (after <= before * threshold) {
+        std::copy(reordered.begin(), reordered.end(), indices);
+    }
+}
+
+std::size_t OptimizeVertexFetch(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                                std::vector<uint32_t>* oldToNew) {
+    oldToNew->assign(vertexCount, kUnusedVertex);
+    uint32_t next = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        uint32_t& mapped = (*oldToNew)[indices[i]];
+        if (mapped == kUnusedVertex) {
+            mapped = next++;
+        }
+        indices[i] = mapped;
+    }
+    return next;
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                                    unsigned cacheSize) {
+    VertexCacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) {
+        return stats;
+    }
+
+    std::vector<uint32_t> stamp(vertexCount, 0);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    std::size_t unique = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        const uint32_t v = indices[i];
+        if (time - stamp[v] > cacheSize) {
+            stamp[v] = time++;
+            ++stats.transformed;
+        }
+        if (!referenced[v]) {
+            referenced[v] = 1;
+            ++unique;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.transformed) / static_cast<float>(indexCount / 3);
+    stats.atvr = static_cast<float>(stats.transformed) / static_cast<float>(unique);
+    return stats;
+}
+
+float AnalyzeVertexFetch(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                         std::size_t vertexSize) {
+    if (indexCount == 0 || vertexCount == 0 || vertexSize == 0) {
+        return 0.0f;
+    }
+
+    // Direct-mapped cache of 64-byte lines.
+    std::array<std::size_t, kFetchCacheLines> lines;
+    lines.fill(~std::size_t{0});
+    std::size_t fetchedBytes = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        const std::size_t first = indices[i] * vertexSize / kFetchLineSize;
+        const std::size_t last = (indices[i] * vertexSize + vertexSize - 1) / kFetchLineSize;
+        for (std::size_t line = first; line <= last; ++line) {
+            std::size_t& slot = lines[line % kFetchCacheLines];
+            if (slot != line) {
+                slot = line;
+                fetchedBytes += kFetchLineSize;
+            }
+        }
+    }
+    return static_cast<float>(fetchedBytes) / static_cast<float>(vertexCount * vertexSize);
+}
+
+}  // namespace engine
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "math_types.h"
+
+namespace engine {
+
+// Index-buffer reordering used by the asset cooker. All functions work on
+// triangle lists in place; indexCount must be a multiple of three.
+
+// Tom Forsyth's linear-speed vertex cache optimisation: greedily emits the
+// triangle whose vertices score highest for a 32-entry LRU cache model.
+void OptimizeVertexCache(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+
+// Reorders clusters of a cache-optimised list so outward-facing, outer
+// clusters come first (Sander et al., "Fast triangle reordering for vertex
+// locality and reduced overdraw"). Clusters split where the post-transform
+// cache restarts, so locality inside each one is kept; the new order is
+// dropped if it raises ACMR by more than `threshold` (e.g. 1.05).
+void OptimizeOverdraw(uint32_t* indices, std::size_t indexCount, const Vec3* positions, std::size_t vertexCount,
+                      float threshold);
+
+// Renumbers vertices in first-use order so vertex fetch walks memory
+// linearly. Fills `oldToNew` (kUnusedVertex for unreferenced vertices) and
+// returns the number of vertices still referenced; callers reorder their
+// attribute arrays with the table.
+constexpr uint32_t kUnusedVertex = 0xFFFFFFFFu;
+std::size_t OptimizeVertexFetch(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                                std::vector<uint32_t>* oldToNew);
+
+// Post-transform cache efficiency for a FIFO cache of `cacheSize` entries.
+// ACMR = transformed vertices per triangle (0.5 is ideal for large grids),
+// ATVR = transformed vertices per referenced vertex (1.0 is ideal).
+struct VertexCacheStats {
+    std::size_t transformed{0};
+    float acmr{0.0f};
+    float atvr{0.0f};
+};
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                                    unsigned cacheSize);
+
+// Bytes pulled through a small cache of 64-byte lines divided by the vertex
+// buffer size (1.0 means each vertex was fetched once).
+float AnalyzeVertexFetch(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount,
+                         std::size_t vertexSize);
+
+}  // namespace engine
@@ -0,0 +1,382 @@
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+namespace {
+
+// Border planes are weighted up so open edges stay where they are.
+constexpr double kBorderWeight = 10.0;
+// A collapse may not turn any remaining triangle by more than ~78 degrees.
+constexpr double kMinNormalCosine = 0.2;
+
+// Symmetric 4x4 quadric plus the area it was accumulated over, so the error
+// of a point is a mean squared distance to the original surface.
+struct Quadric {
+    double a00{0}, a01{0}, a02{0}, a03{0};
+    double a11{0}, a12{0}, a13{0};
+    double a22{0}, a23{0};
+    double a33{0};
+    double weight{0};
+
+    static Quadric FromPlane(double nx, double ny, double nz, double d, double weight) {
+        Quadric q;
+        q.a00 = nx * nx * weight;
+        q.a01 = nx * ny * weight;
+        q.a02 = nx * nz * weight;
+        q.a03 = nx * d * weight;
+        q.a11 = ny * ny * weight;
+        q.a12 = ny * nz * weight;
+        q.a13 = ny * d * weight;
+        q.a22 = nz * nz * weight;
+        q.a23 = nz * d * weight;
+        q.a33 = d * d * weight;
+        q.weight = weight;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a00 += o.a00;
+        a01 += o.a01;
+        a02 += o.a02;
+        a03 += o.a03;
+        a11 += o.a11;
+        a12 += o.a12;
+        a13 += o.a13;
+        a22 += o.a22;
+        a23 += o.a23;
+        a33 += o.a33;
+        weight += o.weight;
+        return *this;
+    }
+
+    double Evaluate(const Vec3& p) const {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        const double value = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x + a11 * y * y +
+                             2.0 * a12 * y * z + 2.0 * a13 * y + a22 * z * z + 2.0 * a23 * z + a33;
+        return std::max(value, 0.0);
+    }
+};
+
+struct PositionKey {
+    uint32_t bits[3];
+    bool operator==(const PositionKey& o) const {
+        return bits[0] == o.bits[0] && bits[1] == o.bits[1] && bits[2] == o.bits[2];
+    }
+};
+
+struct PositionKeyHash {
+    std::size_t operator()(const PositionKey& key) const {
+        return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+    }
+};
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    double error;
+};
+
+Vec3 FaceNormal(const Vec3& a, const Vec3& b, const Vec3& c) {
+    return Cross(b - a, c - a);
+}
+
+}  // namespace
+
+std::size_t SimplifyMesh(uint32_t* destination,
+                         const uint32_t* indices,
+                         std::size_t indexCount,
+                         const Vec3* positions,
+                         const Vec3* normals,
+                         std::size_t vertexCount,
+                         std::size_t targetIndexCount,
+                         float targetError,
+                         float* resultError) {
+    const std::size_t triangleCount = indexCount / 3;
+    double maxError = 0.0;
+
+    // Weld vertices by position; `copies` lists the source vertices of each
+    // welded one.
+    std::vector<uint32_t> weldOf(vertexCount);
+    std::vector<uint32_t> copyOffsets;
+    std::vector<uint32_t> copies;
+    std::size_t weldCount = 0;
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> lookup;
+        lookup.reserve(vertexCount);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            PositionKey key;
+            std::memcpy(key.bits, &positions[v], sizeof(key.bits));
+            const auto [it, inserted] = lookup.try_emplace(key, static_cast<uint32_t>(lookup.size()));
+            weldOf[v] = it->second;
+        }
+        weldCount = lookup.size();
+        copyOffsets.assign(weldCount + 1, 0);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            ++copyOffsets[weldOf[v] + 1];
+        }
+        for (std::size_t w = 0; w < weldCount; ++w) {
+            copyOffsets[w + 1] += copyOffsets[w];
+        }
+        copies.resize(vertexCount);
+        std::vector<uint32_t> fill(copyOffsets.begin(), copyOffsets.end() - 1);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            copies[fill[weldOf[v]]++] = static_cast<uint32_t>(v);
+        }
+    }
+    std::vector<Vec3> weldPosition(weldCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        weldPosition[weldOf[v]] = positions[v];
+    }
+
+    // Live triangles keep both their source corners and welded corners.
+    std::vector<uint32_t> corners(indices, indices + triangleCount * 3);
+    std::vector<uint32_t> welded(triangleCount * 3);
+    std::vector<uint8_t> alive(triangleCount, 1);
+    std::size_t liveCount = 0;
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            welded[t * 3 + k] = weldOf[corners[t * 3 + k]];
+        }
+        const uint32_t* w = &welded[t * 3];
+        if (w[0] == w[1] || w[1] == w[2] || w[0] == w[2]) {
+            alive[t] = 0;
+        } else {
+            ++liveCount;
+        }
+    }
+
+    // Area-weighted face quadrics, plus perpendicular planes along borders.
+    std::vector<Quadric> quadrics(weldCount);
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        edgeUse.reserve(liveCount * 3);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) {
+                continue;
+            }
+            const uint32_t* w = &welded[t * 3];
+            const Vec3 n = FaceNormal(weldPosition[w[0]], weldPosition[w[1]], weldPosition[w[2]]);
+            const double doubleArea = Length(n);
+            if (doubleArea > 0.0) {
+                const Vec3 unit = n / static_cast<float>(doubleArea);
+                const double d = -Dot(unit, weldPosition[w[0]]);
+                const Quadric q = Quadric::FromPlane(unit.x, unit.y, unit.z, d, doubleArea * 0.5);
+                for (int k = 0; k < 3; ++k) {
+                    quadrics[w[k]] += q;
+                }
+            }
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t a = std::min(w[k], w[(k + 1) % 3]);
+                const uint32_t b = std::max(w[k], w[(k + 1) % 3]);
+                ++edgeUse[(uint64_t{a} << 32) | b];
+            }
+        }
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) {
+                continue;
+            }
+            const uint32_t* w = &welded[t * 3];
+            const Vec3 n = FaceNormal(weldPosition[w[0]], weldPosition[w[1]], weldPosition[w[2]]);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t a = w[k];
+                const uint32_t b = w[(k + 1) % 3];
+                if (edgeUse[(uint64_t{std::min(a, b)} << 32) | std::max(a, b)] != 1) {
+                    continue;
+                }
+                const Vec3 edge = weldPosition[b] - weldPosition[a];
+                const Vec3 perpendicular = Cross(edge, n);
+                const float length = Length(perpendicular);
+                if (length <= 0.0f) {
+                    continue;
+                }
+                const Vec3 unit = perpendicular / length;
+                const double d = -Dot(unit, weldPosition[a]);
+                const double weight = static_cast<double>(Dot(edge, edge)) * kBorderWeight;
+                const Quadric q = Quadric::FromPlane(unit.x, unit.y, unit.z, d, weight);
+                quadrics[a] += q;
+                quadrics[b] += q;
+            }
+        }
+    }
+
+    const std::size_t targetTriangles = targetIndexCount / 3;
+    const double errorLimit = static_cast<double>(targetError) * targetError;
+    std::vector<uint32_t> adjacencyOffsets(weldCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<uint8_t> touched(weldCount);
+    std::vector<uint32_t> mark(weldCount, 0);
+    uint32_t markStamp = 0;
+    std::vector<Collapse> candidates;
+
+    // Each pass scores every edge once and applies the cheapest collapses that
+    // do not share vertices, which keeps the adjacency valid within a pass.
+    while (liveCount > targetTriangles) {
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            if (alive[t]) {
+                for (int k = 0; k < 3; ++k) {
+                    ++adjacencyOffsets[welded[t * 3 + k] + 1];
+                }
+            }
+        }
+        for (std::size_t w = 0; w < weldCount; ++w) {
+            adjacencyOffsets[w + 1] += adjacencyOffsets[w];
+        }
+        adjacency.resize(adjacencyOffsets[weldCount]);
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (std::size_t t = 0; t < triangleCount; ++t) {
+                if (alive[t]) {
+                    for (int k = 0; k < 3; ++k) {
+                        adjacency[fill[welded[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                    }
+                }
+            }
+        }
+
+        // Interior edges show up once per side; the duplicate is harmless.
+        candidates.clear();
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) {
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t a = welded[t * 3 + k];
+                const uint32_t b = welded[t * 3 + (k + 1) % 3];
+                Quadric combined = quadrics[a];
+                combined += quadrics[b];
+                const double weight = std::max(combined.weight, 1e-30);
+                const double toB = combined.Evaluate(weldPosition[b]) / weight;
+                const double toA = combined.Evaluate(weldPosition[a]) / weight;
+                candidates.push_back(toB <= toA ? Collapse{a, b, toB} : Collapse{b, a, toA});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        std::size_t collapsed = 0;
+        for (const Collapse& c : candidates) {
+            if (liveCount <= targetTriangles || c.error > errorLimit) {
+                break;
+            }
+            if (touched[c.from] || touched[c.to]) {
+                continue;
+            }
+
+            const uint32_t* fromBegin = adjacency.data() + adjacencyOffsets[c.from];
+            const uint32_t* fromEnd = adjacency.data() + adjacencyOffsets[c.from + 1];
+            const uint32_t* toBegin = adjacency.data() + adjacencyOffsets[c.to];
+            const uint32_t* toEnd = adjacency.data() + adjacencyOffsets[c.to + 1];
+
+            // Link condition: the only vertices both ends share must be the
+            // ones opposite the edge, or the collapse pinches the surface.
+            ++markStamp;
+            std::size_t sharedTriangles = 0;
+            for (const uint32_t* t = fromBegin; t != fromEnd; ++t) {
+                const uint32_t* w = &welded[*t * 3];
+                const bool hasTo = w[0] == c.to || w[1] == c.to || w[2] == c.to;
+                sharedTriangles += hasTo ? 1 : 0;
+                for (int k = 0; k < 3; ++k) {
+                    mark[w[k]] = markStamp;
+                }
+            }
+            std::size_t sharedNeighbours = 0;
+            ++markStamp;
+            for (const uint32_t* t = toBegin; t != toEnd; ++t) {
+                for (int k = 0; k < 3; ++k) {
+                    const uint32_t w = welded[*t * 3 + k];
+                    if (mark[w] == markStamp - 1 && w != c.from && w != c.to) {
+                        mark[w] = markStamp;
+                        ++sharedNeighbours;
+                    }
+                }
+            }
+            if (sharedNeighbours != sharedTriangles) {
+                continue;
+            }
+
+            // Reject flips and slivers among the triangles that survive.
+            bool flips = false;
+            for (const uint32_t* t = fromBegin; t != fromEnd && !flips; ++t) {
+                const uint32_t* w = &welded[*t * 3];
+                if (w[0] == c.to || w[1] == c.to || w[2] == c.to) {
+                    continue;
+                }
+                Vec3 p[3];
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = weldPosition[w[k] == c.from ? c.to : w[k]];
+                }
+                const Vec3 before = FaceNormal(weldPosition[w[0]], weldPosition[w[1]], weldPosition[w[2]]);
+                const Vec3 after = FaceNormal(p[0], p[1], p[2]);
+                const double lengths = static_cast<double>(Length(before)) * Length(after);
+                flips = lengths <= 0.0 || Dot(before, after) < kMinNormalCosine * lengths;
+            }
+            if (flips) {
+                continue;
+            }
+
+            // Apply: move every corner of `from` onto a copy of `to`.
+            for (const uint32_t* t = fromBegin; t != fromEnd; ++t) {
+                uint32_t* w = &welded[*t * 3];
+                for (int k = 0; k < 3; ++k) {
+                    if (w[k] != c.from) {
+                        continue;
+                    }
+                    const uint32_t source = corners[*t * 3 + k];
+                    uint32_t best = copies[copyOffsets[c.to]];
+                    if (normals) {
+                        float bestDot = -2.0f;
+                        for (uint32_t i = copyOffsets[c.to]; i < copyOffsets[c.to + 1]; ++i) {
+                            const float d = Dot(normals[copies[i]], normals[source]);
+                            if (d > bestDot) {
+                                bestDot = d;
+                                best = copies[i];
+                            }
+                        }
+                    }
+                    w[k] = c.to;
+                    corners[*t * 3 + k] = best;
+                }
+                if (w[0] == w[1] || w[1] == w[2] || w[0] == w[2]) {
+                    alive[*t] = 0;
+                    --liveCount;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    touched[w[k]] = 1;
+                }
+            }
+            touched[c.from] = 1;
+            touched[c.to] = 1;
+            quadrics[c.to] += quadrics[c.from];
+            maxError = std::max(maxError, c.error);
+            ++collapsed;
+        }
+        if (collapsed == 0) {
+            break;
+        }
+    }
+
+    std::size_t written = 0;
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        if (alive[t]) {
+            destination[written++] = corners[t * 3];
+            destination[written++] = corners[t * 3 + 1];
+            destination[written++] = corners[t * 3 + 2];
+        }
+    }
+    if (resultError) {
+        *resultError = static_cast<float>(std::sqrt(maxError));
+    }
+    return written;
+}
+
+}  // namespace engine
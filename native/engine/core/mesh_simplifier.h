@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "math_types.h"
+
+namespace engine {
+
+// Quadric error metric edge-collapse simplification (Garland & Heckbert) used
+// to build cooked LOD chains. Works on an indexed triangle list without
+// touching the vertex buffer: collapses are half-edge (a vertex moves onto a
+// neighbour), so every LOD of a submesh shares LOD 0's vertices.
+//
+// Vertices with identical positions are welded for the topology, so hard
+// edges split by normals do not crack; a corner that moves picks the copy of
+// the destination vertex whose normal is closest to its own (any copy when
+// `normals` is null). Collapses that flip a triangle, pinch the surface or
+// exceed `targetError` (object-space distance) are rejected; open borders
+// carry heavily weighted planes so they barely move.
+//
+// Writes at most indexCount indices to `destination` (which may not alias
+// `indices`) and returns how many were written; stops once the triangle
+// count reaches targetIndexCount / 3 or no acceptable collapse is left.
+// `resultError` receives the largest error accepted.
+std::size_t SimplifyMesh(uint32_t* destination,
+                         const uint32_t* indices,
+                         std::size_t indexCount,
+                         const Vec3* positions,
+                         const Vec3* normals,
+                         std::size_t vertexCount,
+                         std::size_t targetIndexCount,
+                         float targetError,
+                         float* resultError);
+
+}  // namespace engine
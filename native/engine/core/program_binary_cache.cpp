@@ -0,0 +1,131 @@
+#include "program_binary_cache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "log.h"
+
+namespace engine {
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+
+constexpr uint32_t kMagic = 0x42505743u;  // "CWPB"
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t size;
+    uint64_t checksum;
+};
+
+uint64_t Fnv1a(uint64_t hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// Hashes the terminating zero too, so ("ab", "c") and ("a", "bc") differ.
+uint64_t HashString(uint64_t hash, const char* text) {
+    if (!text) {
+        text = "";
+    }
+    return Fnv1a(hash, text, std::strlen(text) + 1);
+}
+
+}  // namespace
+
+void ProgramBinaryCache::SetDeviceTag(const char* renderer, const char* version) {
+    deviceTag_.assign(renderer ? renderer : "");
+    deviceTag_.push_back('|');
+    deviceTag_.append(version ? version : "");
+}
+
+uint64_t ProgramBinaryCache::KeyFor(const char* vertexSrc, const char* fragmentSrc) const {
+    uint64_t hash = kFnvOffset;
+    hash = HashString(hash, vertexSrc);
+    hash = HashString(hash, fragmentSrc);
+    hash = HashString(hash, deviceTag_.c_str());
+    return hash;
+}
+
+std::string ProgramBinaryCache::PathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(key));
+    return directory_ + name;
+}
+
+bool ProgramBinaryCache::Load(uint64_t key, GLenum* outFormat, std::vector<uint8_t>* outBinary) const {
+    if (!Enabled() || !outFormat || !outBinary) {
+        return false;
+    }
+
+    FILE* file = std::fopen(PathFor(key).c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    FileHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == kMagic &&
+              header.version == kFormatVersion && header.key == key && header.size > 0;
+    if (ok) {
+        outBinary->resize(header.size);
+        ok = std::fread(outBinary->data(), 1, header.size, file) == header.size &&
+             Fnv1a(kFnvOffset, outBinary->data(), header.size) == header.checksum;
+    }
+    std::fclose(file);
+
+    if (!ok) {
+        ENGINE_LOGW(kTag, "Discarding invalid program binary %016llx", static_cast<unsigned long long>(key));
+        Remove(key);
+        outBinary->clear();
+        return false;
+    }
+
+    *outFormat = static_cast<GLenum>(header.binaryFormat);
+    return true;
+}
+
+bool ProgramBinaryCache::Store(uint64_t key, GLenum format, const std::vector<uint8_t>& binary) const {
+    if (!Enabled() || binary.empty()) {
+        return false;
+    }
+
+    // Write to a temporary name and rename so a reader never sees a partial file.
+    const std::string path = PathFor(key);
+    const std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        ENGINE_LOGW(kTag, "Cannot write program binary to %s", tempPath.c_str());
+        return false;
+    }
+
+    const FileHeader header{kMagic, kFormatVersion, key, static_cast<uint32_t>(format),
+                            static_cast<uint32_t>(binary.size()), Fnv1a(kFnvOffset, binary.data(), binary.size())};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(binary.data(), 1, binary.size(), file) == binary.size();
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ENGINE_LOGW(kTag, "Failed to store program binary %s", path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ProgramBinaryCache::Remove(uint64_t key) const {
+    if (Enabled()) {
+        std::remove(PathFor(key).c_str());
+    }
+}
+
+}  // namespace engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+// On-disk cache of linked program binaries (glGetProgramBinary). Entries are
+// keyed by a hash of the shader sources plus the GL renderer/version strings,
+// so a driver update or a different GPU never sees a stale binary. Each file
+// carries a payload checksum; anything truncated or corrupt is treated as a
+// miss. Disabled until a directory is set.
+class ProgramBinaryCache {
+public:
+    // The directory must already exist. An empty path disables the cache.
+    void SetDirectory(std::string directory) { directory_ = std::move(directory); }
+    bool Enabled() const { return !directory_.empty(); }
+
+    // Call with the current context's GL_RENDERER / GL_VERSION strings.
+    void SetDeviceTag(const char* renderer, const char* version);
+
+    uint64_t KeyFor(const char* vertexSrc, const char* fragmentSrc) const;
+
+    bool Load(uint64_t key, GLenum* outFormat, std::vector<uint8_t>* outBinary) const;
+    bool Store(uint64_t key, GLenum format, const std::vector<uint8_t>& binary) const;
+    void Remove(uint64_t key) const;
+
+private:
+    std::string PathFor(uint64_t key) const;
+
+    std::string directory_;
+    std::string deviceTag_;
+};
+
+}  // namespace engine
@@ -0,0 +1,87 @@
+#include "render_target.h"
+
+#include "gl_state_cache.h"
+#include "log.h"
+
+namespace engine {
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+}  // namespace
+
+RenderTarget::~RenderTarget() {
+    Destroy();
+}
+
+bool RenderTarget::Resize(int width, int height) {
+    if (framebuffer_ != 0 && width == width_ && height == height_) {
+        return true;
+    }
+    Destroy();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    glGenRenderbuffers(1, &color_);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &depth_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GlStateCache& state = GlStateCache::Current();
+    glGenFramebuffers(1, &framebuffer_);
+    state.BindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        ENGINE_LOGE(kTag, "Render target %dx%d incomplete (0x%x)", width, height, status);
+        Destroy();
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+void RenderTarget::Destroy() {
+    if (framebuffer_ != 0) {
+        GlStateCache::Current().DeleteFramebuffers(1, &framebuffer_);
+        framebuffer_ = 0;
+    }
+    const GLuint renderbuffers[] = {color_, depth_};
+    if (color_ != 0 || depth_ != 0) {
+        glDeleteRenderbuffers(2, renderbuffers);
+    }
+    color_ = 0;
+    depth_ = 0;
+    width_ = 0;
+    height_ = 0;
+}
+
+void RenderTarget::Bind() const {
+    GlStateCache::Current().BindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+}
+
+void RenderTarget::BlitToWindow(int windowWidth, int windowHeight) const {
+    GlStateCache& state = GlStateCache::Current();
+    state.BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_);
+    state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+    // On tilers this saves writing depth back and loading the window's
+    // previous frame.
+    const GLenum sceneDepth[] = {GL_DEPTH_ATTACHMENT};
+    glInvalidateFramebuffer(GL_READ_FRAMEBUFFER, 1, sceneDepth);
+    const GLenum window[] = {GL_COLOR, GL_DEPTH};
+    glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, 2, window);
+
+    // Blits are clipped by the scissor test.
+    state.SetEnabled(GL_SCISSOR_TEST, false);
+    glBlitFramebuffer(0, 0, width_, height_, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+}
+
+}  // namespace engine
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+namespace engine {
+
+// Offscreen colour + depth framebuffer for rendering the scene below the
+// window's resolution, then upscaling it into the window in one blit.
+//
+// The storage is exactly the render size. Drawing into a corner of a larger
+// one would avoid reallocating on a scale change, but the filtered blit
+// would then bleed stale texels in along the edges; a blit clamps at the
+// buffer's own edges only.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // (Re)allocates when the size changes. Returns false if the framebuffer
+    // is incomplete; the target is then empty.
+    bool Resize(int width, int height);
+    // Deletes the GL objects; safe without a context (names are forgotten).
+    void Destroy();
+
+    void Bind() const;
+    // Scales the target over the whole default framebuffer (windowWidth x
+    // windowHeight), filtered. Depth is discarded, and so is the window's
+    // old content, which the blit covers.
+    void BlitToWindow(int windowWidth, int windowHeight) const;
+
+    bool IsValid() const { return framebuffer_ != 0; }
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+private:
+    GLuint framebuffer_{0};
+    GLuint color_{0};
+    GLuint depth_{0};
+    int width_{0};
+    int height_{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,530 @@
+#include "scene_renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "gl_state_cache.h"
+#include "lod_selector.h"
+#include "log.h"
+#include "trace.h"
+
+namespace engine {
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+constexpr float kMajorStep = 1.0f;
+constexpr float kMinorStep = 0.1f;
+constexpr float kPlaneExtent = 200.0f;
+
+// GL upload work allowed per frame. Copies go in GpuModel::kChunkBytes
+// slices, and the time limit stops early on drivers that copy slowly.
+constexpr std::size_t kUploadBudgetBytes = 1024 * 1024;
+constexpr int64_t kUploadBudgetNanos = 2'000'000;
+// Streamed models are scaled so their largest side spans this many grid
+// units, centred on the origin and resting on the grid.
+constexpr float kModelFitSize = 4.0f;
+constexpr float kLodErrorPixels = 1.0f;
+constexpr float kDefaultBaseColor[4] = {0.72f, 0.74f, 0.78f, 1.0f};
+
+int64_t NowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+const char* kVertexShaderSrc = R"(
+#version 300 es
+layout(location = 0) in vec3 aPosition;
+layout(std140) uniform FrameUniforms {
+    highp mat4 uViewProj;
+    highp vec4 uCameraPos;
+};
+layout(std140) uniform ObjectUniforms {
+    highp mat4 uModel;
+};
+uniform float uExtent;
+out vec3 vWorldPos;
+out vec3 vLocalPos;
+void main() {
+    vec4 world = uModel * vec4(aPosition.x * uExtent, aPosition.y, aPosition.z * uExtent, 1.0);
+    vWorldPos = world.xyz;
+    vLocalPos = aPosition;
+    gl_Position = uViewProj * world;
+}
+)";
+
+const char* kFragmentShaderSrc = R"(
+#version 300 es
+precision mediump float;
+in vec3 vWorldPos;
+in vec3 vLocalPos;
+uniform float uMajorStep;
+uniform float uMinorStep;
+out vec4 fragColor;
+
+float gridLine(float coord, float stepSize) {
+    float coordScaled = coord / stepSize;
+    float derivative = fwidth(coordScaled);
+    float line = abs(fract(coordScaled - 0.5) - 0.5) / max(derivative, 1e-4);
+    return 1.0 - clamp(line, 0.0, 1.0);
+}
+
+void main() {
+    float minor = max(gridLine(vWorldPos.x, uMinorStep), gridLine(vWorldPos.z, uMinorStep));
+    float major = max(gridLine(vWorldPos.x, uMajorStep), gridLine(vWorldPos.z, uMajorStep));
+
+    vec3 baseColor = vec3(0.04, 0.05, 0.07);
+    vec3 minorColor = vec3(0.10, 0.12, 0.18);
+    vec3 majorColor = vec3(0.35, 0.40, 0.55);
+
+    float blend = max(minor * 0.6, major);
+    vec3 color = mix(baseColor, minorColor, minor * 0.7);
+    color = mix(color, majorColor, major);
+
+    float fade = clamp(1.0 - length(vLocalPos.xz) * 0.5, 0.0, 1.0);
+    color *= fade + 0.2;
+
+    fragColor = vec4(color, 1.0);
+}
+)";
+
+const char* kMeshVertexShaderSrc = R"(
+#version 300 es
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aNormal;
+layout(location = 2) in mat4 aModel;  // Per instance, from DrawList.
+layout(std140) uniform FrameUniforms {
+    highp mat4 uViewProj;
+    highp vec4 uCameraPos;
+};
+layout(std140) uniform ObjectUniforms {
+    highp vec4 uPosMin;
+    highp vec4 uPosExtent;
+    highp vec4 uBaseColor;
+};
+out vec3 vWorldPos;
+out vec3 vNormal;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main() {
+    vec4 world = aModel * vec4(uPosMin.xyz + aPosition * uPosExtent.xyz, 1.0);
+    vWorldPos = world.xyz;
+    vNormal = mat3(aModel) * decodeOctahedral(aNormal);
+    gl_Position = uViewProj * world;
+}
+)";
+
+const char* kMeshFragmentShaderSrc = R"(
+#version 300 es
+precision mediump float;
+in vec3 vWorldPos;
+in vec3 vNormal;
+layout(std140) uniform FrameUniforms {
+    highp mat4 uViewProj;
+    highp vec4 uCameraPos;
+};
+layout(std140) uniform ObjectUniforms {
+    highp vec4 uPosMin;
+    highp vec4 uPosExtent;
+    highp vec4 uBaseColor;
+};
+out vec4 fragColor;
+
+void main() {
+    vec3 n = normalize(vNormal);
+    vec3 toEye = normalize(uCameraPos.xyz - vWorldPos);
+    float headlight = abs(dot(n, toEye));
+    float sky = 0.5 + 0.5 * n.y;
+    vec3 color = uBaseColor.rgb * (0.15 + 0.2 * sky + 0.65 * headlight);
+    fragColor = vec4(color, uBaseColor.a);
+}
+)";
+
+// std140 mirrors of the shaders' uniform blocks, written through the uniform ring.
+constexpr GLuint kFrameBlockBinding = 0;
+constexpr GLuint kObjectBlockBinding = 1;
+// Initial ring segment; it grows when a frame has more batches.
+constexpr std::size_t kUniformRingBytes = 16 * 1024;
+
+struct FrameBlock {
+    Mat4 viewProj;
+    float cameraPos[4];
+};
+
+struct GridBlock {
+    Mat4 model;
+};
+
+struct MeshBlock {
+    float posMin[4];
+    float posExtent[4];
+    float baseColor[4];
+};
+
+void BindUniformBlock(GLuint program, const char* name, GLuint binding) {
+    const GLuint index = glGetUniformBlockIndex(program, name);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, binding);
+    }
+}
+
+template <typename Block>
+GLintptr WriteUniformBlock(UniformRing& ring, const Block& block) {
+    GLintptr offset = 0;
+    if (void* destination = ring.Allocate(sizeof(Block), &offset)) {
+        std::memcpy(destination, &block, sizeof(Block));
+    }
+    return offset;
+}
+
+// Scales and moves a model so it sits on the grid at the origin.
+Mat4 FitToGrid(const Vec3& boundsMin, const Vec3& boundsMax) {
+    const Vec3 size = boundsMax - boundsMin;
+    const float largest = std::max({size.x, size.y, size.z});
+    const float scale = largest > 0.0f ? kModelFitSize / largest : 1.0f;
+    Mat4 fit = Mat4::Identity();
+    fit.data[0] = scale;
+    fit.data[5] = scale;
+    fit.data[10] = scale;
+    fit.data[12] = -(boundsMin.x + size.x * 0.5f) * scale;
+    fit.data[13] = -boundsMin.y * scale;
+    fit.data[14] = -(boundsMin.z + size.z * 0.5f) * scale;
+    return fit;
+}
+
+}  // namespace
+
+bool SceneRenderer::InitializeGl(ProgramBinaryCache* cache, FrameDiagnostics* stats) {
+    // The context may be new; nothing the state cache remembers can be trusted.
+    GlStateCache::Current().Invalidate();
+    shader_.Destroy();
+    meshShader_.Destroy();
+    gridPlane_.Destroy();
+
+    if (!shader_.Compile(kVertexShaderSrc, kFragmentShaderSrc, cache) ||
+        !meshShader_.Compile(kMeshVertexShaderSrc, kMeshFragmentShaderSrc, cache)) {
+        ENGINE_LOGE(kTag, "Failed to compile shader program");
+        return false;
+    }
+    const int cached = (shader_.LoadedFromCache() ? 1 : 0) + (meshShader_.LoadedFromCache() ? 1 : 0);
+    stats->shaderCacheHits = cached;
+    stats->shaderCacheMisses = 2 - cached;
+    stats->shaderBuildMs = shader_.BuildTimeMs() + meshShader_.BuildTimeMs();
+    ENGINE_LOGI(kTag, "Shader programs built in %.2f ms (%d of 2 from cache)", stats->shaderBuildMs, cached);
+
+    // Block bindings are not part of a cached binary; set them every time.
+    for (const GLuint program : {shader_.Id(), meshShader_.Id()}) {
+        BindUniformBlock(program, "FrameUniforms", kFrameBlockBinding);
+        BindUniformBlock(program, "ObjectUniforms", kObjectBlockBinding);
+    }
+    if (!uniformRing_.Initialize(kUniformRingBytes)) {
+        ENGINE_LOGE(kTag, "Failed to create the uniform ring");
+        return false;
+    }
+
+    GLint extentLocation = glGetUniformLocation(shader_.Id(), "uExtent");
+    GLint majorLocation = glGetUniformLocation(shader_.Id(), "uMajorStep");
+    GLint minorLocation = glGetUniformLocation(shader_.Id(), "uMinorStep");
+
+    gridPlane_.Initialize();
+
+    GlStateCache::Current().UseProgram(shader_.Id());
+    glUniform1f(extentLocation, kPlaneExtent);
+    glUniform1f(majorLocation, kMajorStep);
+    glUniform1f(minorLocation, kMinorStep);
+
+    glReady_ = true;
+    return true;
+}
+
+void SceneRenderer::DestroyGl() {
+    // With the context current on this thread the GL names are deleted;
+    // otherwise the wrappers just forget them (the context is going away).
+    shader_.Destroy();
+    meshShader_.Destroy();
+    gridPlane_.Destroy();
+    drawList_.Destroy();
+    uniformRing_.Destroy();
+    sceneTarget_.Destroy();
+    for (ModelSlot& slot : models_) {
+        // Buffers die with the context; decode again for the next one.
+        // Requests still in flight keep their id and upload when they land.
+        if (slot.gpu) {
+            slot.gpu.reset();
+            slot.requestId = 0;
+        }
+    }
+    glReady_ = false;
+}
+
+void SceneRenderer::AddModel(std::string path, AssetReader reader) {
+    ModelSlot slot;
+    slot.path = std::move(path);
+    slot.reader = std::move(reader);
+    models_.push_back(std::move(slot));
+    // Requested from BeginFrame with the next frame.
+}
+
+void SceneRenderer::BeginFrame(FrameDiagnostics* stats) {
+    ENGINE_TRACE_SCOPE("BeginFrame");
+    GlStateCache::Current().ResetCounters();
+
+    std::vector<std::unique_ptr<DecodedModel>> completed;
+    streamer_.TakeCompleted(&completed);
+    for (auto& decoded : completed) {
+        auto slot = std::find_if(models_.begin(), models_.end(),
+                                 [&](const ModelSlot& s) { return s.requestId == decoded->id; });
+        if (slot == models_.end()) {
+            continue;  // Superseded by a newer request.
+        }
+        if (!decoded->ok) {
+            ENGINE_LOGE(kTag, "Failed to load %s: %s", slot->path.c_str(), decoded->error.c_str());
+            continue;
+        }
+        ENGINE_LOGI(kTag, "Decoded %s: read %.1f ms, %s %.1f ms (worker)", slot->path.c_str(), decoded->readMs,
+                    decoded->cached ? "cache hit" : "decode", decoded->decodeMs);
+        slot->gpu = std::make_unique<GpuModel>(std::move(decoded));
+        slot->uploadFrames = 0;
+    }
+
+    // Upload in budgeted slices so no frame absorbs a whole model.
+    ENGINE_TRACE_SCOPE("UploadModels");
+    const int64_t uploadStart = NowNanos();
+    std::size_t uploaded = 0;
+    int pending = static_cast<int>(streamer_.InFlight());
+    for (ModelSlot& slot : models_) {
+        if (slot.requestId == 0) {
+            slot.requestId = streamer_.Request(slot.path, slot.reader);
+            slot.requestNanos = NowNanos();
+            ++pending;
+            continue;
+        }
+        if (!slot.gpu || slot.gpu->Ready()) {
+            continue;
+        }
+        ++slot.uploadFrames;
+        while (!slot.gpu->Ready() && uploaded < kUploadBudgetBytes && NowNanos() - uploadStart < kUploadBudgetNanos) {
+            uploaded += slot.gpu->Upload(kUploadBudgetBytes - uploaded);
+        }
+        if (slot.gpu->Ready()) {
+            ENGINE_LOGI(kTag, "%s visible %.1f ms after request (%d upload frames)", slot.path.c_str(),
+                        static_cast<float>(NowNanos() - slot.requestNanos) / 1'000'000.0f, slot.uploadFrames);
+        } else {
+            ++pending;
+        }
+    }
+    stats->assetsPending = pending;
+    stats->uploadMs = static_cast<float>(NowNanos() - uploadStart) / 1'000'000.0f;
+    ENGINE_TRACE_COUNTER("assetsPending", pending);
+}
+
+void SceneRenderer::Render(const OrbitCamera& camera, int width, int height, FrameDiagnostics* stats) {
+    ENGINE_TRACE_SCOPE("Render");
+    GlStateCache& state = GlStateCache::Current();
+
+    // Below full scale the scene is drawn into sceneTarget_ and upscaled into
+    // the window after the last pass. The target is reallocated only when
+    // the scale or the surface changes, and freed at full scale.
+    const float renderScale = fixedScale_ > 0.0f ? fixedScale_ : resolution_.Scale();
+    int renderWidth = width;
+    int renderHeight = height;
+    bool scaled = false;
+    if (renderScale < 1.0f) {
+        renderWidth = std::max(1, static_cast<int>(std::lround(width * renderScale)));
+        renderHeight = std::max(1, static_cast<int>(std::lround(height * renderScale)));
+        scaled = sceneTarget_.Resize(renderWidth, renderHeight);
+    }
+    if (scaled) {
+        sceneTarget_.Bind();
+    } else {
+        sceneTarget_.Destroy();
+        renderWidth = width;
+        renderHeight = height;
+        state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // Usually all elided; they only reach GL after a resize, a render scale
+    // change or a new context.
+    state.Viewport(0, 0, renderWidth, renderHeight);
+    state.SetEnabled(GL_DEPTH_TEST, true);
+    state.ClearColor(0.04f, 0.05f, 0.07f, 1.0f);
+    state.DepthMask(true);  // Also gates the depth clear.
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Opaque parts first so the grid behind them is depth-rejected, then
+    // translucent parts over both.
+    stats->trianglesSubmitted = 0;
+    stats->drawCalls = 0;
+    stats->instancesCulled = static_cast<int32_t>(CollectModelDraws(camera));
+    stats->trianglesSubmitted += static_cast<int32_t>(drawList_.TriangleCount());
+    WriteFrameUniforms(camera);
+
+    stats->drawCalls += DrawModels(DrawPass::kOpaque);
+
+    state.UseProgram(shader_.Id());
+    uniformRing_.Bind(kObjectBlockBinding, gridUniforms_, sizeof(GridBlock));
+    gridPlane_.Draw();
+    stats->trianglesSubmitted += GridPlane::kTriangleCount;
+    ++stats->drawCalls;
+
+    stats->drawCalls += DrawModels(DrawPass::kTranslucent);
+    uniformRing_.EndFrame();
+    if (scaled) {
+        ENGINE_TRACE_SCOPE("BlitToWindow");
+        sceneTarget_.BlitToWindow(width, height);
+    }
+    const GlStateCache::Counters stateCalls = state.GetCounters();
+    stats->glStateIssued = static_cast<int32_t>(stateCalls.issued);
+    stats->glStateElided = static_cast<int32_t>(stateCalls.elided);
+    stats->renderScale = scaled ? renderScale : 1.0f;
+    ENGINE_TRACE_COUNTER("drawCalls", stats->drawCalls);
+    ENGINE_TRACE_COUNTER("instancesCulled", stats->instancesCulled);
+    ENGINE_TRACE_COUNTER("renderScale", stats->renderScale);
+}
+
+void SceneRenderer::UpdateResolution(float frameMs, float budgetMs) {
+    resolution_.Update(frameMs, budgetMs);
+}
+
+std::size_t SceneRenderer::CollectModelDraws(const OrbitCamera& camera) {
+    ENGINE_TRACE_SCOPE("CollectModelDraws");
+    // Per-submesh uniforms the batches point at. Sized before any pointer
+    // into it is taken.
+    std::size_t submeshCount = 0;
+    for (const ModelSlot& slot : models_) {
+        if (slot.gpu && slot.gpu->Ready()) {
+            submeshCount += slot.gpu->Submeshes().size();
+        }
+    }
+    meshStates_.resize(submeshCount);
+
+    // Place every instance and bound it with its submesh's sphere.
+    instanceDraws_.clear();
+    std::size_t stateBase = 0;
+    for (const ModelSlot& slot : models_) {
+        if (!slot.gpu || !slot.gpu->Ready()) {
+            continue;
+        }
+        const GpuModel& gpu = *slot.gpu;
+        for (std::size_t i = 0; i < gpu.Submeshes().size(); ++i) {
+            const cooked::Submesh& submesh = gpu.Submeshes()[i];
+            meshStates_[stateBase + i] = MeshState{
+                submesh.posMin, submesh.posExtent,
+                submesh.material >= 0 ? gpu.Materials()[submesh.material].baseColor : kDefaultBaseColor};
+        }
+
+        const Mat4 fit = FitToGrid(gpu.BoundsMin(), gpu.BoundsMax());
+        for (const cooked::Instance& instance : gpu.Instances()) {
+            Mat4 local;
+            std::copy(std::begin(instance.world), std::end(instance.world), local.data.begin());
+            instanceDraws_.push_back(InstanceDraw{&gpu, &instance, stateBase, Multiply(fit, local)});
+        }
+        stateBase += gpu.Submeshes().size();
+    }
+
+    instanceSpheres_.Resize(instanceDraws_.size());
+    for (std::size_t i = 0; i < instanceDraws_.size(); ++i) {
+        const InstanceDraw& draw = instanceDraws_[i];
+        const cooked::Submesh& submesh = draw.gpu->Submeshes()[draw.instance->submesh];
+        const Vec4 center = Multiply(draw.world, Vec4(submesh.sphereCenter[0], submesh.sphereCenter[1],
+                                                      submesh.sphereCenter[2], 1.0f));
+        instanceSpheres_.Set(i, Vec3(center.x, center.y, center.z),
+                             submesh.sphereRadius * MaxAxisScale(draw.world));
+    }
+    visibleInstances_.resize(instanceDraws_.size());
+    const std::size_t visibleCount = CullSpheres(camera.FrustumPlanes(), instanceSpheres_, visibleInstances_.data());
+
+    drawList_.Clear();
+    const LodView lodView = MakeLodView(camera, kLodErrorPixels);
+    const Mat4& view = camera.ViewMatrix();
+    for (std::size_t v = 0; v < visibleCount; ++v) {
+        const InstanceDraw& draw = instanceDraws_[visibleInstances_[v]];
+        const GpuModel& gpu = *draw.gpu;
+        const uint32_t submeshIndex = draw.instance->submesh;
+        const cooked::Submesh& submesh = gpu.Submeshes()[submeshIndex];
+
+        const cooked::Lod& lod = submesh.lods[SelectLod(submesh, draw.world, lodView)];
+        const DrawKey key{meshShader_.Id(), gpu.VertexArray(submeshIndex), submesh.material,
+                          submesh.indexType, lod.indexOffset, lod.indexCount};
+        const MeshState& meshState = meshStates_[draw.stateBase + submeshIndex];
+        // Sorted by the depth of the submesh's bounds centre.
+        const Vec4 center = Multiply(view, Multiply(draw.world, Vec4(submesh.posMin[0] + submesh.posExtent[0] * 0.5f,
+                                                                     submesh.posMin[1] + submesh.posExtent[1] * 0.5f,
+                                                                     submesh.posMin[2] + submesh.posExtent[2] * 0.5f,
+                                                                     1.0f)));
+        const DrawPass pass = meshState.baseColor[3] < 1.0f ? DrawPass::kTranslucent : DrawPass::kOpaque;
+        drawList_.Add(key, draw.world, &meshState, pass, -center.z);
+    }
+    drawList_.Build();
+    return instanceDraws_.size() - visibleCount;
+}
+
+void SceneRenderer::WriteFrameUniforms(const OrbitCamera& camera) {
+    ENGINE_TRACE_SCOPE("WriteFrameUniforms");
+    // Everything the frame binds is written in one pass over one mapped
+    // segment, before the first draw.
+    const std::vector<DrawBatch>& batches = drawList_.Batches();
+    const std::size_t bytes = uniformRing_.AlignedSize(sizeof(FrameBlock)) +
+                              uniformRing_.AlignedSize(sizeof(GridBlock)) +
+                              batches.size() * uniformRing_.AlignedSize(sizeof(MeshBlock));
+    uniformRing_.BeginFrame(bytes);
+
+    FrameBlock frame{};
+    frame.viewProj = camera.ViewProjectionMatrix();
+    const Vec3& eye = camera.EyePosition();
+    frame.cameraPos[0] = eye.x;
+    frame.cameraPos[1] = eye.y;
+    frame.cameraPos[2] = eye.z;
+    const GLintptr frameUniforms = WriteUniformBlock(uniformRing_, frame);
+    gridUniforms_ = WriteUniformBlock(uniformRing_, GridBlock{Mat4::Identity()});
+
+    batchUniforms_.resize(batches.size());
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+        const auto* state = static_cast<const MeshState*>(batches[i].state);
+        MeshBlock block{};
+        std::copy(state->posMin, state->posMin + 3, block.posMin);
+        std::copy(state->posExtent, state->posExtent + 3, block.posExtent);
+        std::copy(state->baseColor, state->baseColor + 4, block.baseColor);
+        batchUniforms_[i] = WriteUniformBlock(uniformRing_, block);
+    }
+
+    uniformRing_.Flush();
+    uniformRing_.Bind(kFrameBlockBinding, frameUniforms, sizeof(FrameBlock));
+}
+
+int SceneRenderer::DrawModels(DrawPass pass) {
+    ENGINE_TRACE_SCOPE(pass == DrawPass::kOpaque ? "DrawOpaque" : "DrawTranslucent");
+    // Batches are ordered by pass, so the last one tells whether there is
+    // anything translucent.
+    const std::vector<DrawBatch>& batches = drawList_.Batches();
+    if (batches.empty() || batches.front().pass > pass || batches.back().pass < pass) {
+        return 0;
+    }
+    GlStateCache& state = GlStateCache::Current();
+    if (pass == DrawPass::kTranslucent) {
+        // Sorted back to front; blended over what is behind without hiding it.
+        state.SetEnabled(GL_BLEND, true);
+        state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.DepthMask(false);
+    } else {
+        state.SetEnabled(GL_BLEND, false);
+        state.DepthMask(true);
+    }
+
+    // Instances sharing program, VAO, LOD and material go out as one draw;
+    // per batch only the object block offset changes.
+    const DrawBatch* firstBatch = batches.data();
+    return drawList_.Submit(pass, [this, firstBatch](const DrawBatch& batch) {
+        uniformRing_.Bind(kObjectBlockBinding, batchUniforms_[&batch - firstBatch], sizeof(MeshBlock));
+    });
+}
+
+}  // namespace engine
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "asset_streamer.h"
+#include "camera.h"
+#include "culling.h"
+#include "diagnostics.h"
+#include "draw_list.h"
+#include "dynamic_resolution.h"
+#include "gpu_model.h"
+#include "grid_plane.h"
+#include "program_binary_cache.h"
+#include "render_target.h"
+#include "shader_program.h"
+#include "uniform_ring.h"
+
+namespace engine {
+
+// The scene and how a frame of it is drawn: the grid, streamed models, the
+// draw list, the uniform ring and dynamic resolution. Platform code owns the
+// context, the surface, input and frame timing, and calls this on the thread
+// the context is current on; EngineRenderer on Android, engine_headless on
+// Linux.
+class SceneRenderer {
+public:
+    SceneRenderer() = default;
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+    // Builds programs (through `cache` when set), the uniform ring and the
+    // grid in the current context. Fills the shader fields of `stats`.
+    bool InitializeGl(ProgramBinaryCache* cache, FrameDiagnostics* stats);
+    // Deletes the GL objects, or forgets them without a context. Models are
+    // decoded again for the next one.
+    void DestroyGl();
+    bool GlReady() const { return glReady_; }
+
+    // Streams a model in the background; it is drawn once uploaded.
+    void AddModel(std::string path, AssetReader reader);
+    // Locks internally; may be opened while workers decode.
+    AssetCache& Cache() { return streamer_.Cache(); }
+
+    // Start of a frame: resets the GL state counters, takes decoded models
+    // and uploads within the per-frame budget. Fills assetsPending and
+    // uploadMs.
+    void BeginFrame(FrameDiagnostics* stats);
+    // Draws the frame over the whole default framebuffer (width x height),
+    // through the scaled target below full scale. Fills the draw, triangle,
+    // GL state and render scale fields. Does not swap.
+    void Render(const OrbitCamera& camera, int width, int height, FrameDiagnostics* stats);
+    // Feeds the frame's cost, up to the queued swap, to dynamic resolution.
+    void UpdateResolution(float frameMs, float budgetMs);
+    // Pins the render scale (e.g. for repeatable benchmarks); 0 follows the
+    // frame budget again.
+    void SetFixedRenderScale(float scale) { fixedScale_ = scale; }
+
+private:
+    // Returns the number of instances left out by frustum culling.
+    std::size_t CollectModelDraws(const OrbitCamera& camera);
+    void WriteFrameUniforms(const OrbitCamera& camera);
+    int DrawModels(DrawPass pass);
+
+    bool glReady_{false};
+    ShaderProgram shader_{};
+    ShaderProgram meshShader_{};
+    GridPlane gridPlane_{};
+
+    // Per-submesh uniform values for the current frame's batches.
+    struct MeshState {
+        const float* posMin{nullptr};
+        const float* posExtent{nullptr};
+        const float* baseColor{nullptr};
+    };
+    std::vector<MeshState> meshStates_;
+    DrawList drawList_{};
+
+    // Every ready instance of the frame with its world bounding sphere; only
+    // those CullSpheres reports as visible reach LOD selection and drawList_.
+    struct InstanceDraw {
+        const GpuModel* gpu{nullptr};
+        const cooked::Instance* instance{nullptr};
+        std::size_t stateBase{0};
+        Mat4 world{};
+    };
+    std::vector<InstanceDraw> instanceDraws_;
+    BoundingSphereSoA instanceSpheres_{};
+    std::vector<uint32_t> visibleInstances_;
+
+    // All uniforms of a frame are written once into the ring and bound by
+    // offset: the frame block for every program, then one object block for
+    // the grid and one per draw batch.
+    UniformRing uniformRing_{};
+    GLintptr gridUniforms_{0};
+    std::vector<GLintptr> batchUniforms_;
+
+    // The scene resolution follows the measured frame cost; below full scale
+    // it is rendered into sceneTarget_ and blitted up to the window.
+    DynamicResolution resolution_{};
+    RenderTarget sceneTarget_{};
+    float fixedScale_{0.0f};
+
+    // requestId is the streamer request whose result belongs in `gpu`; 0
+    // means the model must be (re)requested, e.g. after a lost context.
+    struct ModelSlot {
+        std::string path;
+        AssetReader reader;
+        uint64_t requestId{0};
+        std::unique_ptr<GpuModel> gpu;
+        int64_t requestNanos{0};
+        int uploadFrames{0};
+    };
+    std::vector<ModelSlot> models_;
+
+    // Decoding runs on the streamer's workers. Declared last so they are
+    // joined before anything else is torn down.
+    AssetStreamer streamer_{};
+};
+
+}  // namespace engine
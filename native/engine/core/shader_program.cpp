@@ -1,6 +1,12 @@
 #include "shader_program.h"
 
-#include <android/log.h>
+#include <chrono>
+#include <vector>
+
+#include "gl_state_cache.h"
+#include "log.h"
+#include "program_binary_cache.h"
+#include "trace.h"
 
 namespace engine {
 
@@ -12,9 +18,33 @@ ShaderProgram::~ShaderProgram() {
     Destroy();
 }
 
-bool ShaderProgram::Compile(const char* vertexSrc, const char* fragmentSrc) {
+bool ShaderProgram::Compile(const char* vertexSrc, const char* fragmentSrc, ProgramBinaryCache* cache) {
+    ENGINE_TRACE_SCOPE("CompileProgram");
     Destroy();
 
+    const auto start = std::chrono::steady_clock::now();
+    GLint binaryFormats = 0;
+    if (cache && cache->Enabled()) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    const bool useCache = binaryFormats > 0;
+    const uint64_t key = useCache ? cache->KeyFor(vertexSrc, fragmentSrc) : 0;
+
+    loadedFromCache_ = useCache && LoadBinary(*cache, key);
+    if (!loadedFromCache_) {
+        if (!LinkFromSource(vertexSrc, fragmentSrc, useCache)) {
+            return false;
+        }
+        if (useCache) {
+            StoreBinary(*cache, key);
+        }
+    }
+
+    buildTimeMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool ShaderProgram::LinkFromSource(const char* vertexSrc, const char* fragmentSrc, bool retrievable) {
     const GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSrc);
     if (!vertexShader) {
         return false;
@@ -27,6 +57,9 @@ bool ShaderProgram::Compile(const char* vertexSrc, const char* fragmentSrc) {
     }
 
     program_ = glCreateProgram();
+    if (retrievable) {
+        glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(program_, vertexShader);
     glAttachShader(program_, fragmentShader);
     glLinkProgram(program_);
@@ -39,7 +72,7 @@ bool ShaderProgram::Compile(const char* vertexSrc, const char* fragmentSrc) {
         std::string log;
         log.resize(static_cast<std::size_t>(logLength));
         glGetProgramInfoLog(program_, logLength, nullptr, log.data());
-        __android_log_print(ANDROID_LOG_ERROR, kTag, "Program link failed: %s", log.c_str());
+        ENGINE_LOGE(kTag, "Program link failed: %s", log.c_str());
 
         glDeleteProgram(program_);
         program_ = 0;
@@ -56,9 +89,51 @@ bool ShaderProgram::Compile(const char* vertexSrc, const char* fragmentSrc) {
     return true;
 }
 
+bool ShaderProgram::LoadBinary(const ProgramBinaryCache& cache, uint64_t key) {
+    GLenum format = 0;
+    std::vector<uint8_t> binary;
+    if (!cache.Load(key, &format, &binary)) {
+        return false;
+    }
+
+    program_ = glCreateProgram();
+    glProgramBinary(program_, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint status = 0;
+    glGetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        // Drivers may reject binaries after an update even when the version
+        // string is unchanged; drop the entry and fall back to source.
+        ENGINE_LOGW(kTag, "Cached program binary rejected; recompiling");
+        glDeleteProgram(program_);
+        program_ = 0;
+        cache.Remove(key);
+        return false;
+    }
+    return true;
+}
+
+void ShaderProgram::StoreBinary(const ProgramBinaryCache& cache, uint64_t key) const {
+    GLint length = 0;
+    glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<uint8_t> binary(static_cast<std::size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program_, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+    binary.resize(static_cast<std::size_t>(written));
+    cache.Store(key, format, binary);
+}
+
 void ShaderProgram::Destroy() {
     if (program_ != 0) {
-        glDeleteProgram(program_);
+        GlStateCache::Current().DeleteProgram(program_);
         program_ = 0;
     }
 }
@@ -76,7 +151,7 @@ GLuint ShaderProgram::CompileShader(GLenum type, const char* source) {
         std::string log;
         log.resize(static_cast<std::size_t>(logLength));
         glGetShaderInfoLog(shader, logLength, nullptr, log.data());
-        __android_log_print(ANDROID_LOG_ERROR, kTag, "Shader compile failed: %s", log.c_str());
+        ENGINE_LOGE(kTag, "Shader compile failed: %s", log.c_str());
         glDeleteShader(shader);
         return 0;
     }
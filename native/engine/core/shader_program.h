@@ -1,24 +1,39 @@
 #pragma once
 
 #include <GLES3/gl3.h>
+#include <cstdint>
 #include <string>
 
 namespace engine {
 
+class ProgramBinaryCache;
+
 class ShaderProgram {
 public:
     ShaderProgram() = default;
     ~ShaderProgram();
 
-    bool Compile(const char* vertexSrc, const char* fragmentSrc);
+    // With a cache, a stored binary for the same sources and driver is tried
+    // first; if the driver rejects it the program is compiled from source and
+    // the cache entry replaced.
+    bool Compile(const char* vertexSrc, const char* fragmentSrc, ProgramBinaryCache* cache = nullptr);
     void Destroy();
 
     GLuint Id() const { return program_; }
 
+    // How the last successful Compile produced the program, and how long it took.
+    bool LoadedFromCache() const { return loadedFromCache_; }
+    float BuildTimeMs() const { return buildTimeMs_; }
+
 private:
     GLuint CompileShader(GLenum type, const char* source);
+    bool LinkFromSource(const char* vertexSrc, const char* fragmentSrc, bool retrievable);
+    bool LoadBinary(const ProgramBinaryCache& cache, uint64_t key);
+    void StoreBinary(const ProgramBinaryCache& cache, uint64_t key) const;
 
     GLuint program_{0};
+    bool loadedFromCache_{false};
+    float buildTimeMs_{0.0f};
 };
 
 }  // namespace engine
@@ -0,0 +1,341 @@
+#include "trace.h"
+
+#if defined(ENGINE_TRACE)
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#endif
+
+#include "log.h"
+#endif
+
+namespace engine::trace {
+
+#if defined(ENGINE_TRACE)
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+// 1.25 MiB per thread that records: about 30 s of a traced render thread.
+constexpr std::size_t kEventsPerThread = 1 << 15;
+
+enum class EventType : uint8_t {
+    kZone,
+    kCounter,
+};
+
+struct Event {
+    const char* name;
+    int64_t startNanos;
+    int64_t durationNanos;
+    double value;
+    EventType type;
+};
+
+// Written only by its thread. Entries below `count` are complete and never
+// change until the next Start, so readers need no lock: they acquire
+// `count` and read below it. The first event after a Start (a new
+// generation) rewinds the buffer.
+struct ThreadBuffer {
+    explicit ThreadBuffer(int id) : tid(id), events(new Event[kEventsPerThread]) {}
+
+    const int tid;
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint32_t> generation{0};
+    std::atomic<std::size_t> count{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<const char*> name{nullptr};
+    // Cleared when the owning thread exits so another thread can take the
+    // buffer over instead of allocating one.
+    std::atomic<bool> inUse{true};
+};
+
+// Start, Stop, export and buffer registration take the mutex; recording
+// does not.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::atomic<bool> recording{false};
+    std::atomic<uint32_t> generation{1};
+    int64_t startNanos{0};
+};
+
+// Never destroyed: threads may still record while the process exits.
+Registry& GetRegistry() {
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+// Hands the thread's buffer back to the registry when the thread exits.
+struct ThreadSlot {
+    ThreadBuffer* buffer{nullptr};
+    const char* name{nullptr};
+
+    ~ThreadSlot() {
+        if (buffer) {
+            buffer->inUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadSlot tlsSlot;
+
+int64_t NowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Allocated on the thread's first event, so threads that never record while
+// a trace is running cost nothing.
+ThreadBuffer* CurrentBuffer() {
+    if (!tlsSlot.buffer) {
+        Registry& registry = GetRegistry();
+        std::scoped_lock lock(registry.mutex);
+        for (const auto& buffer : registry.buffers) {
+            if (!buffer->inUse.load(std::memory_order_acquire)) {
+                buffer->inUse.store(true, std::memory_order_relaxed);
+                tlsSlot.buffer = buffer.get();
+                break;
+            }
+        }
+        if (!tlsSlot.buffer) {
+            const int tid = static_cast<int>(registry.buffers.size()) + 1;
+            registry.buffers.push_back(std::make_unique<ThreadBuffer>(tid));
+            tlsSlot.buffer = registry.buffers.back().get();
+        }
+        tlsSlot.buffer->name.store(tlsSlot.name, std::memory_order_release);
+    }
+    return tlsSlot.buffer;
+}
+
+void Append(const Event& event) {
+    ThreadBuffer* buffer = CurrentBuffer();
+    const uint32_t generation = GetRegistry().generation.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+    const std::size_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= kEventsPerThread) {
+        buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[index] = event;
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+#if defined(__ANDROID__)
+// Looked up at run time: ATrace_* need API 23, ATrace_setCounter API 29.
+struct ATraceApi {
+    bool (*isEnabled)(){nullptr};
+    void (*beginSection)(const char*){nullptr};
+    void (*endSection)(){nullptr};
+    void (*setCounter)(const char*, int64_t){nullptr};
+};
+
+const ATraceApi& GetATrace() {
+    static const ATraceApi api = []() {
+        ATraceApi loaded;
+        void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            return loaded;
+        }
+        loaded.isEnabled = reinterpret_cast<bool (*)()>(dlsym(library, "ATrace_isEnabled"));
+        loaded.beginSection = reinterpret_cast<void (*)(const char*)>(dlsym(library, "ATrace_beginSection"));
+        loaded.endSection = reinterpret_cast<void (*)()>(dlsym(library, "ATrace_endSection"));
+        loaded.setCounter = reinterpret_cast<void (*)(const char*, int64_t)>(dlsym(library, "ATrace_setCounter"));
+        if (!loaded.beginSection || !loaded.endSection) {
+            loaded.isEnabled = nullptr;
+        }
+        return loaded;
+    }();
+    return api;
+}
+
+// True while a system trace is capturing the app.
+bool ATraceEnabled() {
+    const ATraceApi& api = GetATrace();
+    return api.isEnabled && api.isEnabled();
+}
+#endif
+
+void AppendEscaped(std::string* out, const char* text) {
+    for (const char* c = text ? text : ""; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out->push_back('\\');
+            out->push_back(*c);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            out->push_back(' ');
+        } else {
+            out->push_back(*c);
+        }
+    }
+}
+
+}  // namespace
+
+bool Start() {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    // Buffers rewind on their next event; until then their old generation
+    // hides them from export.
+    registry.generation.fetch_add(1, std::memory_order_acq_rel);
+    registry.startNanos = NowNanos();
+    registry.recording.store(true, std::memory_order_release);
+    return true;
+}
+
+void Stop() {
+    GetRegistry().recording.store(false, std::memory_order_release);
+}
+
+bool IsRecording() {
+    return GetRegistry().recording.load(std::memory_order_acquire);
+}
+
+std::string ChromeJson() {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    const uint32_t generation = registry.generation.load(std::memory_order_acquire);
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    uint64_t dropped = 0;
+    char number[96];
+    auto beginEvent = [&]() {
+        json += first ? "\n" : ",\n";
+        first = false;
+    };
+    for (const auto& buffer : registry.buffers) {
+        if (const char* name = buffer->name.load(std::memory_order_acquire)) {
+            beginEvent();
+            std::snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,",
+                          buffer->tid);
+            json += number;
+            json += "\"args\":{\"name\":\"";
+            AppendEscaped(&json, name);
+            json += "\"}}";
+        }
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Event& event = buffer->events[i];
+            const double ts = static_cast<double>(event.startNanos - registry.startNanos) / 1000.0;
+            beginEvent();
+            json += "{\"name\":\"";
+            AppendEscaped(&json, event.name);
+            if (event.type == EventType::kZone) {
+                std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                              ts, static_cast<double>(event.durationNanos) / 1000.0, buffer->tid);
+            } else {
+                std::snprintf(number, sizeof(number),
+                              "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"value\":%.6g}}", ts,
+                              buffer->tid, event.value);
+            }
+            json += number;
+        }
+    }
+    std::snprintf(number, sizeof(number), "\n],\"otherData\":{\"droppedEvents\":%llu}}\n",
+                  static_cast<unsigned long long>(dropped));
+    json += number;
+    return json;
+}
+
+bool WriteChromeJson(const std::string& path) {
+    const std::string json = ChromeJson();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        ENGINE_LOGE(kTag, "Cannot write trace to %s", path.c_str());
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    if (std::fclose(file) != 0 || !written) {
+        ENGINE_LOGE(kTag, "Failed writing trace to %s", path.c_str());
+        return false;
+    }
+    ENGINE_LOGI(kTag, "Trace written to %s (%zu bytes)", path.c_str(), json.size());
+    return true;
+}
+
+void SetThreadName(const char* name) {
+    tlsSlot.name = name;
+    if (tlsSlot.buffer) {
+        tlsSlot.buffer->name.store(name, std::memory_order_release);
+    }
+}
+
+void Counter(const char* name, double value) {
+#if defined(__ANDROID__)
+    const ATraceApi& api = GetATrace();
+    if (api.setCounter && ATraceEnabled()) {
+        api.setCounter(name, static_cast<int64_t>(std::llround(value)));
+    }
+#endif
+    if (IsRecording()) {
+        Append(Event{name, NowNanos(), 0, value, EventType::kCounter});
+    }
+}
+
+int64_t ZoneStartNanos() {
+    return IsRecording() ? NowNanos() : 0;
+}
+
+bool BeginZone(const char* name) {
+#if defined(__ANDROID__)
+    if (ATraceEnabled()) {
+        GetATrace().beginSection(name);
+        return true;
+    }
+#endif
+    return false;
+}
+
+void EndZone(const char* name, int64_t startNanos, bool atrace) {
+#if defined(__ANDROID__)
+    if (atrace) {
+        GetATrace().endSection();
+    }
+#endif
+    // A zone that straddles Start or Stop is left out.
+    if (startNanos != 0 && IsRecording()) {
+        Append(Event{name, startNanos, NowNanos() - startNanos, 0.0, EventType::kZone});
+    }
+}
+
+#else
+
+bool Start() {
+    return false;
+}
+
+void Stop() {}
+
+bool IsRecording() {
+    return false;
+}
+
+std::string ChromeJson() {
+    return std::string();
+}
+
+bool WriteChromeJson(const std::string& path) {
+    return false;
+}
+
+void SetThreadName(const char* name) {}
+
+void Counter(const char* name, double value) {}
+
+#endif
+
+}  // namespace engine::trace
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Hot-path tracing: scoped zones and counters, recorded into per-thread
+// buffers and exported as Chrome trace event JSON (chrome://tracing,
+// ui.perfetto.dev). On Android, zones and counters also go to ATrace while
+// a system trace (Perfetto, systrace) is capturing.
+//
+// Only built with ENGINE_TRACE defined (CMake -DENGINE_TRACE=ON). Without
+// it the macros expand to nothing and the functions below do nothing, so
+// the hot path carries no trace code at all.
+//
+//   void Renderer::RenderFrame() {
+//       ENGINE_TRACE_SCOPE("RenderFrame");
+//       ...
+//       ENGINE_TRACE_COUNTER("drawCalls", stats.drawCalls);
+//   }
+//
+// Names must be string literals (or otherwise outlive the recording); only
+// the pointer is stored.
+//
+// Each thread appends to its own fixed-size buffer without locks or atomic
+// read-modify-writes; a full buffer drops further events and counts them.
+// Only registering a thread's buffer, on its first event, takes a lock.
+
+namespace engine::trace {
+
+// Discards anything recorded and starts recording. Returns false when
+// tracing is compiled out.
+bool Start();
+void Stop();
+bool IsRecording();
+
+// Events recorded since Start, from every thread, as Chrome trace JSON.
+// Safe while recording; events still being written are left out.
+std::string ChromeJson();
+bool WriteChromeJson(const std::string& path);
+
+// Shown as the thread's track name; call on the thread itself.
+void SetThreadName(const char* name);
+
+void Counter(const char* name, double value);
+
+#if defined(ENGINE_TRACE)
+// What ENGINE_TRACE_SCOPE expands to. The start time is 0 when not
+// recording; `atrace` tells the end to close an ATrace section.
+int64_t ZoneStartNanos();
+bool BeginZone(const char* name);
+void EndZone(const char* name, int64_t startNanos, bool atrace);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(name), startNanos_(ZoneStartNanos()), atrace_(BeginZone(name)) {}
+    ~Scope() { EndZone(name_, startNanos_, atrace_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    int64_t startNanos_;
+    bool atrace_;
+};
+#endif
+
+}  // namespace engine::trace
+
+#if defined(ENGINE_TRACE)
+#define ENGINE_TRACE_CONCAT_INNER(a, b) a##b
+#define ENGINE_TRACE_CONCAT(a, b) ENGINE_TRACE_CONCAT_INNER(a, b)
+#define ENGINE_TRACE_SCOPE(name) ::engine::trace::Scope ENGINE_TRACE_CONCAT(engineTraceScope, __LINE__)(name)
+#define ENGINE_TRACE_COUNTER(name, value) ::engine::trace::Counter(name, static_cast<double>(value))
+#define ENGINE_TRACE_THREAD_NAME(name) ::engine::trace::SetThreadName(name)
+#else
+#define ENGINE_TRACE_SCOPE(name) \
+    do {                         \
+    } while (0)
+#define ENGINE_TRACE_COUNTER(name, value) \
+    do {                                  \
+    } while (0)
+#define ENGINE_TRACE_THREAD_NAME(name) \
+    do {                               \
+    } while (0)
+#endif
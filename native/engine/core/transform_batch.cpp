@@ -0,0 +1,220 @@
+#include "transform_batch.h"
+
+namespace engine {
+
+namespace {
+
+#if defined(ENGINE_MATH_SIMD)
+using simd::F4;
+
+constexpr std::size_t kLanes = 4;
+
+// A 4x4 matrix per lane: element m[col * 4 + row] holds that entry for four
+// consecutive instances.
+struct LaneMat4 {
+    F4 m[16];
+};
+
+F4 LoadLanes(const float* src, std::size_t count, float fill) {
+    if (count == kLanes) {
+        return simd::Load(src);
+    }
+    float lanes[kLanes] = {fill, fill, fill, fill};
+    for (std::size_t i = 0; i < count; ++i) {
+        lanes[i] = src[i];
+    }
+    return simd::Load(lanes);
+}
+
+LaneMat4 SplatMat4(const Mat4& matrix) {
+    LaneMat4 result;
+    for (int i = 0; i < 16; ++i) {
+        result.m[i] = simd::Splat(matrix.data[i]);
+    }
+    return result;
+}
+
+// Local TRS matrices for instances [base, base + count).
+LaneMat4 ComposeLanes(const TransformSoA& locals, std::size_t base, std::size_t count) {
+    const F4 x = LoadLanes(locals.rotationX.data() + base, count, 0.0f);
+    const F4 y = LoadLanes(locals.rotationY.data() + base, count, 0.0f);
+    const F4 z = LoadLanes(locals.rotationZ.data() + base, count, 0.0f);
+    const F4 w = LoadLanes(locals.rotationW.data() + base, count, 1.0f);
+    const F4 sx = LoadLanes(locals.scaleX.data() + base, count, 1.0f);
+    const F4 sy = LoadLanes(locals.scaleY.data() + base, count, 1.0f);
+    const F4 sz = LoadLanes(locals.scaleZ.data() + base, count, 1.0f);
+
+    const F4 one = simd::Splat(1.0f);
+    const F4 two = simd::Splat(2.0f);
+    const F4 x2 = simd::Mul(x, two);
+    const F4 y2 = simd::Mul(y, two);
+    const F4 z2 = simd::Mul(z, two);
+    const F4 xx = simd::Mul(x, x2);
+    const F4 yy = simd::Mul(y, y2);
+    const F4 zz = simd::Mul(z, z2);
+    const F4 xy = simd::Mul(x, y2);
+    const F4 xz = simd::Mul(x, z2);
+    const F4 yz = simd::Mul(y, z2);
+    const F4 wx = simd::Mul(w, x2);
+    const F4 wy = simd::Mul(w, y2);
+    const F4 wz = simd::Mul(w, z2);
+
+    const F4 zero = simd::Splat(0.0f);
+    LaneMat4 local;
+    local.m[0] = simd::Mul(simd::Sub(one, simd::Add(yy, zz)), sx);
+    local.m[1] = simd::Mul(simd::Add(xy, wz), sx);
+    local.m[2] = simd::Mul(simd::Sub(xz, wy), sx);
+    local.m[3] = zero;
+    local.m[4] = simd::Mul(simd::Sub(xy, wz), sy);
+    local.m[5] = simd::Mul(simd::Sub(one, simd::Add(xx, zz)), sy);
+    local.m[6] = simd::Mul(simd::Add(yz, wx), sy);
+    local.m[7] = zero;
+    local.m[8] = simd::Mul(simd::Add(xz, wy), sz);
+    local.m[9] = simd::Mul(simd::Sub(yz, wx), sz);
+    local.m[10] = simd::Mul(simd::Sub(one, simd::Add(xx, yy)), sz);
+    local.m[11] = zero;
+    local.m[12] = LoadLanes(locals.positionX.data() + base, count, 0.0f);
+    local.m[13] = LoadLanes(locals.positionY.data() + base, count, 0.0f);
+    local.m[14] = LoadLanes(locals.positionZ.data() + base, count, 0.0f);
+    local.m[15] = one;
+    return local;
+}
+
+// lhs * rhs where rhs is an affine TRS matrix (bottom row 0, 0, 0, 1).
+LaneMat4 MultiplyAffineLanes(const LaneMat4& lhs, const LaneMat4& rhs) {
+    LaneMat4 result;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            F4 sum = simd::Mul(lhs.m[row], rhs.m[col * 4]);
+            sum = simd::MulAdd(sum, lhs.m[4 + row], rhs.m[col * 4 + 1]);
+            sum = simd::MulAdd(sum, lhs.m[8 + row], rhs.m[col * 4 + 2]);
+            if (col == 3) {
+                sum = simd::Add(sum, lhs.m[12 + row]);
+            }
+            result.m[col * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+LaneMat4 MultiplyLanes(const LaneMat4& lhs, const LaneMat4& rhs) {
+    LaneMat4 result;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            F4 sum = simd::Mul(lhs.m[row], rhs.m[col * 4]);
+            sum = simd::MulAdd(sum, lhs.m[4 + row], rhs.m[col * 4 + 1]);
+            sum = simd::MulAdd(sum, lhs.m[8 + row], rhs.m[col * 4 + 2]);
+            sum = simd::MulAdd(sum, lhs.m[12 + row], rhs.m[col * 4 + 3]);
+            result.m[col * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+// Transposes lane-major data back into one Mat4 per instance.
+void StoreLanes(const LaneMat4& lanes, Mat4* out, std::size_t count) {
+    for (int col = 0; col < 4; ++col) {
+        F4 c[4] = {lanes.m[col * 4], lanes.m[col * 4 + 1], lanes.m[col * 4 + 2], lanes.m[col * 4 + 3]};
+        simd::Transpose(c[0], c[1], c[2], c[3]);
+        for (std::size_t i = 0; i < count; ++i) {
+            simd::Store(out[i].Ptr() + col * 4, c[i]);
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+void TransformSoA::Resize(std::size_t count) {
+    positionX.resize(count, 0.0f);
+    positionY.resize(count, 0.0f);
+    positionZ.resize(count, 0.0f);
+    rotationX.resize(count, 0.0f);
+    rotationY.resize(count, 0.0f);
+    rotationZ.resize(count, 0.0f);
+    rotationW.resize(count, 1.0f);
+    scaleX.resize(count, 1.0f);
+    scaleY.resize(count, 1.0f);
+    scaleZ.resize(count, 1.0f);
+}
+
+void TransformSoA::Set(std::size_t index, const Vec3& position, const Vec4& rotation, const Vec3& scale) {
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+    rotationX[index] = rotation.x;
+    rotationY[index] = rotation.y;
+    rotationZ[index] = rotation.z;
+    rotationW[index] = rotation.w;
+    scaleX[index] = scale.x;
+    scaleY[index] = scale.y;
+    scaleZ[index] = scale.z;
+}
+
+Mat4 ComposeTransform(const Vec3& position, const Vec4& rotation, const Vec3& scale) {
+    const float x2 = rotation.x * 2.0f;
+    const float y2 = rotation.y * 2.0f;
+    const float z2 = rotation.z * 2.0f;
+    const float xx = rotation.x * x2;
+    const float yy = rotation.y * y2;
+    const float zz = rotation.z * z2;
+    const float xy = rotation.x * y2;
+    const float xz = rotation.x * z2;
+    const float yz = rotation.y * z2;
+    const float wx = rotation.w * x2;
+    const float wy = rotation.w * y2;
+    const float wz = rotation.w * z2;
+
+    Mat4 result;
+    result.data = {
+        (1.0f - (yy + zz)) * scale.x, (xy + wz) * scale.x,          (xz - wy) * scale.x,          0.0f,
+        (xy - wz) * scale.y,          (1.0f - (xx + zz)) * scale.y, (yz + wx) * scale.y,          0.0f,
+        (xz + wy) * scale.z,          (yz - wx) * scale.z,          (1.0f - (xx + yy)) * scale.z, 0.0f,
+        position.x,                   position.y,                   position.z,                   1.0f
+    };
+    return result;
+}
+
+void ComputeWorldTransforms(const TransformSoA& locals,
+                            const Mat4& root,
+                            const Mat4& viewProj,
+                            Mat4* outWorld,
+                            Mat4* outWorldViewProj) {
+#if defined(ENGINE_MATH_SIMD)
+    const std::size_t count = locals.Size();
+    const LaneMat4 rootLanes = SplatMat4(root);
+    const LaneMat4 viewProjLanes = SplatMat4(viewProj);
+
+    for (std::size_t base = 0; base < count; base += kLanes) {
+        const std::size_t lanes = count - base < kLanes ? count - base : kLanes;
+        const LaneMat4 world = MultiplyAffineLanes(rootLanes, ComposeLanes(locals, base, lanes));
+        if (outWorld) {
+            StoreLanes(world, outWorld + base, lanes);
+        }
+        StoreLanes(MultiplyLanes(viewProjLanes, world), outWorldViewProj + base, lanes);
+    }
+#else
+    ComputeWorldTransformsScalar(locals, root, viewProj, outWorld, outWorldViewProj);
+#endif
+}
+
+void ComputeWorldTransformsScalar(const TransformSoA& locals,
+                                  const Mat4& root,
+                                  const Mat4& viewProj,
+                                  Mat4* outWorld,
+                                  Mat4* outWorldViewProj) {
+    const std::size_t count = locals.Size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const Mat4 local = ComposeTransform(
+            Vec3{locals.positionX[i], locals.positionY[i], locals.positionZ[i]},
+            Vec4{locals.rotationX[i], locals.rotationY[i], locals.rotationZ[i], locals.rotationW[i]},
+            Vec3{locals.scaleX[i], locals.scaleY[i], locals.scaleZ[i]});
+        const Mat4 world = scalar::Multiply(root, local);
+        if (outWorld) {
+            outWorld[i] = world;
+        }
+        outWorldViewProj[i] = scalar::Multiply(viewProj, world);
+    }
+}
+
+}  // namespace engine
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "math_types.h"
+
+namespace engine {
+
+// Structure-of-arrays local transforms for a batch of parts. Rotations are
+// unit quaternions stored as (x, y, z, w).
+struct TransformSoA {
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> positionZ;
+    std::vector<float> rotationX;
+    std::vector<float> rotationY;
+    std::vector<float> rotationZ;
+    std::vector<float> rotationW;
+    std::vector<float> scaleX;
+    std::vector<float> scaleY;
+    std::vector<float> scaleZ;
+
+    std::size_t Size() const { return positionX.size(); }
+
+    // New entries are initialised to the identity transform.
+    void Resize(std::size_t count);
+    void Set(std::size_t index, const Vec3& position, const Vec4& rotation, const Vec3& scale);
+};
+
+// Builds the translation * rotation * scale matrix for a single transform.
+Mat4 ComposeTransform(const Vec3& position, const Vec4& rotation, const Vec3& scale);
+
+// Computes world = root * local and worldViewProj = viewProj * world for
+// every entry of `locals` in one pass, four instances per SIMD iteration.
+// `outWorld` may be null when only clip-space matrices are needed; otherwise
+// both outputs must hold locals.Size() matrices.
+void ComputeWorldTransforms(const TransformSoA& locals,
+                            const Mat4& root,
+                            const Mat4& viewProj,
+                            Mat4* outWorld,
+                            Mat4* outWorldViewProj);
+
+// Scalar per-instance equivalent of ComputeWorldTransforms; kept as the
+// reference for tools/transform_bench.cpp.
+void ComputeWorldTransformsScalar(const TransformSoA& locals,
+                                  const Mat4& root,
+                                  const Mat4& viewProj,
+                                  Mat4* outWorld,
+                                  Mat4* outWorldViewProj);
+
+}  // namespace engine
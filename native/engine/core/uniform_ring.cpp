@@ -0,0 +1,159 @@
+#include "uniform_ring.h"
+
+#include <chrono>
+
+#include "gl_state_cache.h"
+
+namespace engine {
+
+namespace {
+
+// Per glClientWaitSync call; the wait repeats until the fence signals.
+constexpr GLuint64 kWaitSliceNanos = 100'000'000;
+
+int64_t NowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+UniformRing::~UniformRing() {
+    Destroy();
+}
+
+bool UniformRing::Initialize(std::size_t bytesPerFrame) {
+    Destroy();
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = alignment > 0 ? static_cast<std::size_t>(alignment) : 256;
+    return CreateStorage(bytesPerFrame);
+}
+
+void UniformRing::Destroy() {
+    for (GLsync& fence : fences_) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (buffer_ != 0) {
+        GlStateCache::Current().DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+    segmentBytes_ = 0;
+    mapped_ = nullptr;
+    used_ = 0;
+}
+
+std::size_t UniformRing::AlignedSize(std::size_t size) const {
+    return (size + alignment_ - 1) / alignment_ * alignment_;
+}
+
+bool UniformRing::CreateStorage(std::size_t segmentBytes) {
+    // The old storage may still be read by frames in flight. glBufferData
+    // gives the buffer new storage and the driver frees the old one once
+    // those frames retire, so the old fences can simply be dropped.
+    for (GLsync& fence : fences_) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (buffer_ == 0) {
+        glGenBuffers(1, &buffer_);
+    }
+    segmentBytes_ = AlignedSize(segmentBytes > 0 ? segmentBytes : alignment_);
+    GlStateCache::Current().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(segmentBytes_ * kFramesInFlight), nullptr,
+                 GL_DYNAMIC_DRAW);
+    return buffer_ != 0;
+}
+
+void UniformRing::WaitForSegment(int segment) {
+    GLsync& fence = fences_[segment];
+    if (!fence) {
+        return;
+    }
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        // The GPU is kFramesInFlight frames behind; this is the only place
+        // the CPU waits for it.
+        const int64_t start = NowNanos();
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitSliceNanos);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        lastWaitNanos_ = NowNanos() - start;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+bool UniformRing::BeginFrame(std::size_t bytes) {
+    if (buffer_ == 0) {
+        return false;
+    }
+    lastWaitNanos_ = 0;
+    if (bytes > segmentBytes_) {
+        std::size_t grown = segmentBytes_;
+        while (grown < bytes) {
+            grown *= 2;
+        }
+        CreateStorage(grown);
+    }
+
+    segment_ = (segment_ + 1) % kFramesInFlight;
+    WaitForSegment(segment_);
+    used_ = 0;
+
+    // The fence guarantees the GPU is done with this segment, so the driver
+    // may skip its own synchronisation and the old contents.
+    GlStateCache::Current().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    mapped_ = static_cast<uint8_t*>(glMapBufferRange(
+        GL_UNIFORM_BUFFER, static_cast<GLintptr>(segment_ * segmentBytes_), static_cast<GLsizeiptr>(segmentBytes_),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    useStaging_ = mapped_ == nullptr;
+    if (useStaging_) {
+        staging_.resize(segmentBytes_);
+        mapped_ = staging_.data();
+    }
+    return true;
+}
+
+void* UniformRing::Allocate(std::size_t size, GLintptr* offset) {
+    const std::size_t aligned = AlignedSize(size);
+    if (!mapped_ || used_ + aligned > segmentBytes_) {
+        return nullptr;
+    }
+    void* block = mapped_ + used_;
+    *offset = static_cast<GLintptr>(segment_ * segmentBytes_ + used_);
+    used_ += aligned;
+    return block;
+}
+
+void UniformRing::Flush() {
+    if (!mapped_) {
+        return;
+    }
+    GlStateCache::Current().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    if (useStaging_) {
+        glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(segment_ * segmentBytes_),
+                        static_cast<GLsizeiptr>(used_), staging_.data());
+    } else {
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    mapped_ = nullptr;
+}
+
+void UniformRing::Bind(GLuint bindingPoint, GLintptr offset, std::size_t size) const {
+    GlStateCache::Current().BindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer_, offset,
+                                            static_cast<GLsizeiptr>(size));
+}
+
+void UniformRing::EndFrame() {
+    if (buffer_ != 0) {
+        fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+}  // namespace engine
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Uniform buffer written once per frame. The buffer is split into
+// kFramesInFlight segments, each used by one frame and protected by a fence,
+// so the CPU writes frame N+1's uniforms while the GPU still reads frame N's
+// without the driver synchronising or copying.
+//
+// Per frame, on the render thread:
+//   BeginFrame(bytes)  waits for the segment's fence and maps it
+//                      (GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT)
+//   Allocate(...)      every block the frame needs
+//   Flush()            unmaps; GLES 3.0 cannot draw from a mapped buffer
+//   Bind(...)          per draw: glBindBufferRange at the block's offset
+//   EndFrame()         fences the segment after the frame's last draw
+//
+// Blocks use std140 layout. Offsets honour GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+class UniformRing {
+public:
+    static constexpr int kFramesInFlight = 3;
+
+    UniformRing() = default;
+    ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    // Returns false if the buffer could not be created.
+    bool Initialize(std::size_t bytesPerFrame);
+    // Deletes the buffer and fences; safe without a context (names are forgotten).
+    void Destroy();
+
+    // `bytes` is the frame's worst case, e.g. AlignedSize(block) per draw. The
+    // segments grow (to a power of two) when it does not fit.
+    bool BeginFrame(std::size_t bytes);
+    // Reserves an aligned block and returns where to write it, or nullptr
+    // when BeginFrame under-estimated. `offset` receives its buffer offset.
+    void* Allocate(std::size_t size, GLintptr* offset);
+    void Flush();
+    void Bind(GLuint bindingPoint, GLintptr offset, std::size_t size) const;
+    void EndFrame();
+
+    GLuint Buffer() const { return buffer_; }
+    std::size_t AlignedSize(std::size_t size) const;
+    // Time BeginFrame spent waiting on the GPU in the last frame.
+    int64_t LastWaitNanos() const { return lastWaitNanos_; }
+
+private:
+    bool CreateStorage(std::size_t segmentBytes);
+    void WaitForSegment(int segment);
+
+    GLuint buffer_{0};
+    GLsync fences_[kFramesInFlight]{};
+    std::size_t segmentBytes_{0};
+    std::size_t alignment_{256};
+    int segment_{0};
+    std::size_t used_{0};
+    uint8_t* mapped_{nullptr};
+    // Used when the driver refuses to map; uploaded with glBufferSubData.
+    std::vector<uint8_t> staging_;
+    bool useStaging_{false};
+    int64_t lastWaitNanos_{0};
+};
+
+}  // namespace engine
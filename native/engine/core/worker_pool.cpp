@@ -0,0 +1,62 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+#include "trace.h"
+
+namespace engine {
+
+WorkerPool::WorkerPool(unsigned threadCount) {
+    threadCount = std::max(1u, threadCount);
+    threads_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this]() { WorkerMain(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    cv_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::Submit(std::function<void()> job) {
+    {
+        std::scoped_lock lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        jobs_.emplace_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+unsigned WorkerPool::DefaultThreadCount() {
+    const unsigned cores = std::thread::hardware_concurrency();
+    return std::clamp(cores > 2 ? cores - 2 : 1u, 1u, 4u);
+}
+
+void WorkerPool::WorkerMain() {
+    ENGINE_TRACE_THREAD_NAME("EngineWorker");
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+}  // namespace engine
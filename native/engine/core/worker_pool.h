@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+// Fixed set of background threads draining a FIFO of jobs. Jobs must not
+// touch GL. Destruction drops jobs that have not started and joins the
+// threads after the running ones finish.
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void Submit(std::function<void()> job);
+
+    // One thread per core beyond the UI and render threads, at least one and
+    // at most four.
+    static unsigned DefaultThreadCount();
+
+private:
+    void WorkerMain();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool stopping_{false};
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace engine
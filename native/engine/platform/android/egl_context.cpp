@@ -85,6 +85,32 @@ bool EglContext::Initialize(ANativeWindow* window) {
     return true;
 }
 
+bool EglContext::AttachWindow(ANativeWindow* window) {
+    if (!HasContext()) {
+        return Initialize(window);
+    }
+
+    if (!CreateSurface(window) || !MakeCurrent()) {
+        ReleaseSurface();
+        return false;
+    }
+    return true;
+}
+
+void EglContext::DetachWindow() {
+    if (display_ == EGL_NO_DISPLAY) {
+        return;
+    }
+    // Keep the context current without a surface where
+    // EGL_KHR_surfaceless_context allows it, otherwise unbind it. Either way
+    // the surface is no longer current and is freed immediately.
+    if (context_ == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+    ReleaseSurface();
+}
+
 bool EglContext::CreateSurface(ANativeWindow* window) {
     ReleaseSurface();
 
@@ -131,10 +157,19 @@ bool EglContext::DetachCurrent() {
     return true;
 }
 
-void EglContext::SwapBuffers() {
-    if (display_ != EGL_NO_DISPLAY && surface_ != EGL_NO_SURFACE) {
-        eglSwapBuffers(display_, surface_);
+bool EglContext::SwapBuffers() {
+    if (display_ == EGL_NO_DISPLAY || surface_ == EGL_NO_SURFACE) {
+        return true;
     }
+    if (!eglSwapBuffers(display_, surface_)) {
+        const EGLint error = eglGetError();
+        if (error == EGL_CONTEXT_LOST) {
+            __android_log_print(ANDROID_LOG_WARN, kTag, "EGL context lost");
+            return false;
+        }
+        __android_log_print(ANDROID_LOG_ERROR, kTag, "eglSwapBuffers failed (0x%x)", error);
+    }
+    return true;
 }
 
 void EglContext::SetPresentationTime(int64_t nanoseconds) {
@@ -164,6 +199,12 @@ void EglContext::ReleaseSurface() {
 }
 
 void EglContext::Destroy() {
+    if (display_ != EGL_NO_DISPLAY) {
+        // Unbind first so the context and surface are freed immediately
+        // rather than when the owning thread next changes its binding.
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
     ReleaseSurface();
 
     if (display_ != EGL_NO_DISPLAY && context_ != EGL_NO_CONTEXT) {
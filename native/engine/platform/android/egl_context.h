@@ -14,11 +14,19 @@ public:
     bool Initialize(ANativeWindow* window);
     void Destroy();
 
+    // Surface-only lifecycle: AttachWindow reuses an existing context (and
+    // therefore every GL object created in it) when there is one, and
+    // DetachWindow releases just the EGLSurface.
+    bool AttachWindow(ANativeWindow* window);
+    void DetachWindow();
+
     bool IsValid() const { return display_ != EGL_NO_DISPLAY && surface_ != EGL_NO_SURFACE && context_ != EGL_NO_CONTEXT; }
+    bool HasContext() const { return display_ != EGL_NO_DISPLAY && context_ != EGL_NO_CONTEXT; }
 
     bool MakeCurrent();
     bool DetachCurrent();
-    void SwapBuffers();
+    // Returns false if the context was lost and must be rebuilt.
+    bool SwapBuffers();
     void SetPresentationTime(int64_t nanoseconds);
 
     int Width() const { return width_; }
@@ -1,234 +1,369 @@
 #include "engine/platform/android/engine_renderer.h"
 
+#include <android/asset_manager.h>
 #include <android/choreographer.h>
 #include <android/log.h>
 #include <algorithm>
-#include <array>
 #include <chrono>
-#include <cmath>
 #include <cstdio>
-#include <cstring>
+#include <future>
+#include <string>
 #include <thread>
 #include <EGL/egl.h>
 #include <GLES3/gl3.h>
 
+#include "engine/core/trace.h"
+
 namespace engine {
 
 namespace {
 constexpr const char* kTag = "EngineRenderer";
-constexpr float kMajorStep = 1.0f;
-constexpr float kMinorStep = 0.1f;
-constexpr float kPlaneExtent = 200.0f;
+// Cooked models kept on disk between launches.
+constexpr uint64_t kAssetCacheBytes = 128ull * 1024 * 1024;
+// Frames rendered with nothing changing before render on demand stops
+// requesting more; the extra frame covers a swap the compositor latched late.
+constexpr int kIdleAfterQuietFrames = 2;
 
-void CopyGlString(const GLubyte* source, std::array<char, 128>& destination) {
-    if (!source) {
-        destination[0] = '\0';
-        return;
-    }
-    std::snprintf(destination.data(), destination.size(), "%s", reinterpret_cast<const char*>(source));
-}
-
-const char* kVertexShaderSrc = R"(
-#version 300 es
-layout(location = 0) in vec3 aPosition;
-uniform mat4 uViewProj;
-uniform mat4 uModel;
-uniform float uExtent;
-out vec3 vWorldPos;
-out vec3 vLocalPos;
-void main() {
-    vec4 world = uModel * vec4(aPosition.x * uExtent, aPosition.y, aPosition.z * uExtent, 1.0);
-    vWorldPos = world.xyz;
-    vLocalPos = aPosition;
-    gl_Position = uViewProj * world;
+int64_t NowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 }
-)";
 
-const char* kFragmentShaderSrc = R"(
-#version 300 es
-precision mediump float;
-in vec3 vWorldPos;
-in vec3 vLocalPos;
-uniform vec3 uCameraPos;
-uniform float uMajorStep;
-uniform float uMinorStep;
-out vec4 fragColor;
+constexpr uint64_t kViewportPendingBit = 1ull << 63;
 
-float gridLine(float coord, float stepSize) {
-    float coordScaled = coord / stepSize;
-    float derivative = fwidth(coordScaled);
-    float line = abs(fract(coordScaled - 0.5) - 0.5) / max(derivative, 1e-4);
-    return 1.0 - clamp(line, 0.0, 1.0);
+uint64_t PackViewport(int width, int height) {
+    return kViewportPendingBit | (static_cast<uint64_t>(static_cast<uint32_t>(width) & 0x7fffffffu) << 32) |
+           static_cast<uint32_t>(height);
 }
 
-void main() {
-    float minor = max(gridLine(vWorldPos.x, uMinorStep), gridLine(vWorldPos.z, uMinorStep));
-    float major = max(gridLine(vWorldPos.x, uMajorStep), gridLine(vWorldPos.z, uMajorStep));
-
-    vec3 baseColor = vec3(0.04, 0.05, 0.07);
-    vec3 minorColor = vec3(0.10, 0.12, 0.18);
-    vec3 majorColor = vec3(0.35, 0.40, 0.55);
-
-    float blend = max(minor * 0.6, major);
-    vec3 color = mix(baseColor, minorColor, minor * 0.7);
-    color = mix(color, majorColor, major);
-
-    float fade = clamp(1.0 - length(vLocalPos.xz) * 0.5, 0.0, 1.0);
-    color *= fade + 0.2;
+template <std::size_t N>
+void CopyGlString(const GLubyte* source, char (&destination)[N]) {
+    if (!source) {
+        destination[0] = '\0';
+        return;
+    }
+    std::snprintf(destination, N, "%s", reinterpret_cast<const char*>(source));
+}
 
-    fragColor = vec4(color, 1.0);
+// Reads a whole file from the APK on a streaming worker.
+AssetReader ApkAssetReader(AAssetManager* manager, std::string path) {
+    return [manager, path = std::move(path)](std::vector<uint8_t>* bytes, std::string* error) {
+        AAsset* asset = AAssetManager_open(manager, path.c_str(), AASSET_MODE_STREAMING);
+        if (!asset) {
+            *error = "no APK asset " + path;
+            return false;
+        }
+        const int64_t length = AAsset_getLength64(asset);
+        bytes->resize(length > 0 ? static_cast<std::size_t>(length) : 0);
+        std::size_t offset = 0;
+        while (offset < bytes->size()) {
+            const int read = AAsset_read(asset, bytes->data() + offset, bytes->size() - offset);
+            if (read <= 0) {
+                break;
+            }
+            offset += static_cast<std::size_t>(read);
+        }
+        AAsset_close(asset);
+        if (offset != bytes->size() || bytes->empty()) {
+            *error = "cannot read APK asset " + path;
+            return false;
+        }
+        return true;
+    };
 }
-)";
 
 }  // namespace
 
-EngineRenderer::EngineRenderer() = default;
+EngineRenderer::EngineRenderer() {
+    renderThread_ = std::thread([this]() { RenderThreadMain(); });
+}
 
 EngineRenderer::~EngineRenderer() {
     Stop();
     ClearSurface();
-}
-
-bool EngineRenderer::SetSurface(ANativeWindow* window) {
-    std::scoped_lock lock(mutex_);
-    if (window == window_) {
-        return true;
-    }
-
-    ClearSurfaceLocked();
-
-    if (!window) {
-        return false;
+    {
+        std::scoped_lock lock(queueMutex_);
+        quitRequested_ = true;
     }
-
-    window_ = window;
-    ANativeWindow_acquire(window_);
-
-    if (!egl_.Initialize(window_)) {
-        __android_log_print(ANDROID_LOG_ERROR, kTag, "Failed to initialize EGL context");
-        ClearSurfaceLocked();
-        return false;
+    queueCv_.notify_one();
+    if (renderThread_.joinable()) {
+        renderThread_.join();
     }
+}
 
-    width_ = egl_.Width();
-    height_ = egl_.Height();
-    camera_.SetViewport(width_, height_);
-
-    InitializeGlResourcesLocked();
-    return true;
+bool EngineRenderer::SetSurface(ANativeWindow* window) {
+    // Blocks until the render thread has attached the surface so callers can
+    // report failure synchronously, as before.
+    const int64_t requestedNanos = NowNanos();
+    const bool attached =
+        RunOnRenderThread([this, window, requestedNanos]() { return AttachSurface(window, requestedNanos); });
+    RequestRender();
+    return attached;
 }
 
 void EngineRenderer::ClearSurface() {
-    std::scoped_lock lock(mutex_);
-    ClearSurfaceLocked();
+    // Must not return before the render thread stops using the window. Only
+    // the EGLSurface goes away; the context and GL resources are kept for the
+    // next SetSurface.
+    RunOnRenderThread([this]() {
+        ReleaseSurfaceOnRenderThread();
+        return true;
+    });
 }
 
 void EngineRenderer::Resize(int width, int height) {
-    std::scoped_lock lock(mutex_);
-    width_ = width;
-    height_ = height;
-    camera_.SetViewport(width_, height_);
+    pendingViewport_.store(PackViewport(width, height), std::memory_order_release);
+    RequestRender();
 }
 
 void EngineRenderer::Orbit(float deltaYaw, float deltaPitch) {
-    std::scoped_lock lock(mutex_);
-    camera_.Orbit(deltaYaw, deltaPitch);
+    input_.Push(InputCommand{InputCommandType::kOrbit, deltaYaw, deltaPitch, NowNanos()});
+    RequestRender();
 }
 
 void EngineRenderer::Pan(float deltaX, float deltaY) {
-    std::scoped_lock lock(mutex_);
-    camera_.Pan(deltaX, deltaY);
+    input_.Push(InputCommand{InputCommandType::kPan, deltaX, deltaY, NowNanos()});
+    RequestRender();
 }
 
 void EngineRenderer::Zoom(float scaleDelta) {
-    std::scoped_lock lock(mutex_);
-    camera_.Zoom(scaleDelta);
+    input_.Push(InputCommand{InputCommandType::kZoom, scaleDelta, 0.0f, NowNanos()});
+    RequestRender();
 }
 
 void EngineRenderer::SetPreferredFrameRate(int fps) {
     preferredFps_.store(fps);
 }
 
+void EngineRenderer::SetCacheDirectory(const char* path) {
+    PostTask([this, directory = std::string(path ? path : "")]() { programCache_.SetDirectory(directory); });
+}
+
+void EngineRenderer::SetAssetCacheDirectory(const char* path) {
+    // The cache locks internally, so it can be opened while workers decode.
+    AssetCache& cache = scene_.Cache();
+    if (cache.Open(path ? path : "", kAssetCacheBytes)) {
+        const AssetCache::Stats stats = cache.GetStats();
+        __android_log_print(ANDROID_LOG_INFO, kTag, "Asset cache: %zu entries, %.1f MiB", stats.entries,
+                            static_cast<double>(stats.bytes) / (1024.0 * 1024.0));
+    }
+}
+
+void EngineRenderer::SetAssetManager(AAssetManager* assets) {
+    assetManager_.store(assets, std::memory_order_release);
+}
+
+void EngineRenderer::LoadModel(const char* path) {
+    if (!path || path[0] == '\0') {
+        return;
+    }
+    std::string modelPath(path);
+    AssetReader reader;
+    if (modelPath.front() == '/') {
+        reader = AssetStreamer::FileReader(modelPath);
+    } else if (AAssetManager* assets = assetManager_.load(std::memory_order_acquire)) {
+        reader = ApkAssetReader(assets, modelPath);
+    } else {
+        __android_log_print(ANDROID_LOG_ERROR, kTag, "No asset manager for %s", path);
+        return;
+    }
+
+    PostTask([this, modelPath = std::move(modelPath), reader = std::move(reader)]() mutable {
+        scene_.AddModel(std::move(modelPath), std::move(reader));
+    });
+    RequestRender();
+}
+
+void EngineRenderer::SetRenderOnDemand(bool enabled) {
+    renderOnDemand_.store(enabled);
+    RequestRender();
+}
+
+void EngineRenderer::RequestRender() {
+    // Bumped before idle_ is cleared; UpdateIdleState re-reads it after
+    // setting idle_, so one of the two sides always re-arms.
+    wakeCount_.fetch_add(1);
+    if (idle_.exchange(false)) {
+        PostTask([this]() { ScheduleNextFrame(); });
+    }
+}
+
 void EngineRenderer::Start() {
-    if (isRunning_) {
+    if (isRunning_.exchange(true)) {
         return;
     }
-    isRunning_ = true;
-    lastFrameTime_.store(0);
-    fps_.store(0.0f, std::memory_order_relaxed);
-    frameTimeMs_.store(0.0f, std::memory_order_relaxed);
-    frameCounter_.store(0, std::memory_order_relaxed);
-    ScheduleNextFrame();
+    idle_.store(false);
+#if __ANDROID_API__ >= 24
+    // Only looper threads have a Choreographer, so it is looked up here
+    // rather than on the render thread.
+    if (!choreographer_.load()) {
+        choreographer_.store(AChoreographer_getInstance());
+    }
+#endif
+    PostTask([this]() {
+        ResetFrameStats();
+        ScheduleNextFrame();
+    });
 }
 
 void EngineRenderer::Stop() {
-    if (!isRunning_) {
+    if (!isRunning_.exchange(false)) {
         return;
     }
-    isRunning_ = false;
-    StopFallbackLoopLocked();
+    PostTask([this]() { StopFallbackLoop(); });
 }
 
-void EngineRenderer::InitializeGlResourcesLocked() {
-    if (!egl_.IsValid() || !egl_.MakeCurrent()) {
-        __android_log_print(ANDROID_LOG_WARN, kTag, "Cannot initialize GL resources without current context");
-        return;
+bool EngineRenderer::RunOnRenderThread(const std::function<bool()>& task) {
+    if (std::this_thread::get_id() == renderThread_.get_id()) {
+        return task();
     }
 
-    shader_.Destroy();
-    gridPlane_.Destroy();
+    std::promise<bool> done;
+    std::future<bool> result = done.get_future();
+    PostTask([&task, &done]() { done.set_value(task()); });
+    return result.get();
+}
+
+void EngineRenderer::PostTask(std::function<void()> task) {
+    {
+        std::scoped_lock lock(queueMutex_);
+        tasks_.emplace_back(std::move(task));
+    }
+    queueCv_.notify_one();
+}
 
-    if (!shader_.Compile(kVertexShaderSrc, kFragmentShaderSrc)) {
-        __android_log_print(ANDROID_LOG_ERROR, kTag, "Failed to compile shader program");
+void EngineRenderer::PostFrame(int64_t vsyncNanos) {
+    ENGINE_TRACE_SCOPE("PostFrame");
+    FramePacer::Frame frame;
+    {
+        std::scoped_lock lock(pacerMutex_);
+        pacer_.SetTargetFps(preferredFps_.load());
+        frame = pacer_.OnVsync(vsyncNanos);
+    }
+    if (!frame.render) {
         return;
     }
+    {
+        std::scoped_lock lock(queueMutex_);
+        // Only the newest frame matters; one that arrives while the previous
+        // frame is still rendering replaces the pending one.
+        pendingFrame_ = frame;
+    }
+    queueCv_.notify_one();
+}
+
+void EngineRenderer::RenderThreadMain() {
+    ENGINE_TRACE_THREAD_NAME("RenderThread");
+    std::deque<std::function<void()>> tasks;
+    for (;;) {
+        FramePacer::Frame frame;
+        {
+            std::unique_lock lock(queueMutex_);
+            queueCv_.wait(lock, [this]() { return quitRequested_ || !tasks_.empty() || pendingFrame_.render; });
+            if (quitRequested_ && tasks_.empty()) {
+                break;
+            }
+            tasks.swap(tasks_);
+            frame = pendingFrame_;
+            pendingFrame_ = {};
+        }
 
-    uViewProj_ = glGetUniformLocation(shader_.Id(), "uViewProj");
-    uModel_ = glGetUniformLocation(shader_.Id(), "uModel");
-    uCameraPos_ = glGetUniformLocation(shader_.Id(), "uCameraPos");
+        for (auto& task : tasks) {
+            task();
+        }
+        tasks.clear();
 
-    GLint extentLocation = glGetUniformLocation(shader_.Id(), "uExtent");
-    GLint majorLocation = glGetUniformLocation(shader_.Id(), "uMajorStep");
-    GLint minorLocation = glGetUniformLocation(shader_.Id(), "uMinorStep");
+        if (frame.render) {
+            RenderFrame(frame);
+        }
+    }
 
-    gridPlane_.Initialize();
+    DestroyContextOnRenderThread();
+    eglReleaseThread();
+}
 
-    glUseProgram(shader_.Id());
-    glUniform1f(extentLocation, kPlaneExtent);
-    glUniform1f(majorLocation, kMajorStep);
-    glUniform1f(minorLocation, kMinorStep);
-    glUseProgram(0);
+bool EngineRenderer::AttachSurface(ANativeWindow* window, int64_t requestedNanos) {
+    if (window == window_) {
+        return true;
+    }
+    ENGINE_TRACE_SCOPE("AttachSurface");
 
-    CopyGlString(glGetString(GL_RENDERER), gpuRenderer_);
-    CopyGlString(glGetString(GL_VENDOR), gpuVendor_);
-    CopyGlString(glGetString(GL_VERSION), gpuVersion_);
+    ReleaseSurfaceOnRenderThread();
 
-    egl_.DetachCurrent();
-    eglReleaseThread();
+    if (!window) {
+        return false;
+    }
+
+    window_ = window;
+    ANativeWindow_acquire(window_);
+
+    // With a surviving context only a new EGLSurface is created; shaders and
+    // buffers are still valid. The context stays current on this thread.
+    const bool hadContext = egl_.HasContext();
+    bool attached = egl_.AttachWindow(window_);
+    if (!attached && hadContext) {
+        // The old context cannot take the new surface; rebuild from scratch.
+        __android_log_print(ANDROID_LOG_WARN, kTag, "Recreating EGL context for new surface");
+        ANativeWindow* retained = window_;
+        window_ = nullptr;
+        DestroyContextOnRenderThread();
+        window_ = retained;
+        attached = egl_.AttachWindow(window_);
+    }
+    if (!attached) {
+        __android_log_print(ANDROID_LOG_ERROR, kTag, "Failed to initialize EGL context");
+        ReleaseSurfaceOnRenderThread();
+        return false;
+    }
+
+    width_ = egl_.Width();
+    height_ = egl_.Height();
+    camera_.SetViewport(width_, height_);
+
+    const bool preserved = hadContext && egl_.HasContext() && scene_.GlReady();
+    if (!preserved) {
+        InitializeGlResources();
+    }
+
+    {
+        // The new surface may be on another display; relearn its refresh.
+        std::scoped_lock lock(pacerMutex_);
+        pacer_.Reset();
+    }
+
+    resumeStartNanos_ = requestedNanos;
+    frameStats_.contextPreserved = preserved;
+    frameStats_.eglReady = true;
+    PublishFrameDiagnostics();
+    return true;
 }
 
-void EngineRenderer::DestroyGlResourcesLocked() {
+bool EngineRenderer::InitializeGlResources() {
+    ENGINE_TRACE_SCOPE("InitializeGlResources");
     if (!egl_.IsValid()) {
-        shader_.Destroy();
-        gridPlane_.Destroy();
-        return;
+        __android_log_print(ANDROID_LOG_WARN, kTag, "Cannot initialize GL resources without current context");
+        return false;
     }
 
-    if (!egl_.MakeCurrent()) {
-        shader_.Destroy();
-        gridPlane_.Destroy();
-        return;
-    }
+    // The device strings never change for a context, so they are published
+    // once here rather than with every frame. They also key the program cache.
+    GpuDiagnostics gpu;
+    CopyGlString(glGetString(GL_RENDERER), gpu.gpuRenderer);
+    CopyGlString(glGetString(GL_VENDOR), gpu.gpuVendor);
+    CopyGlString(glGetString(GL_VERSION), gpu.gpuVersion);
+    publishedGpu_.Store(gpu);
+    programCache_.SetDeviceTag(gpu.gpuRenderer, gpu.gpuVersion);
 
-    shader_.Destroy();
-    gridPlane_.Destroy();
+    return scene_.InitializeGl(&programCache_, &frameStats_);
+}
 
-    egl_.DetachCurrent();
-    eglReleaseThread();
+void EngineRenderer::DestroyGlResources() {
+    scene_.DestroyGl();
 }
 
-void EngineRenderer::ClearSurfaceLocked() {
-    DestroyGlResourcesLocked();
+void EngineRenderer::ReleaseSurfaceOnRenderThread() {
+    frameStats_.eglReady = false;
+    egl_.DetachWindow();
 
     if (window_) {
         ANativeWindow_release(window_);
@@ -236,61 +371,217 @@ void EngineRenderer::ClearSurfaceLocked() {
     }
     width_ = 0;
     height_ = 0;
+    PublishFrameDiagnostics();
+}
+
+void EngineRenderer::DestroyContextOnRenderThread() {
+    ReleaseSurfaceOnRenderThread();
+    DestroyGlResources();
     egl_.Destroy();
 }
 
-void EngineRenderer::RenderFrame(int64_t frameTimeNanos) {
-    if (!isRunning_ || !egl_.IsValid()) {
-        return;
+int64_t EngineRenderer::ApplyPendingInput() {
+    const uint64_t viewport = pendingViewport_.exchange(0, std::memory_order_acquire);
+    if (viewport != 0) {
+        width_ = static_cast<int>((viewport >> 32) & 0x7fffffffu);
+        height_ = static_cast<int>(viewport & 0xffffffffu);
+        camera_.SetViewport(width_, height_);
     }
 
-    std::scoped_lock lock(mutex_);
+    return input_.DrainCoalesced([this](const InputCommand& command) {
+        switch (command.type) {
+            case InputCommandType::kOrbit:
+                camera_.Orbit(command.x, command.y);
+                break;
+            case InputCommandType::kPan:
+                camera_.Pan(command.x, command.y);
+                break;
+            case InputCommandType::kZoom:
+                camera_.Zoom(command.x);
+                break;
+        }
+    });
+}
 
-    eglBindAPI(EGL_OPENGL_ES_API);
-    if (!egl_.MakeCurrent()) {
+void EngineRenderer::RenderFrame(const FramePacer::Frame& frame) {
+    const int64_t frameTimeNanos = frame.vsyncNanos;
+    if (!isRunning_.load(std::memory_order_relaxed) || !egl_.IsValid()) {
         return;
     }
+    ENGINE_TRACE_SCOPE("RenderFrame");
 
-    const int64_t previousTime = lastFrameTime_.exchange(frameTimeNanos, std::memory_order_relaxed);
-    if (previousTime > 0) {
-        const float deltaMs = static_cast<float>(frameTimeNanos - previousTime) / 1'000'000.0f;
-        frameTimeMs_.store(deltaMs, std::memory_order_relaxed);
+    // The gap after an idle period is not a frame time.
+    if (lastFrameTime_ > 0 && idleSinceNanos_ == 0) {
+        const float deltaMs = static_cast<float>(frameTimeNanos - lastFrameTime_) / 1'000'000.0f;
+        frameStats_.frameTimeMs = deltaMs;
         if (deltaMs > 0.0f) {
-            fps_.store(1000.0f / deltaMs, std::memory_order_relaxed);
+            frameStats_.fps = 1000.0f / deltaMs;
+        }
+        frameIntervals_.Add(deltaMs);
+
+        // Janky: shown at least a refresh after the paced interval. Before
+        // the first vsync estimate, half the requested frame time over.
+        const float requestedMs = 1000.0f / static_cast<float>(std::max(1, preferredFps_.load()));
+        const float periodMs = frameStats_.vsyncPeriodMs > 0.0f ? frameStats_.vsyncPeriodMs : requestedMs;
+        const float expectedMs = frameStats_.vsyncPeriodMs > 0.0f ? periodMs * frameStats_.swapInterval : requestedMs;
+        if (deltaMs > expectedMs + periodMs * 0.5f) {
+            ++frameStats_.jankFrames;
+        }
+    }
+    lastFrameTime_ = frameTimeNanos;
+    ++frameStats_.frameCount;
+
+    if (idleSinceNanos_ > 0) {
+        // Ticks skipped while idle, at the rate frames are requested.
+        const int64_t idleNanos = NowNanos() - idleSinceNanos_;
+        frameStats_.idleFrames += static_cast<int32_t>(idleNanos * preferredFps_.load() / 1'000'000'000);
+        frameStats_.renderIdle = false;
+        idleSinceNanos_ = 0;
+    }
+    const uint64_t wakeCount = wakeCount_.load();
+    const bool woken = wakeCount != frameWakeCount_;
+    frameWakeCount_ = wakeCount;
+
+    const int64_t workStartNanos = NowNanos();
+    const int64_t oldestInputNanos = ApplyPendingInput();
+    scene_.BeginFrame(&frameStats_);
+    scene_.Render(camera_, width_, height_, &frameStats_);
+
+    const int64_t swapStartNanos = NowNanos();
+    bool swapped;
+    {
+        ENGINE_TRACE_SCOPE("SwapBuffers");
+        if (frame.presentNanos > 0) {
+            egl_.SetPresentationTime(frame.presentNanos);
         }
+        swapped = egl_.SwapBuffers();
+    }
+    if (!swapped) {
+        // Context lost: everything created in it is gone, so rebuild the
+        // context and resources against the same window.
+        ANativeWindow* window = window_;
+        ANativeWindow_acquire(window);
+        DestroyContextOnRenderThread();
+        AttachSurface(window, NowNanos());
+        ANativeWindow_release(window);
+        return;
+    }
+    cpuTimes_.Add(static_cast<float>(swapStartNanos - workStartNanos) / 1'000'000.0f);
+    swapTimes_.Add(static_cast<float>(NowNanos() - swapStartNanos) / 1'000'000.0f);
+    frameStats_.frameInterval = frameIntervals_.Summarize();
+    frameStats_.cpuTime = cpuTimes_.Summarize();
+    frameStats_.swapTime = swapTimes_.Summarize();
+    const float slowestMs = frameIntervals_.SlowestMeanMs(1.0f);
+    frameStats_.lowFps = slowestMs > 0.0f ? 1000.0f / slowestMs : 0.0f;
+
+    const bool resumed = resumeStartNanos_ > 0;
+    if (resumed) {
+        // SetSurface until the first frame on the new surface has been queued.
+        frameStats_.resumeToFirstFrameMs = static_cast<float>(NowNanos() - resumeStartNanos_) / 1'000'000.0f;
+        resumeStartNanos_ = 0;
+        __android_log_print(ANDROID_LOG_INFO, kTag, "Resume to first frame: %.2f ms (%s context)",
+                            frameStats_.resumeToFirstFrameMs, frameStats_.contextPreserved ? "preserved" : "new");
     }
-    frameCounter_.fetch_add(1, std::memory_order_relaxed);
 
-    glViewport(0, 0, width_, height_);
-    glEnable(GL_DEPTH_TEST);
-    glClearColor(0.04f, 0.05f, 0.07f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // Render thread time up to the queued swap. A GPU that cannot keep up
+    // shows here too, as eglSwapBuffers waiting for a free buffer.
+    const float workMs = static_cast<float>(NowNanos() - workStartNanos) / 1'000'000.0f;
+    float budgetMs = 1000.0f / static_cast<float>(std::max(1, preferredFps_.load()));
+    {
+        std::scoped_lock lock(pacerMutex_);
+        pacer_.OnFrameQueued(frame);
+        const FramePacer::Stats& pacing = pacer_.GetStats();
+        const int64_t periodNanos = pacer_.VsyncPeriodNanos();
+        if (periodNanos > 0) {
+            // Each frame owns SwapInterval() refreshes.
+            budgetMs = static_cast<float>(periodNanos * pacer_.SwapInterval()) / 1'000'000.0f;
+        }
+        frameStats_.vsyncPeriodMs = static_cast<float>(periodNanos) / 1'000'000.0f;
+        frameStats_.swapInterval = pacer_.SwapInterval();
+        frameStats_.missedDeadlines = static_cast<int32_t>(pacing.missedDeadlines);
+    }
+    scene_.UpdateResolution(workMs, budgetMs);
+    ENGINE_TRACE_COUNTER("cpuMs", workMs);
+    ENGINE_TRACE_COUNTER("jankFrames", frameStats_.jankFrames);
+
+    if (oldestInputNanos > 0) {
+        // Input-to-present: oldest command applied this frame until the swap
+        // that shows it has been queued.
+        frameStats_.inputLatencyMs = static_cast<float>(NowNanos() - oldestInputNanos) / 1'000'000.0f;
+    }
 
-    glUseProgram(shader_.Id());
+    // Anything that can still change the picture keeps frames coming.
+    const uint64_t cameraVersion = camera_.Version();
+    const bool changed = woken || oldestInputNanos > 0 || cameraVersion != lastCameraVersion_ ||
+                         frameStats_.assetsPending > 0 || resumed;
+    lastCameraVersion_ = cameraVersion;
+    UpdateIdleState(changed);
 
-    const Mat4 model = Mat4::Identity();
-    const Mat4 view = camera_.ViewMatrix();
-    const Mat4 proj = camera_.ProjectionMatrix();
-    const Mat4 viewProj = Multiply(proj, view);
+    PublishFrameDiagnostics();
+}
 
-    glUniformMatrix4fv(uViewProj_, 1, GL_FALSE, viewProj.Ptr());
-    glUniformMatrix4fv(uModel_, 1, GL_FALSE, model.Ptr());
+void EngineRenderer::UpdateIdleState(bool changed) {
+    quietFrames_ = changed ? 0 : quietFrames_ + 1;
+    if (!renderOnDemand_.load() || quietFrames_ < kIdleAfterQuietFrames || idle_.load()) {
+        return;
+    }
 
-    const Vec3 eye = camera_.EyePosition();
-    glUniform3f(uCameraPos_, eye.x, eye.y, eye.z);
+    idle_.store(true);
+    idleSinceNanos_ = NowNanos();
+    frameStats_.renderIdle = true;
+    // A wake that bumped wakeCount_ before idle_ was set saw idle_ false and
+    // did not re-arm; take that wake over.
+    if (wakeCount_.load() != frameWakeCount_ && idle_.exchange(false)) {
+        ScheduleNextFrame();
+    }
+}
 
-    gridPlane_.Draw();
+void EngineRenderer::ResetFrameStats() {
+    lastFrameTime_ = 0;
+    frameStats_.fps = 0.0f;
+    frameStats_.frameTimeMs = 0.0f;
+    frameStats_.frameCount = 0;
+    frameStats_.idleFrames = 0;
+    frameStats_.renderIdle = false;
+    frameStats_.missedDeadlines = 0;
+    frameStats_.jankFrames = 0;
+    frameStats_.lowFps = 0.0f;
+    frameStats_.frameInterval = {};
+    frameStats_.cpuTime = {};
+    frameStats_.swapTime = {};
+    frameIntervals_.Reset();
+    cpuTimes_.Reset();
+    swapTimes_.Reset();
+    {
+        std::scoped_lock lock(pacerMutex_);
+        pacer_.ResetStats();
+    }
+    idleSinceNanos_ = 0;
+    quietFrames_ = 0;
+    PublishFrameDiagnostics();
+}
 
-    egl_.SwapBuffers();
+void EngineRenderer::PublishFrameDiagnostics() {
+    frameStats_.surfaceWidth = width_;
+    frameStats_.surfaceHeight = height_;
+    frameStats_.droppedInputCount = static_cast<int32_t>(input_.DroppedCount());
+    publishedFrame_.Store(frameStats_);
 }
 
-void EngineRenderer::FrameCallback(long frameTimeNanos, void* data) {
+void EngineRenderer::FrameCallback(int64_t frameTimeNanos, void* data) {
     auto* renderer = reinterpret_cast<EngineRenderer*>(data);
     if (!renderer) {
         return;
     }
-    renderer->RenderFrame(frameTimeNanos);
-    renderer->ScheduleNextFrame();
+    // Runs on the Choreographer (main) looper: pace the tick and hand it,
+    // and the re-arm, to the render thread; no GL work here. An idle
+    // renderer lets the callback lapse; RequestRender arms a new one.
+    renderer->frameCallbackArmed_.store(false);
+    if (renderer->idle_.load()) {
+        return;
+    }
+    renderer->PostFrame(frameTimeNanos);
+    renderer->PostTask([renderer]() { renderer->ScheduleNextFrame(); });
 }
 
 void EngineRenderer::ScheduleNextFrame() {
@@ -299,24 +590,27 @@ void EngineRenderer::ScheduleNextFrame() {
     }
 
 #if __ANDROID_API__ >= 24
-    AChoreographer* choreographer = AChoreographer_getInstance();
-    if (choreographer) {
-        AChoreographer_postFrameCallback64(choreographer, FrameCallback, this);
+    // The one Start found on its looper; posting to it from another thread
+    // is safe. Without one, the fallback loop paces frames instead.
+    if (AChoreographer* choreographer = choreographer_.load()) {
+        if (!frameCallbackArmed_.exchange(true)) {
+            AChoreographer_postFrameCallback64(choreographer, FrameCallback, this);
+        }
         return;
     }
 #endif
 
-    StartFallbackLoopLocked();
+    StartFallbackLoop();
 }
 
-void EngineRenderer::StartFallbackLoopLocked() {
+void EngineRenderer::StartFallbackLoop() {
     bool expected = false;
     if (fallbackThreadRunning_.compare_exchange_strong(expected, true)) {
         fallbackThread_ = std::thread([this]() { FallbackLoop(); });
     }
 }
 
-void EngineRenderer::StopFallbackLoopLocked() {
+void EngineRenderer::StopFallbackLoop() {
     bool expected = true;
     if (fallbackThreadRunning_.compare_exchange_strong(expected, false)) {
         if (fallbackThread_.joinable()) {
@@ -326,20 +620,19 @@ void EngineRenderer::StopFallbackLoopLocked() {
 }
 
 void EngineRenderer::FallbackLoop() {
+    ENGINE_TRACE_THREAD_NAME("FrameFallback");
     using namespace std::chrono;
     auto interval = nanoseconds(1'000'000'000 / std::max(1, preferredFps_.load()));
     auto nextTick = steady_clock::now() + interval;
 
     while (fallbackThreadRunning_.load(std::memory_order_relaxed)) {
-        if (!isRunning_) {
+        if (!isRunning_ || idle_) {
             std::this_thread::sleep_for(milliseconds(4));
             nextTick = steady_clock::now() + interval;
             continue;
         }
 
-        const auto now = steady_clock::now();
-        const auto nanos = duration_cast<nanoseconds>(now.time_since_epoch()).count();
-        FrameCallback(static_cast<long>(nanos), this);
+        PostFrame(NowNanos());
 
         interval = nanoseconds(1'000'000'000 / std::max(1, preferredFps_.load()));
         nextTick += interval;
@@ -357,17 +650,10 @@ void EngineRenderer::FillDiagnostics(DiagnosticsSnapshot* outSnapshot) const {
         return;
     }
 
-    outSnapshot->fps = fps_.load(std::memory_order_relaxed);
-    outSnapshot->frameTimeMs = frameTimeMs_.load(std::memory_order_relaxed);
-    outSnapshot->frameCount = frameCounter_.load(std::memory_order_relaxed);
-    outSnapshot->eglReady = egl_.IsValid();
-
-    std::scoped_lock lock(mutex_);
-    outSnapshot->surfaceWidth = width_;
-    outSnapshot->surfaceHeight = height_;
-    std::snprintf(outSnapshot->gpuRenderer, sizeof(outSnapshot->gpuRenderer), "%s", gpuRenderer_.data());
-    std::snprintf(outSnapshot->gpuVendor, sizeof(outSnapshot->gpuVendor), "%s", gpuVendor_.data());
-    std::snprintf(outSnapshot->gpuVersion, sizeof(outSnapshot->gpuVersion), "%s", gpuVersion_.data());
+    // Wait-free for the render thread; a reader that races a publish just
+    // retries its copy.
+    static_cast<FrameDiagnostics&>(*outSnapshot) = publishedFrame_.Load();
+    static_cast<GpuDiagnostics&>(*outSnapshot) = publishedGpu_.Load();
 }
 
 }  // namespace engine
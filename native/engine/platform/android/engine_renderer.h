@@ -1,19 +1,30 @@
 #pragma once
 
 #include <atomic>
-#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include <android/asset_manager.h>
+#include <android/choreographer.h>
 #include <android/native_window.h>
 #include <android/native_window_jni.h>
 
 #include "engine/core/camera.h"
 #include "engine/platform/android/egl_context.h"
-#include "engine/core/grid_plane.h"
 #include "engine/core/diagnostics.h"
+#include "engine/core/frame_pacer.h"
+#include "engine/core/frame_time_histogram.h"
+#include "engine/core/input_queue.h"
 #include "engine/core/math_types.h"
-#include "engine/core/shader_program.h"
+#include "engine/core/program_binary_cache.h"
+#include "engine/core/scene_renderer.h"
+#include "engine/core/seqlock.h"
 
 namespace engine {
 
@@ -32,6 +43,25 @@ public:
     void Zoom(float scaleDelta);
 
     void SetPreferredFrameRate(int fps);
+    // Directory for cached program binaries; must exist. Takes effect the next
+    // time GL resources are created.
+    void SetCacheDirectory(const char* path);
+
+    // Directory for cooked models, keyed by source content; must exist.
+    // Models requested afterwards skip decoding when their source is cached.
+    void SetAssetCacheDirectory(const char* path);
+    // APK asset manager used by LoadModel for relative paths. The Java object
+    // behind it must outlive the renderer (the application's AssetManager).
+    void SetAssetManager(AAssetManager* assets);
+    // Streams a .glb or cooked .cwm in the background; parts appear once
+    // uploaded. Relative paths are APK assets, absolute ones files.
+    void LoadModel(const char* path);
+
+    // With render on demand (the default) frames stop once input, streaming
+    // and surface changes have settled, and resume on the next one. Anything
+    // else that changes the picture calls RequestRender. Any thread.
+    void SetRenderOnDemand(bool enabled);
+    void RequestRender();
 
     void Start();
     void Stop();
@@ -39,49 +69,110 @@ public:
     void FillDiagnostics(DiagnosticsSnapshot* outSnapshot) const;
 
 private:
-    void InitializeGlResourcesLocked();
-    void DestroyGlResourcesLocked();
-    void ClearSurfaceLocked();
-
-    void RenderFrame(int64_t frameTimeNanos);
-    static void FrameCallback(long frameTimeNanos, void* data);
-
+    // Everything below that touches egl_ or GL objects runs on the render
+    // thread, which owns the EGL context for the renderer's whole lifetime.
+    void RenderThreadMain();
+    void PostTask(std::function<void()> task);
+    bool RunOnRenderThread(const std::function<bool()>& task);
+    // Every vsync tick goes through the pacer; the ticks it picks are
+    // handed to the render thread.
+    void PostFrame(int64_t vsyncNanos);
+
+    bool AttachSurface(ANativeWindow* window, int64_t requestedNanos);
+    bool InitializeGlResources();
+    void DestroyGlResources();
+    void ReleaseSurfaceOnRenderThread();
+    void DestroyContextOnRenderThread();
+    int64_t ApplyPendingInput();
+    void ResetFrameStats();
+    void PublishFrameDiagnostics();
+    void UpdateIdleState(bool changed);
+
+    void RenderFrame(const FramePacer::Frame& frame);
+    static void FrameCallback(int64_t frameTimeNanos, void* data);
+
+    // Render thread only, like the Choreographer and fallback loop state
+    // they touch; other threads post them.
     void ScheduleNextFrame();
-    void StartFallbackLoopLocked();
-    void StopFallbackLoopLocked();
+    void StartFallbackLoop();
+    void StopFallbackLoop();
     void FallbackLoop();
 
-    bool isRunning_{false};
+    std::atomic_bool isRunning_{false};
 
-    mutable std::mutex mutex_;
     ANativeWindow* window_{nullptr};
 
     EglContext egl_{};
     OrbitCamera camera_{};
-    ShaderProgram shader_{};
-    GridPlane gridPlane_{};
+    ProgramBinaryCache programCache_{};
+    int64_t resumeStartNanos_{0};
 
-    GLint uViewProj_{-1};
-    GLint uModel_{-1};
-    GLint uCameraPos_{-1};
+    std::atomic<AAssetManager*> assetManager_{nullptr};
 
     int width_{0};
     int height_{0};
 
     std::atomic<int> preferredFps_{60};
 
-    // Timing
-    std::atomic<int64_t> lastFrameTime_{0};
-    std::atomic<float> fps_{0.0f};
-    std::atomic<float> frameTimeMs_{0.0f};
-    std::atomic<int32_t> frameCounter_{0};
-
-    std::array<char, 128> gpuRenderer_{};
-    std::array<char, 128> gpuVendor_{};
-    std::array<char, 128> gpuVersion_{};
+    // Fed by the Choreographer looper (or the fallback loop) with every
+    // tick, so its period estimate never sees the ticks the render thread
+    // coalesces; the render thread reports queued swaps back.
+    std::mutex pacerMutex_;
+    FramePacer pacer_{};
+
+    // Render on demand. While idle_ the Choreographer callback is not
+    // re-armed and the fallback loop posts nothing; RequestRender bumps
+    // wakeCount_ and re-arms. frameCallbackArmed_ keeps one callback in
+    // flight however many wakes arrive. The Choreographer is captured on the
+    // looper thread that called Start; only the render thread arms it.
+    std::atomic_bool renderOnDemand_{true};
+    std::atomic_bool idle_{false};
+    std::atomic_bool frameCallbackArmed_{false};
+    std::atomic<uint64_t> wakeCount_{0};
+    std::atomic<AChoreographer*> choreographer_{nullptr};
+    // Render thread: what the last frame saw, to tell whether the next one
+    // changes anything.
+    uint64_t frameWakeCount_{0};
+    uint64_t lastCameraVersion_{0};
+    int quietFrames_{0};
+    int64_t idleSinceNanos_{0};
+
+    // Input is queued lock-free by JNI/FFI callers and applied on the render
+    // thread once per frame. The latest viewport size is packed into one
+    // atomic (see PackViewport) so a resize is never dropped.
+    InputCommandQueue input_{};
+    std::atomic<uint64_t> pendingViewport_{0};
+
+    // Timing and counters, owned by the render thread and published once per
+    // frame. FillDiagnostics only reads the seqlocks, so polling diagnostics
+    // from the UI never contends with rendering.
+    int64_t lastFrameTime_{0};
+    // The last few seconds of frame intervals, render thread time to the
+    // swap and swap time, summarised into frameStats_ every frame.
+    FrameTimeHistogram frameIntervals_{};
+    FrameTimeHistogram cpuTimes_{};
+    FrameTimeHistogram swapTimes_{};
+    FrameDiagnostics frameStats_{};
+    SeqLock<FrameDiagnostics> publishedFrame_{};
+    SeqLock<GpuDiagnostics> publishedGpu_{};
+
+    // Grid, models and how they are drawn. The context and everything
+    // created in it outlive surface loss; only the renderer's destruction or
+    // a lost context tears them down. Declared late so the decoding workers
+    // are joined before anything else in the renderer is torn down.
+    SceneRenderer scene_{};
 
     std::thread fallbackThread_;
     std::atomic_bool fallbackThreadRunning_{false};
+
+    // Render thread message queue: one-off tasks (surface changes) plus the
+    // latest pending vsync tick from Choreographer or the fallback loop.
+    std::thread renderThread_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::deque<std::function<void()>> tasks_;
+    FramePacer::Frame pendingFrame_{};
+    bool quitRequested_{false};
 };
 
 }  // namespace engine
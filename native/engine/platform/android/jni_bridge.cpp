@@ -1,10 +1,13 @@
 #include <jni.h>
 
+#include <android/asset_manager_jni.h>
 #include <android/native_window_jni.h>
 #include <android/log.h>
 #include <new>
 #include <cstdint>
+#include <string>
 
+#include "engine/core/trace.h"
 #include "engine/platform/android/engine_renderer.h"
 
 namespace {
@@ -118,10 +121,42 @@ Java_com_example_cylinderworks_engine_NativeBridge_nativeGetDiagnostics(JNIEnv*
 
     putDouble("fps", snapshot.fps);
     putDouble("frameTimeMs", snapshot.frameTimeMs);
+    putInt("drawCalls", snapshot.drawCalls);
     putInt("surfaceWidth", snapshot.surfaceWidth);
     putInt("surfaceHeight", snapshot.surfaceHeight);
     putInt("frameCount", snapshot.frameCount);
     putBool("eglReady", snapshot.eglReady ? JNI_TRUE : JNI_FALSE);
+    putDouble("inputLatencyMs", snapshot.inputLatencyMs);
+    putInt("droppedInputCount", snapshot.droppedInputCount);
+    putDouble("resumeToFirstFrameMs", snapshot.resumeToFirstFrameMs);
+    putBool("contextPreserved", snapshot.contextPreserved ? JNI_TRUE : JNI_FALSE);
+    putInt("shaderCacheHits", snapshot.shaderCacheHits);
+    putInt("shaderCacheMisses", snapshot.shaderCacheMisses);
+    putDouble("shaderBuildMs", snapshot.shaderBuildMs);
+    putInt("trianglesSubmitted", snapshot.trianglesSubmitted);
+    putInt("instancesCulled", snapshot.instancesCulled);
+    putInt("assetsPending", snapshot.assetsPending);
+    putDouble("uploadMs", snapshot.uploadMs);
+    putInt("glStateIssued", snapshot.glStateIssued);
+    putInt("glStateElided", snapshot.glStateElided);
+    putInt("idleFrames", snapshot.idleFrames);
+    putBool("renderIdle", snapshot.renderIdle ? JNI_TRUE : JNI_FALSE);
+    putDouble("renderScale", snapshot.renderScale);
+    putDouble("vsyncPeriodMs", snapshot.vsyncPeriodMs);
+    putInt("swapInterval", snapshot.swapInterval);
+    putInt("missedDeadlines", snapshot.missedDeadlines);
+    auto putFrameTimes = [&](const char* prefix, const engine::FrameTimeStats& stats) {
+        const std::string name(prefix);
+        putDouble((name + "P50Ms").c_str(), stats.p50Ms);
+        putDouble((name + "P90Ms").c_str(), stats.p90Ms);
+        putDouble((name + "P99Ms").c_str(), stats.p99Ms);
+        putDouble((name + "MaxMs").c_str(), stats.maxMs);
+    };
+    putFrameTimes("frameInterval", snapshot.frameInterval);
+    putFrameTimes("cpuTime", snapshot.cpuTime);
+    putFrameTimes("swapTime", snapshot.swapTime);
+    putInt("jankFrames", snapshot.jankFrames);
+    putDouble("lowFps", snapshot.lowFps);
     putString("gpuRenderer", snapshot.gpuRenderer);
     putString("gpuVendor", snapshot.gpuVendor);
     putString("gpuVersion", snapshot.gpuVersion);
@@ -234,6 +269,57 @@ Java_com_example_cylinderworks_engine_NativeBridge_nativeSetPreferredFps(JNIEnv*
     renderer->SetPreferredFrameRate(fps);
 }
 
+JNIEXPORT void JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeSetCacheDirectory(JNIEnv* env, jclass /*clazz*/, jlong handle, jstring path) {
+    auto* renderer = FromHandle(handle);
+    if (!renderer || !path) {
+        return;
+    }
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return;
+    }
+    renderer->SetCacheDirectory(chars);
+    env->ReleaseStringUTFChars(path, chars);
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeSetAssetCacheDirectory(JNIEnv* env, jclass /*clazz*/, jlong handle, jstring path) {
+    auto* renderer = FromHandle(handle);
+    if (!renderer || !path) {
+        return;
+    }
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return;
+    }
+    renderer->SetAssetCacheDirectory(chars);
+    env->ReleaseStringUTFChars(path, chars);
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeSetAssetManager(JNIEnv* env, jclass /*clazz*/, jlong handle, jobject assetManager) {
+    auto* renderer = FromHandle(handle);
+    if (!renderer || !assetManager) {
+        return;
+    }
+    renderer->SetAssetManager(AAssetManager_fromJava(env, assetManager));
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeLoadModel(JNIEnv* env, jclass /*clazz*/, jlong handle, jstring path) {
+    auto* renderer = FromHandle(handle);
+    if (!renderer || !path) {
+        return;
+    }
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return;
+    }
+    renderer->LoadModel(chars);
+    env->ReleaseStringUTFChars(path, chars);
+}
+
 JNIEXPORT void JNICALL
 Java_com_example_cylinderworks_engine_NativeBridge_nativeClearSurface(JNIEnv* env, jclass /*clazz*/, jlong handle) {
     auto* renderer = FromHandle(handle);
@@ -243,6 +329,30 @@ Java_com_example_cylinderworks_engine_NativeBridge_nativeClearSurface(JNIEnv* en
     renderer->ClearSurface();
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeStartTrace(JNIEnv* env, jclass /*clazz*/) {
+    return engine::trace::Start() ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeStopTrace(JNIEnv* env, jclass /*clazz*/) {
+    engine::trace::Stop();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_example_cylinderworks_engine_NativeBridge_nativeDumpTrace(JNIEnv* env, jclass /*clazz*/, jstring path) {
+    if (!path) {
+        return JNI_FALSE;
+    }
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return JNI_FALSE;
+    }
+    const bool written = engine::trace::WriteChromeJson(chars);
+    env->ReleaseStringUTFChars(path, chars);
+    return written ? JNI_TRUE : JNI_FALSE;
+}
+
 }  // extern "C"
 
 extern "C" {
@@ -318,4 +428,21 @@ void engine_renderer_stop(int64_t handle) {
     renderer->Stop();
 }
 
+// Tracing is process-wide, so these take no renderer handle. They return 0
+// when the library was built without ENGINE_TRACE.
+int engine_trace_start() {
+    return engine::trace::Start() ? 1 : 0;
+}
+
+void engine_trace_stop() {
+    engine::trace::Stop();
+}
+
+int engine_trace_dump(const char* path) {
+    if (!path) {
+        return 0;
+    }
+    return engine::trace::WriteChromeJson(path) ? 1 : 0;
+}
+
 }  // extern "C"
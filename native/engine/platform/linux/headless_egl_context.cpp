@@ -0,0 +1,149 @@
+#include "engine/platform/linux/headless_egl_context.h"
+
+#include <EGL/eglext.h>
+
+#include "engine/core/log.h"
+
+namespace engine {
+
+namespace {
+constexpr const char* kTag = "EngineRenderer";
+
+void LogEglError(const char* message) {
+    const EGLint error = eglGetError();
+    ENGINE_LOGE(kTag, "%s (0x%x)", message, error);
+}
+
+EGLDisplay GetDisplay() {
+    // Mesa's surfaceless platform needs no display server; fall back to the
+    // default display (X11 or a vendor driver) elsewhere.
+    const auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        const EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY) {
+            return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+EGLConfig ChooseConfig(EGLDisplay display) {
+    // The same buffer layout as the Android window config.
+    const EGLint attribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_BLUE_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_RED_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_STENCIL_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, attribs, &config, 1, &numConfigs) || numConfigs <= 0) {
+        LogEglError("eglChooseConfig failed");
+        return nullptr;
+    }
+    return config;
+}
+
+}  // namespace
+
+HeadlessEglContext::~HeadlessEglContext() {
+    Destroy();
+}
+
+bool HeadlessEglContext::Initialize(int width, int height) {
+    Destroy();
+
+    display_ = GetDisplay();
+    if (display_ == EGL_NO_DISPLAY) {
+        LogEglError("Failed to get EGL display");
+        return false;
+    }
+    if (!eglInitialize(display_, nullptr, nullptr)) {
+        LogEglError("Failed to initialize EGL");
+        display_ = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    const EGLConfig config = ChooseConfig(display_);
+    if (!config) {
+        Destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 3,
+        EGL_NONE
+    };
+    context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context_ == EGL_NO_CONTEXT) {
+        LogEglError("Failed to create EGL context");
+        Destroy();
+        return false;
+    }
+
+    const EGLint surfaceAttribs[] = {
+        EGL_WIDTH, width,
+        EGL_HEIGHT, height,
+        EGL_NONE
+    };
+    surface_ = eglCreatePbufferSurface(display_, config, surfaceAttribs);
+    if (surface_ == EGL_NO_SURFACE) {
+        LogEglError("Failed to create pbuffer surface");
+        Destroy();
+        return false;
+    }
+    if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
+        LogEglError("eglMakeCurrent failed");
+        Destroy();
+        return false;
+    }
+
+    if (!eglQuerySurface(display_, surface_, EGL_WIDTH, &width_) ||
+        !eglQuerySurface(display_, surface_, EGL_HEIGHT, &height_)) {
+        LogEglError("Failed to query pbuffer size");
+    }
+    return true;
+}
+
+void HeadlessEglContext::Destroy() {
+    if (display_ != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (surface_ != EGL_NO_SURFACE) {
+            eglDestroySurface(display_, surface_);
+        }
+        if (context_ != EGL_NO_CONTEXT) {
+            eglDestroyContext(display_, context_);
+        }
+        eglTerminate(display_);
+    }
+    display_ = EGL_NO_DISPLAY;
+    surface_ = EGL_NO_SURFACE;
+    context_ = EGL_NO_CONTEXT;
+    width_ = 0;
+    height_ = 0;
+}
+
+bool HeadlessEglContext::SwapBuffers() {
+    if (display_ == EGL_NO_DISPLAY || surface_ == EGL_NO_SURFACE) {
+        return true;
+    }
+    if (!eglSwapBuffers(display_, surface_)) {
+        const EGLint error = eglGetError();
+        if (error == EGL_CONTEXT_LOST) {
+            ENGINE_LOGW(kTag, "EGL context lost");
+            return false;
+        }
+        ENGINE_LOGE(kTag, "eglSwapBuffers failed (0x%x)", error);
+    }
+    return true;
+}
+
+}  // namespace engine
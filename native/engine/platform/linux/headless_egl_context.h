@@ -0,0 +1,42 @@
+#pragma once
+
+#include <EGL/egl.h>
+
+namespace engine {
+
+// Off-screen EGL/GLES 3 context for Linux: a width x height pbuffer, on
+// Mesa's surfaceless platform when available so no X or Wayland server is
+// needed (llvmpipe renders without a GPU). The pbuffer is the default
+// framebuffer, so frames go through the same path as a window surface,
+// upscaling blit included.
+class HeadlessEglContext {
+public:
+    HeadlessEglContext() = default;
+    ~HeadlessEglContext();
+
+    HeadlessEglContext(const HeadlessEglContext&) = delete;
+    HeadlessEglContext& operator=(const HeadlessEglContext&) = delete;
+
+    // Leaves the context current on the calling thread.
+    bool Initialize(int width, int height);
+    void Destroy();
+
+    bool IsValid() const { return display_ != EGL_NO_DISPLAY && surface_ != EGL_NO_SURFACE && context_ != EGL_NO_CONTEXT; }
+
+    // A no-op for the image on a pbuffer, but it still ends the frame for the
+    // driver. Returns false if the context was lost.
+    bool SwapBuffers();
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+private:
+    EGLDisplay display_{EGL_NO_DISPLAY};
+    EGLSurface surface_{EGL_NO_SURFACE};
+    EGLContext context_{EGL_NO_CONTEXT};
+
+    int width_{0};
+    int height_{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,386 @@
+// Headless Linux backend: renders the scene off-screen through SceneRenderer,
+// the same render path EngineRenderer drives on Android, for a fixed number
+// of frames and reports frame-time statistics.
+//
+//   engine_headless [options] [model ...]
+//     --frames N      measured frames (default 300)
+//     --size WxH      pbuffer size (default 1280x720)
+//     --scale S       fixed render scale in [0.5, 1] (default 1)
+//     --budget MS     let dynamic resolution follow a frame budget of MS
+//                     instead of a fixed scale (timing dependent, so images
+//                     are not repeatable)
+//     --orbit D       camera yaw per frame, in OrbitCamera::Orbit units
+//                     (default 20)
+//     --checksum      hash every frame's image (FNV-1a over RGBA8)
+//     --json FILE     also write the results to FILE as JSON
+//     --cache DIR     program binary and cooked asset cache directory
+//     --trace FILE    record the whole run, from shader compilation on, as
+//                     Chrome trace JSON (needs -DENGINE_TRACE=ON)
+//
+// Models are .glb or cooked .cwm files; the default is the model the app
+// opens, assets/3d/Assem1.glb. Frames are rendered until every model is
+// uploaded before measuring starts. The camera path and, with a fixed scale,
+// the images are the same on every run, so checksums from one driver can be
+// compared across builds.
+//
+// Each frame is timed in two parts: `cpu` covers BeginFrame and Render (what
+// the render thread spends before the swap on a device), `frame` adds
+// glFinish and the swap, so it includes rasterisation (on the CPU with
+// llvmpipe). Image readback for --checksum is not timed.
+//
+// Exits non-zero if the context or shaders cannot be created, a model is not
+// drawn, or GL reports an error.
+
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "engine/core/asset_streamer.h"
+#include "engine/core/camera.h"
+#include "engine/core/diagnostics.h"
+#include "engine/core/gl_state_cache.h"
+#include "engine/core/program_binary_cache.h"
+#include "engine/core/scene_renderer.h"
+#include "engine/core/trace.h"
+#include "engine/platform/linux/headless_egl_context.h"
+
+namespace {
+
+using engine::FrameDiagnostics;
+
+// Frames rendered before measuring, at least, and how long streaming may take.
+constexpr int kWarmupFrames = 10;
+constexpr double kWarmupTimeoutSeconds = 60.0;
+constexpr uint64_t kAssetCacheBytes = 128ull * 1024 * 1024;
+
+struct Options {
+    int frames{300};
+    int width{1280};
+    int height{720};
+    float scale{1.0f};
+    float budgetMs{0.0f};
+    float orbit{20.0f};
+    bool checksum{false};
+    std::string jsonPath;
+    std::string cacheDirectory;
+    std::string tracePath;
+    std::vector<std::string> models;
+};
+
+struct Summary {
+    double min{0.0};
+    double mean{0.0};
+    double p50{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    double max{0.0};
+};
+
+struct FrameRecord {
+    float cpuMs{0.0f};
+    float frameMs{0.0f};
+    float renderScale{1.0f};
+    uint64_t checksum{0};
+};
+
+int64_t NowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+float MillisecondsSince(int64_t startNanos) {
+    return static_cast<float>(NowNanos() - startNanos) / 1'000'000.0f;
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto takes = [&](const char* name) {
+            if (std::strcmp(arg, name) != 0) {
+                return false;
+            }
+            if (!value) {
+                std::fprintf(stderr, "%s needs a value\n", name);
+                std::exit(2);
+            }
+            ++i;
+            return true;
+        };
+        if (takes("--frames")) {
+            options->frames = std::atoi(value);
+        } else if (takes("--size")) {
+            if (std::sscanf(value, "%dx%d", &options->width, &options->height) != 2) {
+                std::fprintf(stderr, "--size expects WxH, got %s\n", value);
+                return false;
+            }
+        } else if (takes("--scale")) {
+            options->scale = std::strtof(value, nullptr);
+        } else if (takes("--budget")) {
+            options->budgetMs = std::strtof(value, nullptr);
+        } else if (takes("--orbit")) {
+            options->orbit = std::strtof(value, nullptr);
+        } else if (takes("--json")) {
+            options->jsonPath = value;
+        } else if (takes("--cache")) {
+            options->cacheDirectory = value;
+        } else if (takes("--trace")) {
+            options->tracePath = value;
+        } else if (std::strcmp(arg, "--checksum") == 0) {
+            options->checksum = true;
+        } else if (arg[0] == '-') {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        } else {
+            options->models.emplace_back(arg);
+        }
+    }
+    if (options->models.empty()) {
+        options->models.emplace_back(std::string(ENGINE_ASSETS_DIR) + "/Assem1.glb");
+    }
+    if (options->frames <= 0 || options->width <= 0 || options->height <= 0 || options->scale < 0.5f ||
+        options->scale > 1.0f) {
+        std::fprintf(stderr, "Frames and size must be positive and the scale in [0.5, 1]\n");
+        return false;
+    }
+    return true;
+}
+
+Summary Summarize(std::vector<float> values) {
+    Summary summary;
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    // Nearest rank.
+    auto percentile = [&values](double p) {
+        const std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(values.size()) + 0.5);
+        return static_cast<double>(values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)]);
+    };
+    double total = 0.0;
+    for (const float value : values) {
+        total += value;
+    }
+    summary.min = values.front();
+    summary.mean = total / static_cast<double>(values.size());
+    summary.p50 = percentile(0.50);
+    summary.p90 = percentile(0.90);
+    summary.p99 = percentile(0.99);
+    summary.max = values.back();
+    return summary;
+}
+
+// FNV-1a over the default framebuffer's RGBA8 pixels.
+uint64_t ImageChecksum(int width, int height, std::vector<uint8_t>* pixels) {
+    engine::GlStateCache::Current().BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    pixels->resize(static_cast<std::size_t>(width) * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+    uint64_t hash = 14695981039346656037ull;
+    for (const uint8_t byte : *pixels) {
+        hash = (hash ^ byte) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void PrintSummary(const char* name, const Summary& summary) {
+    std::printf("%-10s %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f\n", name, summary.min, summary.mean, summary.p50,
+                summary.p90, summary.p99, summary.max);
+}
+
+void WriteSummaryJson(std::FILE* file, const char* name, const Summary& summary) {
+    std::fprintf(file,
+                 "  \"%s\": {\"min\": %.4f, \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, "
+                 "\"max\": %.4f},\n",
+                 name, summary.min, summary.mean, summary.p50, summary.p90, summary.p99, summary.max);
+}
+
+bool WriteJson(const std::string& path, const Options& options, const char* gpu, const FrameDiagnostics& stats,
+               const std::vector<FrameRecord>& records, const Summary& cpu, const Summary& frame, double fps,
+               uint64_t runChecksum) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return false;
+    }
+    std::fprintf(file, "{\n  \"gpu\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %zu,\n", gpu,
+                 options.width, options.height, records.size());
+    std::fprintf(file, "  \"drawCalls\": %d,\n  \"trianglesSubmitted\": %d,\n  \"instancesCulled\": %d,\n",
+                 stats.drawCalls, stats.trianglesSubmitted, stats.instancesCulled);
+    std::fprintf(file, "  \"glStateIssued\": %d,\n  \"glStateElided\": %d,\n", stats.glStateIssued,
+                 stats.glStateElided);
+    std::fprintf(file, "  \"shaderBuildMs\": %.4f,\n  \"fps\": %.2f,\n", stats.shaderBuildMs, fps);
+    WriteSummaryJson(file, "cpuMs", cpu);
+    WriteSummaryJson(file, "frameMs", frame);
+    if (options.checksum) {
+        std::fprintf(file, "  \"checksum\": \"%016llx\",\n", static_cast<unsigned long long>(runChecksum));
+    }
+    std::fprintf(file, "  \"perFrame\": [\n");
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const FrameRecord& record = records[i];
+        std::fprintf(file, "    {\"cpuMs\": %.4f, \"frameMs\": %.4f, \"renderScale\": %.2f", record.cpuMs,
+                     record.frameMs, record.renderScale);
+        if (options.checksum) {
+            std::fprintf(file, ", \"checksum\": \"%016llx\"", static_cast<unsigned long long>(record.checksum));
+        }
+        std::fprintf(file, "}%s\n", i + 1 < records.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, &options)) {
+        return 2;
+    }
+
+    if (!options.tracePath.empty()) {
+        if (!engine::trace::Start()) {
+            std::fprintf(stderr, "--trace needs a build configured with -DENGINE_TRACE=ON\n");
+            return 2;
+        }
+        ENGINE_TRACE_THREAD_NAME("RenderThread");
+    }
+
+    engine::HeadlessEglContext egl;
+    if (!egl.Initialize(options.width, options.height)) {
+        std::fprintf(stderr, "No headless EGL/GLES 3 context available\n");
+        return 1;
+    }
+    const char* gpu = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+
+    engine::ProgramBinaryCache programCache;
+    engine::SceneRenderer scene;
+    if (!options.cacheDirectory.empty()) {
+        programCache.SetDirectory(options.cacheDirectory);
+        scene.Cache().Open(options.cacheDirectory, kAssetCacheBytes);
+    }
+    programCache.SetDeviceTag(gpu, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    FrameDiagnostics stats;
+    if (!scene.InitializeGl(&programCache, &stats)) {
+        return 1;
+    }
+    for (const std::string& model : options.models) {
+        scene.AddModel(model, engine::AssetStreamer::FileReader(model));
+    }
+    scene.SetFixedRenderScale(options.budgetMs > 0.0f ? 0.0f : options.scale);
+
+    engine::OrbitCamera camera;
+    camera.SetViewport(egl.Width(), egl.Height());
+
+    // As EngineRenderer::RenderFrame, minus input and pacing.
+    std::vector<uint8_t> pixels;
+    auto renderFrame = [&](FrameRecord* record) {
+        ENGINE_TRACE_SCOPE("Frame");
+        const int64_t startNanos = NowNanos();
+        scene.BeginFrame(&stats);
+        scene.Render(camera, egl.Width(), egl.Height(), &stats);
+        record->cpuMs = MillisecondsSince(startNanos);
+        {
+            ENGINE_TRACE_SCOPE("Finish");
+            glFinish();
+        }
+        const float finishMs = MillisecondsSince(startNanos);
+        if (options.checksum) {
+            record->checksum = ImageChecksum(egl.Width(), egl.Height(), &pixels);
+        }
+        const int64_t swapNanos = NowNanos();
+        bool swapped;
+        {
+            ENGINE_TRACE_SCOPE("SwapBuffers");
+            swapped = egl.SwapBuffers();
+        }
+        record->frameMs = finishMs + MillisecondsSince(swapNanos);
+        record->renderScale = stats.renderScale;
+        if (options.budgetMs > 0.0f) {
+            scene.UpdateResolution(record->frameMs, options.budgetMs);
+        }
+        return swapped;
+    };
+
+    // Streaming: render until every model is uploaded, as the app would.
+    const int64_t warmupStart = NowNanos();
+    int warmupFrames = 0;
+    for (FrameRecord record; warmupFrames < kWarmupFrames || stats.assetsPending > 0; ++warmupFrames) {
+        if (!renderFrame(&record)) {
+            return 1;
+        }
+        if (static_cast<double>(NowNanos() - warmupStart) / 1e9 > kWarmupTimeoutSeconds) {
+            std::fprintf(stderr, "Models still streaming after %.0f s\n", kWarmupTimeoutSeconds);
+            return 1;
+        }
+    }
+    const float warmupMs = MillisecondsSince(warmupStart);
+
+    std::vector<FrameRecord> records(static_cast<std::size_t>(options.frames));
+    const int64_t runStart = NowNanos();
+    for (FrameRecord& record : records) {
+        camera.Orbit(options.orbit, 0.0f);
+        if (!renderFrame(&record)) {
+            return 1;
+        }
+    }
+    const double runSeconds = static_cast<double>(NowNanos() - runStart) / 1e9;
+
+    std::vector<float> cpuTimes;
+    std::vector<float> frameTimes;
+    uint64_t runChecksum = 14695981039346656037ull;
+    for (const FrameRecord& record : records) {
+        cpuTimes.push_back(record.cpuMs);
+        frameTimes.push_back(record.frameMs);
+        for (int shift = 0; shift < 64; shift += 8) {
+            runChecksum = (runChecksum ^ ((record.checksum >> shift) & 0xffu)) * 1099511628211ull;
+        }
+    }
+    const Summary cpu = Summarize(cpuTimes);
+    const Summary frame = Summarize(frameTimes);
+    const double fps = static_cast<double>(records.size()) / runSeconds;
+
+    std::printf("%s, %dx%d, render scale %.2f, %zu model(s)\n", gpu, egl.Width(), egl.Height(), stats.renderScale,
+                options.models.size());
+    std::printf("warm-up: %d frames, %.1f ms; shaders %.2f ms (%d from cache)\n", warmupFrames, warmupMs,
+                stats.shaderBuildMs, stats.shaderCacheHits);
+    std::printf("last frame: %d draw calls, %d triangles, %d culled, GL state %d issued / %d elided\n",
+                stats.drawCalls, stats.trianglesSubmitted, stats.instancesCulled, stats.glStateIssued,
+                stats.glStateElided);
+    std::printf("%-10s %8s %8s %8s %8s %8s %8s\n", "ms", "min", "mean", "p50", "p90", "p99", "max");
+    PrintSummary("cpu", cpu);
+    PrintSummary("frame", frame);
+    std::printf("%zu frames in %.2f s: %.1f fps\n", records.size(), runSeconds, fps);
+    if (options.checksum) {
+        std::printf("checksum %016llx (first frame %016llx)\n", static_cast<unsigned long long>(runChecksum),
+                    static_cast<unsigned long long>(records.front().checksum));
+    }
+
+    bool ok = true;
+    // The grid is one draw; anything more is a model.
+    if (stats.drawCalls < 2) {
+        std::fprintf(stderr, "No model was drawn\n");
+        ok = false;
+    }
+    const GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        std::fprintf(stderr, "GL error 0x%x\n", glError);
+        ok = false;
+    }
+    if (!options.jsonPath.empty() &&
+        !WriteJson(options.jsonPath, options, gpu, stats, records, cpu, frame, fps, runChecksum)) {
+        ok = false;
+    }
+    if (!options.tracePath.empty()) {
+        engine::trace::Stop();
+        ok = engine::trace::WriteChromeJson(options.tracePath) && ok;
+    }
+    scene.DestroyGl();
+    return ok ? 0 : 1;
+}
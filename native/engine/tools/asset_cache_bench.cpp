@@ -0,0 +1,242 @@
+// Cold versus warm asset loads through AssetStreamer with its on-disk
+// AssetCache (engine/core/asset_cache.h), followed by checks of the cache's
+// size limit, LRU eviction across a reopen, and corrupt-entry handling
+// (truncated, or with an index past its submesh's vertices). It
+// uses a fresh temporary cache directory and removes it at the end.
+//
+//   asset_cache_bench [input_dir]
+//
+// Exits non-zero if a warm load decodes again, warm output differs from the
+// cold cook, or eviction leaves the wrong entries behind.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/asset_cache.h"
+#include "engine/core/asset_streamer.h"
+
+namespace {
+
+struct Asset {
+    std::string name;
+    std::filesystem::path path;
+    uint64_t key{0};
+    std::vector<uint8_t> cooked;
+    double coldMs{0.0};
+    double warmMs{0.0};
+};
+
+// Loads one asset on a single-worker streamer and waits for it.
+std::unique_ptr<engine::DecodedModel> LoadOne(engine::AssetStreamer& streamer, const Asset& asset) {
+    streamer.Request(asset.name, engine::AssetStreamer::FileReader(asset.path.string()));
+    std::vector<std::unique_ptr<engine::DecodedModel>> done;
+    while (done.empty()) {
+        streamer.TakeCompleted(&done);
+    }
+    return std::move(done.front());
+}
+
+std::vector<uint8_t> MeshBytes(const engine::CookedMesh& mesh) {
+    std::vector<uint8_t> bytes(mesh.VertexData().begin(), mesh.VertexData().end());
+    bytes.insert(bytes.end(), mesh.IndexData().begin(), mesh.IndexData().end());
+    return bytes;
+}
+
+bool Check(bool condition, const char* what, bool* ok) {
+    std::printf("  %-52s %s\n", what, condition ? "ok" : "FAILED");
+    *ok = *ok && condition;
+    return condition;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    std::vector<Asset> assets;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            assets.push_back(Asset{entry.path().filename().string(), entry.path()});
+        }
+    }
+    std::sort(assets.begin(), assets.end(), [](const Asset& a, const Asset& b) { return a.name < b.name; });
+    if (assets.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    std::string tempTemplate = (std::filesystem::temp_directory_path() / "asset_cache_bench.XXXXXX").string();
+    if (!mkdtemp(tempTemplate.data())) {
+        std::fprintf(stderr, "Cannot create a temporary cache directory\n");
+        return 1;
+    }
+    const std::filesystem::path cacheDir = tempTemplate;
+    bool ok = true;
+
+    // Cold: empty cache, every asset is parsed, cooked and stored.
+    {
+        engine::AssetStreamer streamer(1);
+        streamer.Cache().Open(cacheDir.string());
+        for (Asset& asset : assets) {
+            auto model = LoadOne(streamer, asset);
+            if (!model->ok || model->cached) {
+                std::fprintf(stderr, "%s: cold load %s\n", asset.name.c_str(),
+                             model->ok ? "hit an empty cache" : model->error.c_str());
+                ok = false;
+                continue;
+            }
+            std::vector<uint8_t> source;
+            std::string error;
+            engine::AssetStreamer::FileReader(asset.path.string())(&source, &error);
+            asset.key = engine::AssetCache::KeyFor(source);
+            asset.cooked = model->blob;
+            asset.coldMs = model->readMs + model->decodeMs;
+        }
+    }
+
+    // Warm: a new streamer over the same directory, as on the next launch.
+    uint64_t checksum = 0;
+    {
+        engine::AssetStreamer streamer(1);
+        streamer.Cache().Open(cacheDir.string());
+        for (Asset& asset : assets) {
+            auto model = LoadOne(streamer, asset);
+            if (!model->ok || !model->cached) {
+                std::fprintf(stderr, "%s: warm load %s\n", asset.name.c_str(),
+                             model->ok ? "decoded again" : model->error.c_str());
+                ok = false;
+                continue;
+            }
+            asset.warmMs = model->readMs + model->decodeMs;
+            engine::CookedMesh reference;
+            if (!reference.Parse(asset.cooked, nullptr) || MeshBytes(reference) != MeshBytes(model->mesh)) {
+                std::fprintf(stderr, "%s: cached mesh differs from the cold cook\n", asset.name.c_str());
+                ok = false;
+            }
+            checksum += engine::bench::SumBytes(model->mesh.VertexData());
+        }
+        const engine::AssetCache::Stats stats = streamer.Cache().GetStats();
+        std::printf("warm cache: %zu entries, %.1f KiB, %llu hits, %llu misses\n\n", stats.entries,
+                    stats.bytes / 1024.0, static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses));
+    }
+    engine::bench::DoNotOptimize(checksum);
+
+    std::printf("%-26s %10s %10s %9s\n", "asset", "cold", "warm", "speedup");
+    double coldTotal = 0.0;
+    double warmTotal = 0.0;
+    for (const Asset& asset : assets) {
+        std::printf("%-26s %7.2f ms %7.2f ms %8.1fx\n", asset.name.c_str(), asset.coldMs, asset.warmMs,
+                    asset.warmMs > 0.0 ? asset.coldMs / asset.warmMs : 0.0);
+        coldTotal += asset.coldMs;
+        warmTotal += asset.warmMs;
+    }
+    std::printf("%-26s %7.2f ms %7.2f ms %8.1fx\n\n", "total", coldTotal, warmTotal,
+                warmTotal > 0.0 ? coldTotal / warmTotal : 0.0);
+
+    // Size limit and LRU order, on every asset but the largest so no single
+    // entry dominates the limit. They are stored in order, so the survivors
+    // must be the most recently stored ones.
+    std::printf("eviction:\n");
+    std::vector<const Asset*> pool;
+    for (const Asset& asset : assets) {
+        pool.push_back(&asset);
+    }
+    pool.erase(std::max_element(pool.begin(), pool.end(),
+                                [](const Asset* a, const Asset* b) { return a->cooked.size() < b->cooked.size(); }));
+    uint64_t poolBytes = 0;
+    for (const Asset* asset : pool) {
+        poolBytes += asset->cooked.size();
+    }
+    const uint64_t limit = poolBytes / 2;
+    std::filesystem::remove_all(cacheDir, ec);
+    std::filesystem::create_directory(cacheDir, ec);
+    {
+        engine::AssetCache cache;
+        cache.Open(cacheDir.string(), limit);
+        for (const Asset* asset : pool) {
+            cache.Store(asset->key, asset->cooked);
+        }
+        const engine::AssetCache::Stats stats = cache.GetStats();
+        Check(stats.bytes <= limit && stats.evictions > 0, "stays under the limit by evicting", &ok);
+
+        std::vector<bool> present(pool.size());
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            engine::CookedMesh probe;
+            present[i] = cache.Load(pool[i]->key, &probe);
+        }
+        const auto firstPresent = std::find(present.begin(), present.end(), true);
+        Check(firstPresent != present.end() && std::all_of(firstPresent, present.end(), [](bool p) { return p; }),
+              "survivors are the most recently stored", &ok);
+
+        // The loads above refreshed the survivors in order. Touch the oldest
+        // again, then reopen with a limit one byte under the current size:
+        // recency has to come from disk, and the next oldest must go instead.
+        const std::size_t oldest = static_cast<std::size_t>(firstPresent - present.begin());
+        if (oldest + 1 < pool.size()) {
+            engine::CookedMesh touched;
+            cache.Load(pool[oldest]->key, &touched);
+            const engine::AssetCache::Stats before = cache.GetStats();
+            engine::AssetCache reopened;
+            reopened.Open(cacheDir.string(), before.bytes - 1);
+            const engine::AssetCache::Stats after = reopened.GetStats();
+            Check(after.entries == before.entries - 1 && after.evictions == 1, "reopen indexes and evicts one entry",
+                  &ok);
+            engine::CookedMesh probe;
+            Check(reopened.Load(pool[oldest]->key, &probe), "recently used entry survives the reopen", &ok);
+            Check(!reopened.Load(pool[oldest + 1]->key, &probe), "least recently used entry is evicted", &ok);
+        }
+    }
+
+    // A damaged entry is a miss and is deleted.
+    {
+        engine::AssetCache cache;
+        cache.Open(cacheDir.string());
+        const Asset& victim = assets.back();
+        cache.Store(victim.key, victim.cooked);
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.cwm", static_cast<unsigned long long>(victim.key));
+        std::filesystem::resize_file(cacheDir / name, victim.cooked.size() / 2, ec);
+        engine::CookedMesh probe;
+        Check(!cache.Load(victim.key, &probe) && !std::filesystem::exists(cacheDir / name),
+              "truncated entry is rejected and removed", &ok);
+
+        // Same size and structure, but one index past its submesh's vertices,
+        // as the cooker would record it.
+        engine::CookedMesh reference;
+        if (reference.Parse(victim.cooked, nullptr) && !reference.Submeshes().empty()) {
+            const engine::cooked::Submesh& submesh = reference.Submeshes().front();
+            const std::size_t at = static_cast<std::size_t>(reference.IndexData().data() - victim.cooked.data()) +
+                                   submesh.lods[0].indexOffset;
+            const std::size_t lodAt = static_cast<std::size_t>(reinterpret_cast<const uint8_t*>(&submesh.lods[0]) -
+                                                               victim.cooked.data());
+            std::vector<uint8_t> damaged = victim.cooked;
+            engine::cooked::Lod lod = submesh.lods[0];
+            lod.maxIndex = submesh.vertexCount;
+            std::memcpy(damaged.data() + lodAt, &lod, sizeof(lod));
+            if (submesh.indexType == engine::cooked::kIndexUint16) {
+                const uint16_t index = static_cast<uint16_t>(submesh.vertexCount);
+                std::memcpy(damaged.data() + at, &index, sizeof(index));
+            } else {
+                std::memcpy(damaged.data() + at, &submesh.vertexCount, sizeof(submesh.vertexCount));
+            }
+            cache.Store(victim.key, damaged);
+            Check(!cache.Load(victim.key, &probe) && !std::filesystem::exists(cacheDir / name),
+                  "out-of-range index is rejected and removed", &ok);
+        } else {
+            Check(false, "out-of-range index is rejected and removed", &ok);
+        }
+    }
+
+    std::filesystem::remove_all(cacheDir, ec);
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
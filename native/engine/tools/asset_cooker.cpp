@@ -0,0 +1,132 @@
+// Offline asset cooker: converts every .glb in a directory (assets/3d by
+// default) into the GPU-ready cooked mesh format (engine/core/cooked_mesh.h)
+// and reports size, quantization error and load time against the raw GLB.
+//
+//   asset_cooker [input_dir] [output_dir]
+//
+// Output files are named <asset>.cwm. Exits non-zero if any asset fails to
+// cook, the written blob does not load back, or loading it is not faster
+// than loading the GLB it came from.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/cooked_mesh.h"
+#include "engine/core/glb_asset.h"
+#include "engine/core/mesh_cooker.h"
+
+namespace {
+
+constexpr std::size_t kBytesPerSample = 64u << 20;
+constexpr int kBenchSamples = 5;
+
+bool WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && written;
+}
+
+// Load plus a full read of everything the GPU would receive.
+uint64_t LoadGlb(const std::string& path) {
+    engine::GlbAsset asset;
+    if (!asset.Open(path.c_str(), nullptr)) {
+        return 0;
+    }
+    uint64_t sum = 0;
+    for (const engine::GltfAccessor& accessor : asset.Accessors()) {
+        sum += engine::bench::SumBytes(accessor.data);
+    }
+    return sum;
+}
+
+uint64_t LoadCooked(const std::string& path) {
+    engine::CookedMesh mesh;
+    if (!mesh.Open(path.c_str(), nullptr)) {
+        return 0;
+    }
+    return engine::bench::SumBytes(mesh.VertexData()) + engine::bench::SumBytes(mesh.IndexData());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    const std::filesystem::path outputDir = argc > 2 ? argv[2] : "cooked";
+
+    std::error_code ec;
+    std::filesystem::create_directories(outputDir, ec);
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    std::printf("%-26s %9s %9s %6s %5s %9s %7s %10s %10s %8s\n", "asset", "glb KiB", "cwm KiB", "ratio", "u16",
+                "pos err", "nrm err", "glb load", "cwm load", "speedup");
+
+    bool ok = true;
+    std::size_t totalGlb = 0;
+    std::size_t totalCooked = 0;
+    for (const auto& file : files) {
+        const std::string name = file.filename().string();
+        engine::GlbAsset asset;
+        std::string error;
+        std::vector<uint8_t> blob;
+        engine::CookStats stats;
+        if (!asset.Open(file.c_str(), &error) || !engine::CookGlb(asset, &blob, &stats, &error)) {
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+
+        const std::filesystem::path outputPath = outputDir / file.stem().concat(".cwm");
+        engine::CookedMesh cooked;
+        if (!WriteFile(outputPath, blob) || !cooked.Open(outputPath.c_str(), &error)) {
+            std::fprintf(stderr, "%s: cooked output does not load back: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+
+        const std::size_t glbSize = std::filesystem::file_size(file);
+        const int64_t iterations = static_cast<int64_t>(std::max<std::size_t>(1, kBytesPerSample / glbSize));
+        const double glbNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            engine::bench::DoNotOptimize(LoadGlb(file.string()));
+        });
+        const double cookedNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            engine::bench::DoNotOptimize(LoadCooked(outputPath.string()));
+        });
+
+        totalGlb += glbSize;
+        totalCooked += blob.size();
+        std::printf("%-26s %9.1f %9.1f %5.2fx %2zu/%-2zu %9.2e %6.3f° %7.1f us %7.1f us %7.2fx\n", name.c_str(),
+                    glbSize / 1024.0, blob.size() / 1024.0, static_cast<double>(glbSize) / blob.size(),
+                    stats.submeshes - stats.wideIndexSubmeshes, stats.submeshes, stats.maxPositionError,
+                    stats.maxNormalErrorDegrees, glbNs / 1000.0, cookedNs / 1000.0,
+                    cookedNs > 0.0 ? glbNs / cookedNs : 0.0);
+        // Skipping the decode is the point of the format.
+        if (cookedNs >= glbNs) {
+            std::fprintf(stderr, "%s: cooked load is not faster than the GLB\n", name.c_str());
+            ok = false;
+        }
+    }
+
+    if (totalCooked > 0) {
+        std::printf("total: %.1f KiB -> %.1f KiB (%.2fx smaller), written to %s\n", totalGlb / 1024.0,
+                    totalCooked / 1024.0, static_cast<double>(totalGlb) / totalCooked, outputDir.c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+namespace engine::bench {
+
+// Keeps a value alive so the optimizer cannot drop the work that produced it.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// Runs `body` `iterations` times per sample and returns the best
+// nanoseconds-per-iteration over `samples` samples.
+template <typename Fn>
+double MeasureNsPerIteration(int64_t iterations, int samples, Fn&& body) {
+    using clock = std::chrono::steady_clock;
+    double best = 0.0;
+    for (int s = 0; s < samples; ++s) {
+        const auto start = clock::now();
+        for (int64_t i = 0; i < iterations; ++i) {
+            body(i);
+        }
+        ClobberMemory();
+        const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        const double perIteration = elapsed / static_cast<double>(iterations);
+        if (s == 0 || perIteration < best) {
+            best = perIteration;
+        }
+    }
+    return best;
+}
+
+inline void PrintRow(const char* name, double referenceNs, double optimizedNs) {
+    const double speedup = optimizedNs > 0.0 ? referenceNs / optimizedNs : 0.0;
+    std::printf("%-28s %10.2f ns %10.2f ns %8.2fx\n", name, referenceNs, optimizedNs, speedup);
+}
+
+// Reads every byte of `bytes`, standing in for a glBufferData upload.
+inline uint64_t SumBytes(std::span<const uint8_t> bytes) {
+    uint64_t sum = 0;
+    const std::size_t words = bytes.size() / sizeof(uint64_t);
+    for (std::size_t i = 0; i < words; ++i) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes.data() + i * sizeof(uint64_t), sizeof(word));
+        sum += word;
+    }
+    return sum;
+}
+
+// Small deterministic PRNG so runs are comparable across machines.
+class Random {
+public:
+    explicit Random(uint32_t seed) : state_(seed ? seed : 1u) {}
+
+    uint32_t NextU32() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    float NextFloat(float minValue, float maxValue) {
+        const float unit = static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f);
+        return minValue + (maxValue - minValue) * unit;
+    }
+
+private:
+    uint32_t state_;
+};
+
+}  // namespace engine::bench
@@ -0,0 +1,112 @@
+// Benchmarks the frustum culling stage (engine/core/culling.h) for thousands
+// of parts scattered around the camera target, checking that the SIMD and
+// scalar paths produce identical visible lists.
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/camera.h"
+#include "engine/core/culling.h"
+
+namespace {
+
+using engine::Vec3;
+using engine::bench::Random;
+
+constexpr std::size_t kPartCounts[] = {1'000, 4'000, 16'000, 64'000};
+constexpr std::size_t kPartsPerSample = 8'000'000;
+constexpr int kBenchSamples = 5;
+constexpr float kSceneExtent = 30.0f;
+
+bool SameList(const std::vector<uint32_t>& a, std::size_t countA, const std::vector<uint32_t>& b, std::size_t countB) {
+    if (countA != countB) {
+        return false;
+    }
+    for (std::size_t i = 0; i < countA; ++i) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    engine::OrbitCamera camera;
+    camera.SetViewport(1080, 2400);
+    camera.Zoom(-1.0f);
+    const engine::Frustum& frustum = camera.FrustumPlanes();
+
+    Random rng(7u);
+    std::printf("Math backend: %s\n", engine::kMathBackend);
+    std::printf("%8s %6s %9s %12s %12s %9s\n", "parts", "kind", "visible", "scalar", "simd", "speedup");
+
+    bool ok = true;
+    for (const std::size_t count : kPartCounts) {
+        engine::BoundingSphereSoA spheres;
+        engine::BoundingBoxSoA boxes;
+        spheres.Resize(count);
+        boxes.Resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Vec3 center{rng.NextFloat(-kSceneExtent, kSceneExtent),
+                              rng.NextFloat(-kSceneExtent, kSceneExtent),
+                              rng.NextFloat(-kSceneExtent, kSceneExtent)};
+            const Vec3 half{rng.NextFloat(0.05f, 1.5f), rng.NextFloat(0.05f, 1.5f), rng.NextFloat(0.05f, 1.5f)};
+            spheres.Set(i, center, engine::Length(half));
+            boxes.Set(i, center - half, center + half);
+        }
+
+        std::vector<uint32_t> reference(count);
+        std::vector<uint32_t> visible(count);
+        const int64_t iterations = static_cast<int64_t>(kPartsPerSample / count);
+
+        const struct {
+            const char* kind;
+            std::size_t (*scalar)(const engine::Frustum&, const void*, uint32_t*);
+            std::size_t (*simd)(const engine::Frustum&, const void*, uint32_t*);
+            const void* volumes;
+        } cases[] = {
+            {"sphere",
+             [](const engine::Frustum& f, const void* v, uint32_t* out) {
+                 return engine::CullSpheresScalar(f, *static_cast<const engine::BoundingSphereSoA*>(v), out);
+             },
+             [](const engine::Frustum& f, const void* v, uint32_t* out) {
+                 return engine::CullSpheres(f, *static_cast<const engine::BoundingSphereSoA*>(v), out);
+             },
+             &spheres},
+            {"aabb",
+             [](const engine::Frustum& f, const void* v, uint32_t* out) {
+                 return engine::CullBoxesScalar(f, *static_cast<const engine::BoundingBoxSoA*>(v), out);
+             },
+             [](const engine::Frustum& f, const void* v, uint32_t* out) {
+                 return engine::CullBoxes(f, *static_cast<const engine::BoundingBoxSoA*>(v), out);
+             },
+             &boxes},
+        };
+
+        for (const auto& c : cases) {
+            const std::size_t referenceCount = c.scalar(frustum, c.volumes, reference.data());
+            const std::size_t visibleCount = c.simd(frustum, c.volumes, visible.data());
+            if (!SameList(reference, referenceCount, visible, visibleCount)) {
+                std::fprintf(stderr, "%zu %s: SIMD visible list differs from scalar (%zu vs %zu)\n",
+                             count, c.kind, visibleCount, referenceCount);
+                ok = false;
+            }
+
+            const double scalarNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+                engine::bench::DoNotOptimize(c.scalar(frustum, c.volumes, visible.data()));
+            });
+            const double simdNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+                engine::bench::DoNotOptimize(c.simd(frustum, c.volumes, visible.data()));
+            });
+            std::printf("%8zu %6s %9zu %9.2f us %9.2f us %8.2fx\n",
+                        count, c.kind, visibleCount, scalarNs / 1000.0, simdNs / 1000.0,
+                        simdNs > 0.0 ? scalarNs / simdNs : 0.0);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
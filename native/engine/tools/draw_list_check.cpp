@@ -0,0 +1,381 @@
+// Renders every .glb in a directory (assets/3d by default), each placed
+// several times, on a headless EGL context in two ways: one glDrawElements
+// per instance with a uniform model matrix, and DrawList's instanced,
+// material-batched submission (engine/core/draw_list.h). It compares the
+// images and reports the draw calls of each path, the state changes
+// GlStateCache issued and skipped, and the CPU cost of building the draw
+// list. Submit timings are not reported: software GL shades vertices inside
+// the draw calls, which would swamp them.
+//
+//   draw_list_check [input_dir]
+//
+// Exits non-zero if the images differ, GL reports an error, batching does
+// not reduce the draw calls, or the state cache disagrees with glGet.
+
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "headless_egl.h"
+#include "engine/core/asset_streamer.h"
+#include "engine/core/draw_list.h"
+#include "engine/core/gl_state_cache.h"
+#include "engine/core/gpu_model.h"
+#include "engine/core/shader_program.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using engine::Mat4;
+using engine::Vec3;
+
+constexpr int kImageSize = 256;
+constexpr int kCopiesPerModel = 3;
+constexpr int kTimedFrames = 200;
+constexpr float kDefaultBaseColor[4] = {0.72f, 0.74f, 0.78f, 1.0f};
+
+// Shared by both programs; only the source of the model matrix differs.
+const char* kVertexBody = R"(
+uniform mat4 uViewProj;
+uniform vec3 uPosMin;
+uniform vec3 uPosExtent;
+out vec3 vNormal;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main() {
+    vec4 world = aModel * vec4(uPosMin + aPosition * uPosExtent, 1.0);
+    vNormal = mat3(aModel) * decodeOctahedral(aNormal);
+    gl_Position = uViewProj * world;
+}
+)";
+
+const char* kUniformHeader = R"(#version 300 es
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aNormal;
+uniform mat4 aModel;
+)";
+
+const char* kInstancedHeader = R"(#version 300 es
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aNormal;
+layout(location = 2) in mat4 aModel;
+)";
+
+const char* kFragmentSrc = R"(#version 300 es
+precision highp float;
+in vec3 vNormal;
+uniform vec4 uBaseColor;
+out vec4 fragColor;
+void main() {
+    float light = 0.3 + 0.7 * abs(normalize(vNormal).z);
+    fragColor = vec4(uBaseColor.rgb * light, 1.0);
+}
+)";
+
+struct Uniforms {
+    GLint viewProj{-1};
+    GLint model{-1};
+    GLint posMin{-1};
+    GLint posExtent{-1};
+    GLint baseColor{-1};
+};
+
+Uniforms Locate(GLuint program) {
+    return Uniforms{glGetUniformLocation(program, "uViewProj"), glGetUniformLocation(program, "aModel"),
+                    glGetUniformLocation(program, "uPosMin"), glGetUniformLocation(program, "uPosExtent"),
+                    glGetUniformLocation(program, "uBaseColor")};
+}
+
+struct SubmeshState {
+    const float* posMin;
+    const float* posExtent;
+    const float* baseColor;
+};
+
+struct Draw {
+    engine::DrawKey key;
+    Mat4 world;
+    const SubmeshState* state;
+};
+
+// Scales a model to unit size and centres it on `offset`.
+Mat4 Place(const engine::GpuModel& model, const Vec3& offset) {
+    const Vec3 size = model.BoundsMax() - model.BoundsMin();
+    const float largest = std::max({size.x, size.y, size.z});
+    const float scale = largest > 0.0f ? 1.0f / largest : 1.0f;
+    const Vec3 center = (model.BoundsMin() + model.BoundsMax()) * 0.5f;
+    Mat4 m = Mat4::Identity();
+    m.data[0] = m.data[5] = m.data[10] = scale;
+    m.data[12] = offset.x - center.x * scale;
+    m.data[13] = offset.y - center.y * scale;
+    m.data[14] = offset.z - center.z * scale;
+    return m;
+}
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<uint8_t> ReadImage() {
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(kImageSize) * kImageSize * 4);
+    glReadPixels(0, 0, kImageSize, kImageSize, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    engine::tools::HeadlessContext headless;
+    if (!headless.Create()) {
+        std::fprintf(stderr, "No headless EGL/GLES 3 context available (0x%x)\n", eglGetError());
+        return 1;
+    }
+
+    const std::string uniformVertex = std::string(kUniformHeader) + kVertexBody;
+    const std::string instancedVertex = std::string(kInstancedHeader) + kVertexBody;
+    engine::ShaderProgram uniformProgram;
+    engine::ShaderProgram instancedProgram;
+    if (!uniformProgram.Compile(uniformVertex.c_str(), kFragmentSrc) ||
+        !instancedProgram.Compile(instancedVertex.c_str(), kFragmentSrc)) {
+        std::fprintf(stderr, "Failed to build the draw programs\n");
+        return 1;
+    }
+    const Uniforms uniformLocations = Locate(uniformProgram.Id());
+    const Uniforms instancedLocations = Locate(instancedProgram.Id());
+
+    // Load and fully upload every model.
+    std::vector<std::unique_ptr<engine::GpuModel>> models;
+    {
+        engine::AssetStreamer streamer;
+        for (const auto& file : files) {
+            streamer.Request(file.filename().string(), engine::AssetStreamer::FileReader(file.string()));
+        }
+        std::vector<std::unique_ptr<engine::DecodedModel>> decoded;
+        while (decoded.size() < files.size()) {
+            streamer.TakeCompleted(&decoded);
+        }
+        for (auto& model : decoded) {
+            if (!model->ok) {
+                std::fprintf(stderr, "%s: %s\n", model->name.c_str(), model->error.c_str());
+                return 1;
+            }
+            auto gpu = std::make_unique<engine::GpuModel>(std::move(model));
+            while (!gpu->Ready()) {
+                gpu->Upload(SIZE_MAX);
+            }
+            models.push_back(std::move(gpu));
+        }
+    }
+
+    // Each model kCopiesPerModel times on a grid in the z = 0 plane, all
+    // at LOD 0.
+    std::vector<SubmeshState> states;
+    for (const auto& model : models) {
+        for (const engine::cooked::Submesh& submesh : model->Submeshes()) {
+            states.push_back(SubmeshState{
+                submesh.posMin, submesh.posExtent,
+                submesh.material >= 0 ? model->Materials()[submesh.material].baseColor : kDefaultBaseColor});
+        }
+    }
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(models.size() * kCopiesPerModel))));
+    std::vector<Draw> draws;
+    std::size_t stateBase = 0;
+    int cell = 0;
+    for (const auto& model : models) {
+        for (int copy = 0; copy < kCopiesPerModel; ++copy, ++cell) {
+            const Vec3 offset(static_cast<float>(cell % columns) - 0.5f * (columns - 1),
+                              static_cast<float>(cell / columns) - 0.5f * (columns - 1), 0.0f);
+            const Mat4 place = Place(*model, offset);
+            for (const engine::cooked::Instance& instance : model->Instances()) {
+                const engine::cooked::Submesh& submesh = model->Submeshes()[instance.submesh];
+                Mat4 local;
+                std::copy(std::begin(instance.world), std::end(instance.world), local.data.begin());
+                draws.push_back(Draw{engine::DrawKey{0, model->VertexArray(instance.submesh), submesh.material,
+                                                     submesh.indexType, submesh.lods[0].indexOffset,
+                                                     submesh.lods[0].indexCount},
+                                     engine::Multiply(place, local), &states[stateBase + instance.submesh]});
+            }
+        }
+        stateBase += model->Submeshes().size();
+    }
+
+    const float extent = static_cast<float>(columns);
+    const Mat4 viewProj = engine::Multiply(engine::Perspective(0.8f, 1.0f, 0.1f, 100.0f),
+                                           engine::LookAt(Vec3(0.0f, 0.0f, extent * 1.3f), Vec3(0.0f, 0.0f, 0.0f),
+                                                          Vec3(0.0f, 1.0f, 0.0f)));
+
+    // Offscreen target; the headless surface is tiny.
+    GLuint framebuffer = 0;
+    GLuint renderbuffers[2] = {0, 0};
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kImageSize, kImageSize);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, kImageSize, kImageSize);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::fprintf(stderr, "Offscreen framebuffer incomplete\n");
+        return 1;
+    }
+    engine::GlStateCache& state = engine::GlStateCache::Current();
+    state.Viewport(0, 0, kImageSize, kImageSize);
+    state.SetEnabled(GL_DEPTH_TEST, true);
+
+    const auto clear = []() {
+        engine::GlStateCache::Current().ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    };
+
+    // Reference: one draw per instance.
+    const auto drawPerInstance = [&]() {
+        state.UseProgram(uniformProgram.Id());
+        glUniformMatrix4fv(uniformLocations.viewProj, 1, GL_FALSE, viewProj.Ptr());
+        for (const Draw& draw : draws) {
+            glUniformMatrix4fv(uniformLocations.model, 1, GL_FALSE, draw.world.Ptr());
+            glUniform3fv(uniformLocations.posMin, 1, draw.state->posMin);
+            glUniform3fv(uniformLocations.posExtent, 1, draw.state->posExtent);
+            glUniform4fv(uniformLocations.baseColor, 1, draw.state->baseColor);
+            state.BindVertexArray(draw.key.vao);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(draw.key.indexCount), draw.key.indexType,
+                           reinterpret_cast<const void*>(static_cast<uintptr_t>(draw.key.indexOffset)));
+        }
+        return static_cast<int>(draws.size());
+    };
+
+    engine::DrawList drawList;
+    const auto drawBatched = [&]() {
+        drawList.Clear();
+        for (const Draw& draw : draws) {
+            engine::DrawKey key = draw.key;
+            key.program = instancedProgram.Id();
+            drawList.Add(key, draw.world, draw.state);
+        }
+        drawList.Build();
+        state.UseProgram(instancedProgram.Id());
+        glUniformMatrix4fv(instancedLocations.viewProj, 1, GL_FALSE, viewProj.Ptr());
+        return drawList.Submit(engine::DrawPass::kOpaque, [&](const engine::DrawBatch& batch) {
+            const auto* state = static_cast<const SubmeshState*>(batch.state);
+            glUniform3fv(instancedLocations.posMin, 1, state->posMin);
+            glUniform3fv(instancedLocations.posExtent, 1, state->posExtent);
+            glUniform4fv(instancedLocations.baseColor, 1, state->baseColor);
+        });
+    };
+
+    bool ok = true;
+    clear();
+    state.ResetCounters();
+    const int referenceCalls = drawPerInstance();
+    const engine::GlStateCache::Counters referenceState = state.GetCounters();
+    const std::vector<uint8_t> reference = ReadImage();
+    clear();
+    drawBatched();
+    // Second batched frame: steady state, as on the render thread.
+    clear();
+    state.ResetCounters();
+    const int batchedCalls = drawBatched();
+    const engine::GlStateCache::Counters batchedState = state.GetCounters();
+    const std::vector<uint8_t> batched = ReadImage();
+
+    GLint boundProgram = 0;
+    GLint boundVao = 0;
+    GLint boundArrayBuffer = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &boundProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVao);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &boundArrayBuffer);
+    const bool stateMatches = state.Program() == static_cast<GLuint>(boundProgram) &&
+                              state.VertexArray() == static_cast<GLuint>(boundVao) &&
+                              state.Buffer(GL_ARRAY_BUFFER) == static_cast<GLuint>(boundArrayBuffer);
+
+    std::size_t covered = 0;
+    std::size_t differing = 0;
+    for (std::size_t i = 0; i < reference.size(); i += 4) {
+        covered += reference[i] != 0 || reference[i + 1] != 0 || reference[i + 2] != 0;
+        for (std::size_t c = 0; c < 3; ++c) {
+            if (std::abs(static_cast<int>(reference[i + c]) - static_cast<int>(batched[i + c])) > 1) {
+                ++differing;
+                break;
+            }
+        }
+    }
+
+    // Gathering, sorting and batching only; what the render thread adds per
+    // frame before any GL call.
+    const Clock::time_point buildStart = Clock::now();
+    for (int frame = 0; frame < kTimedFrames; ++frame) {
+        drawList.Clear();
+        for (const Draw& draw : draws) {
+            drawList.Add(draw.key, draw.world, draw.state);
+        }
+        drawList.Build();
+    }
+    const double buildUs = MsSince(buildStart) * 1000.0 / kTimedFrames;
+
+    std::printf("%zu models x %d copies: %zu instances, %zu distinct submeshes\n", models.size(), kCopiesPerModel,
+                draws.size(), states.size());
+    std::printf("draw calls: %d per instance, %d instanced (%.1fx fewer)\n", referenceCalls, batchedCalls,
+                batchedCalls > 0 ? static_cast<double>(referenceCalls) / batchedCalls : 0.0);
+    std::printf("state changes: per instance %llu issued / %llu skipped, instanced %llu issued / %llu skipped\n",
+                static_cast<unsigned long long>(referenceState.issued),
+                static_cast<unsigned long long>(referenceState.elided),
+                static_cast<unsigned long long>(batchedState.issued),
+                static_cast<unsigned long long>(batchedState.elided));
+    std::printf("draw list build: %.1f us per frame\n", buildUs);
+    std::printf("%zu of %zu covered pixels differ\n", differing, covered);
+
+    if (covered == 0 || differing > 0) {
+        std::fprintf(stderr, "instanced image does not match the per-instance reference\n");
+        ok = false;
+    }
+    if (batchedCalls >= referenceCalls) {
+        std::fprintf(stderr, "batching did not reduce draw calls\n");
+        ok = false;
+    }
+    if (!stateMatches) {
+        std::fprintf(stderr, "state cache disagrees with glGet\n");
+        ok = false;
+    }
+    const GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        std::fprintf(stderr, "GL error 0x%x\n", glError);
+        ok = false;
+    }
+
+    drawList.Destroy();
+    models.clear();
+    glDeleteRenderbuffers(2, renderbuffers);
+    glDeleteFramebuffers(1, &framebuffer);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Benchmarks per-frame draw sorting (engine/core/draw_list.h) for 500 to 50k
+// draws: RadixSort (a stable sort below 1024 entries) against std::sort on
+// the same keys, and a whole DrawList::Build (keys, sort, batching). The
+// scene mixes a few programs, dozens of materials, hundreds of meshes and
+// some translucent draws at random depths. CPU only; no GL calls are made.
+//
+// Exits non-zero if the radix sort disagrees with std::stable_sort, or the
+// built order breaks pass, front-to-back or back-to-front ordering.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/draw_list.h"
+
+namespace {
+
+using engine::DrawPass;
+using engine::bench::Random;
+
+constexpr std::size_t kDrawCounts[] = {500, 1'000, 2'000, 5'000, 10'000, 25'000, 50'000};
+constexpr std::size_t kDrawsPerSample = 2'000'000;
+constexpr int kBenchSamples = 5;
+constexpr uint32_t kPrograms = 3;
+constexpr uint32_t kMaterials = 48;
+constexpr uint32_t kMeshes = 400;
+constexpr uint32_t kLods = 4;
+constexpr uint32_t kTranslucentPercent = 10;
+constexpr float kMaxDepth = 200.0f;
+
+struct Draw {
+    engine::DrawKey key;
+    DrawPass pass;
+    float depth;
+};
+
+std::vector<Draw> MakeDraws(std::size_t count, Random& rng) {
+    std::vector<Draw> draws(count);
+    for (Draw& draw : draws) {
+        const uint32_t mesh = rng.NextU32() % kMeshes;
+        const uint32_t lod = rng.NextU32() % kLods;
+        draw.key.program = 1 + mesh % kPrograms;
+        draw.key.vao = 1 + mesh;
+        draw.key.material = static_cast<int32_t>(mesh % kMaterials) - 1;  // -1: no material.
+        draw.key.indexOffset = lod * 4096;
+        draw.key.indexCount = 3 * (1200 >> lod);
+        draw.pass = rng.NextU32() % 100 < kTranslucentPercent ? DrawPass::kTranslucent : DrawPass::kOpaque;
+        draw.depth = rng.NextFloat(0.5f, kMaxDepth);
+    }
+    return draws;
+}
+
+void Fill(engine::DrawList& list, const std::vector<Draw>& draws) {
+    list.Clear();
+    for (std::size_t i = 0; i < draws.size(); ++i) {
+        list.Add(draws[i].key, engine::Mat4::Identity(), nullptr, draws[i].pass, draws[i].depth);
+    }
+}
+
+// Pass order, opaque depth buckets front to back, translucent depth back to
+// front, each to within one quantisation step.
+bool CheckOrder(const engine::DrawList& list, const std::vector<Draw>& draws) {
+    float nearest = kMaxDepth;
+    float farthest = 0.0f;
+    for (const Draw& draw : draws) {
+        nearest = std::min(nearest, draw.depth);
+        farthest = std::max(farthest, draw.depth);
+    }
+    const float range = farthest - nearest;
+    const float opaqueStep = range / (1 << engine::DrawList::kOpaqueDepthBits);
+    const float translucentStep = range / (1 << 14) * 2.0f;
+
+    const std::vector<engine::SortEntry>& sorted = list.SortedKeys();
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        const Draw& previous = draws[sorted[i - 1].index];
+        const Draw& current = draws[sorted[i].index];
+        if (current.pass < previous.pass) {
+            return false;
+        }
+        if (current.pass != previous.pass) {
+            continue;
+        }
+        if (current.pass == DrawPass::kOpaque && current.depth + opaqueStep < previous.depth) {
+            return false;
+        }
+        if (current.pass == DrawPass::kTranslucent && current.depth > previous.depth + translucentStep) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    Random rng(19u);
+    std::printf("%8s %12s %12s %9s %12s %9s\n", "draws", "std::sort", "radix", "speedup", "Build", "batches");
+
+    bool ok = true;
+    for (const std::size_t count : kDrawCounts) {
+        const std::vector<Draw> draws = MakeDraws(count, rng);
+        engine::DrawList list;
+        Fill(list, draws);
+        list.Build();
+        if (!CheckOrder(list, draws)) {
+            std::fprintf(stderr, "%zu draws: built order breaks pass or depth ordering\n", count);
+            ok = false;
+        }
+
+        // The same keys Build produced, in random order.
+        std::vector<engine::SortEntry> keys = list.SortedKeys();
+        for (std::size_t i = keys.size(); i > 1; --i) {
+            std::swap(keys[i - 1], keys[rng.NextU32() % i]);
+        }
+        std::vector<engine::SortEntry> expected = keys;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const engine::SortEntry& a, const engine::SortEntry& b) { return a.key < b.key; });
+        std::vector<engine::SortEntry> work = keys;
+        std::vector<engine::SortEntry> scratch;
+        engine::RadixSort(&work, &scratch);
+        for (std::size_t i = 0; i < work.size(); ++i) {
+            if (work[i].key != expected[i].key || work[i].index != expected[i].index) {
+                std::fprintf(stderr, "%zu draws: radix sort differs from std::stable_sort at %zu\n", count, i);
+                ok = false;
+                break;
+            }
+        }
+
+        const int64_t iterations = static_cast<int64_t>(std::max<std::size_t>(1, kDrawsPerSample / count));
+        const double stdNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            work = keys;
+            std::sort(work.begin(), work.end(),
+                      [](const engine::SortEntry& a, const engine::SortEntry& b) { return a.key < b.key; });
+            engine::bench::DoNotOptimize(work.data());
+        });
+        const double radixNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            work = keys;
+            engine::RadixSort(&work, &scratch);
+            engine::bench::DoNotOptimize(work.data());
+        });
+        const double buildNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            Fill(list, draws);
+            list.Build();
+            engine::bench::DoNotOptimize(list.Batches().data());
+        });
+
+        std::printf("%8zu %9.1f us %9.1f us %8.2fx %9.1f us %9zu\n", count, stdNs / 1000.0, radixNs / 1000.0,
+                    radixNs > 0.0 ? stdNs / radixNs : 0.0, buildNs / 1000.0, list.Batches().size());
+    }
+
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// Checks dynamic resolution (engine/core/dynamic_resolution.h and
+// render_target.h).
+//
+// Controller: simulated frames whose cost is a fixed CPU part plus a fill
+// part proportional to the rendered pixels, with per-frame noise. For each
+// load it reports the scale it settles on, the cost there and how often the
+// scale changed. Light loads must stay at full scale. Heavy loads must settle
+// within budget and stop changing. A load spike must be followed by a
+// return to full scale.
+//
+// Render target: on a headless EGL context, four colour quadrants are drawn
+// into a half-size target and blitted up over the whole window; the window
+// is read back, edges included.
+//
+// Exits non-zero if any of those checks fails, or on a GL error.
+
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_util.h"
+#include "headless_egl.h"
+#include "engine/core/dynamic_resolution.h"
+#include "engine/core/gl_state_cache.h"
+#include "engine/core/render_target.h"
+
+namespace {
+
+using engine::DynamicResolution;
+
+constexpr float kBudgetMs = 1000.0f / 120.0f;
+constexpr int kFrames = 2'400;
+// Frames at the end of a run that must not change the scale.
+constexpr int kSettledFrames = 600;
+
+struct Load {
+    const char* name;
+    float cpuMs;
+    float fillMs;  // At full scale.
+    float noise;   // Uniform, +- this fraction of the cost.
+    // Frames [spikeStart, spikeEnd) cost spikeFactor times as much fill.
+    int spikeStart{0};
+    int spikeEnd{0};
+    float spikeFactor{1.0f};
+};
+
+struct Result {
+    float finalScale{1.0f};
+    float settledMs{0.0f};
+    int changes{0};
+    int settledChanges{0};
+    float lowestScale{1.0f};
+};
+
+Result Simulate(const Load& load, engine::bench::Random& rng) {
+    DynamicResolution resolution;
+    Result result;
+    double settledMs = 0.0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        const float scale = resolution.Scale();
+        const bool spike = frame >= load.spikeStart && frame < load.spikeEnd;
+        const float fillMs = load.fillMs * (spike ? load.spikeFactor : 1.0f) * scale * scale;
+        const float jitter = 1.0f + rng.NextFloat(-load.noise, load.noise);
+        const float frameMs = (load.cpuMs + fillMs) * jitter;
+
+        const int changesBefore = resolution.Changes();
+        resolution.Update(frameMs, kBudgetMs);
+        result.lowestScale = std::min(result.lowestScale, resolution.Scale());
+        if (frame >= kFrames - kSettledFrames) {
+            settledMs += frameMs;
+            result.settledChanges += resolution.Changes() - changesBefore;
+        }
+    }
+    result.finalScale = resolution.Scale();
+    result.settledMs = static_cast<float>(settledMs / kSettledFrames);
+    result.changes = resolution.Changes();
+    return result;
+}
+
+bool CheckController() {
+    // cpuMs, fillMs at full scale; the budget is 8.33 ms.
+    const Load loads[] = {
+        {"light", 2.0f, 4.0f, 0.1f},
+        {"at budget", 2.0f, 5.8f, 0.1f},
+        {"fill bound", 2.0f, 14.0f, 0.1f},
+        {"fill bound, noisy", 2.0f, 14.0f, 0.3f},
+        {"very heavy (floor)", 3.0f, 40.0f, 0.1f},
+        {"spike", 2.0f, 4.0f, 0.1f, 300, 900, 3.0f},
+    };
+
+    engine::bench::Random rng(21u);
+    bool ok = true;
+    std::printf("%-20s %8s %8s %12s %8s %9s\n", "load", "lowest", "final", "settled ms", "changes", "settled");
+    for (const Load& load : loads) {
+        const Result result = Simulate(load, rng);
+        std::printf("%-20s %8.2f %8.2f %12.2f %8d %9d\n", load.name, result.lowestScale, result.finalScale,
+                    result.settledMs, result.changes, result.settledChanges);
+
+        const float fullMs = load.cpuMs + load.fillMs;
+        const bool fitsAtFloor = load.cpuMs + load.fillMs * DynamicResolution::kMinScale *
+                                                   DynamicResolution::kMinScale <= kBudgetMs;
+        if (result.settledChanges != 0) {
+            std::fprintf(stderr, "%s: scale still changing after %d frames\n", load.name, kFrames - kSettledFrames);
+            ok = false;
+        }
+        if (fullMs <= kBudgetMs * DynamicResolution::kUpFraction && result.finalScale < 1.0f) {
+            std::fprintf(stderr, "%s: not back at full scale\n", load.name);
+            ok = false;
+        }
+        if (fitsAtFloor && result.settledMs > kBudgetMs) {
+            std::fprintf(stderr, "%s: settled over budget\n", load.name);
+            ok = false;
+        }
+        if (!fitsAtFloor && result.finalScale != DynamicResolution::kMinScale) {
+            std::fprintf(stderr, "%s: not at the minimum scale\n", load.name);
+            ok = false;
+        }
+        if (load.spikeEnd > load.spikeStart && result.lowestScale >= 1.0f) {
+            std::fprintf(stderr, "%s: scale never dropped\n", load.name);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+constexpr uint8_t kQuadrantColors[4][3] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {255, 255, 0}};
+
+bool CheckRenderTarget() {
+    engine::tools::HeadlessContext headless;
+    if (!headless.Create()) {
+        std::fprintf(stderr, "No headless EGL/GLES 3 context available (0x%x)\n", eglGetError());
+        return false;
+    }
+    EGLint windowWidth = 0;
+    EGLint windowHeight = 0;
+    eglQuerySurface(headless.display, headless.surface, EGL_WIDTH, &windowWidth);
+    eglQuerySurface(headless.display, headless.surface, EGL_HEIGHT, &windowHeight);
+
+    const int width = windowWidth / 2;
+    const int height = windowHeight / 2;
+    engine::GlStateCache& state = engine::GlStateCache::Current();
+    state.Invalidate();
+    engine::RenderTarget target;
+    if (!target.Resize(width, height)) {
+        std::fprintf(stderr, "Failed to create the render target\n");
+        return false;
+    }
+
+    target.Bind();
+    state.SetEnabled(GL_SCISSOR_TEST, true);
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        const uint8_t* color = kQuadrantColors[quadrant];
+        glScissor((quadrant & 1) * width / 2, (quadrant >> 1) * height / 2, width / 2, height / 2);
+        state.ClearColor(color[0] / 255.0f, color[1] / 255.0f, color[2] / 255.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+    target.BlitToWindow(windowWidth, windowHeight);
+
+    GLint drawBinding = -1;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawBinding);
+    state.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(windowWidth) * windowHeight * 4);
+    glReadPixels(0, 0, windowWidth, windowHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    // Pixels next to a quadrant edge are filtered across it; check the rest.
+    int wrong = 0;
+    int checked = 0;
+    for (int y = 0; y < windowHeight; ++y) {
+        for (int x = 0; x < windowWidth; ++x) {
+            const int quadrantWidth = windowWidth / 2;
+            const int quadrantHeight = windowHeight / 2;
+            if (std::abs(x - quadrantWidth) < 2 || std::abs(y - quadrantHeight) < 2) {
+                continue;
+            }
+            const uint8_t* expected = kQuadrantColors[(x >= quadrantWidth ? 1 : 0) + (y >= quadrantHeight ? 2 : 0)];
+            const uint8_t* pixel = &pixels[(static_cast<std::size_t>(y) * windowWidth + x) * 4];
+            ++checked;
+            for (int c = 0; c < 3; ++c) {
+                if (std::abs(pixel[c] - expected[c]) > 2) {
+                    ++wrong;
+                    break;
+                }
+            }
+        }
+    }
+    std::printf("%dx%d rendered, blitted to %dx%d: %d of %d pixels wrong\n", width, height, windowWidth,
+                windowHeight, wrong, checked);
+
+    bool ok = wrong == 0 && checked > 0;
+    if (drawBinding != 0) {
+        std::fprintf(stderr, "Blit left framebuffer %d bound for drawing\n", drawBinding);
+        ok = false;
+    }
+    const GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        std::fprintf(stderr, "GL error 0x%x\n", glError);
+        ok = false;
+    }
+    target.Destroy();
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = CheckController();
+    ok = CheckRenderTarget() && ok;
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
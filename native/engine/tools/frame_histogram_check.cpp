@@ -0,0 +1,139 @@
+// Checks the rolling frame-time histogram (engine/core/frame_time_histogram.h)
+// against exact statistics of the same window:
+//   - p50/p90/p99 within half a bucket of the nearest-rank values of the
+//     last kWindowFrames samples, and an exact maximum;
+//   - the slowest-1% mean (the 1%-low fps) within half a bucket;
+//   - old samples leave the window: after a slow phase followed by a full
+//     window of fast frames, nothing slow is reported.
+// Then times Add + Summarize, the per-frame cost on the render thread.
+//
+// Exits non-zero if any statistic is off.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/frame_time_histogram.h"
+
+namespace {
+
+using engine::FrameTimeHistogram;
+using engine::FrameTimeStats;
+
+constexpr float kTolerance = FrameTimeHistogram::kBucketMs * 0.5f + 1e-4f;
+
+struct Scenario {
+    const char* name;
+    float baseMs;
+    float jitterMs;     // Uniform, +- this.
+    float spikePercent;
+    float spikeMs;
+    int frames;
+};
+
+float NearestRank(std::vector<float> sorted, float fraction) {
+    std::sort(sorted.begin(), sorted.end());
+    const int rank = std::max(1, static_cast<int>(std::ceil(fraction * static_cast<float>(sorted.size()))));
+    return sorted[static_cast<std::size_t>(rank - 1)];
+}
+
+float SlowestMean(std::vector<float> values, float percent) {
+    std::sort(values.begin(), values.end(), std::greater<float>());
+    const std::size_t count = std::max<std::size_t>(1, static_cast<std::size_t>(values.size() * percent / 100.0f));
+    double total = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += values[i];
+    }
+    return static_cast<float>(total / static_cast<double>(count));
+}
+
+bool Near(const char* scenario, const char* what, float actual, float expected, float tolerance) {
+    if (std::abs(actual - expected) <= tolerance) {
+        return true;
+    }
+    std::fprintf(stderr, "%s: %s %.3f ms, expected %.3f ms\n", scenario, what, actual, expected);
+    return false;
+}
+
+bool Check(const Scenario& scenario, engine::bench::Random& rng) {
+    FrameTimeHistogram histogram;
+    std::deque<float> window;
+    for (int i = 0; i < scenario.frames; ++i) {
+        float ms = scenario.baseMs + rng.NextFloat(-scenario.jitterMs, scenario.jitterMs);
+        if (rng.NextFloat(0.0f, 100.0f) < scenario.spikePercent) {
+            ms = scenario.spikeMs;
+        }
+        histogram.Add(ms);
+        window.push_back(ms);
+        if (window.size() > FrameTimeHistogram::kWindowFrames) {
+            window.pop_front();
+        }
+    }
+
+    const std::vector<float> values(window.begin(), window.end());
+    const FrameTimeStats stats = histogram.Summarize();
+    const float slowest = histogram.SlowestMeanMs(1.0f);
+    std::printf("%-24s %6d %8.2f %8.2f %8.2f %8.2f %10.1f\n", scenario.name, histogram.Count(), stats.p50Ms,
+                stats.p90Ms, stats.p99Ms, stats.maxMs, 1000.0f / slowest);
+
+    bool ok = histogram.Count() == static_cast<int>(values.size());
+    ok = Near(scenario.name, "p50", stats.p50Ms, NearestRank(values, 0.50f), kTolerance) && ok;
+    ok = Near(scenario.name, "p90", stats.p90Ms, NearestRank(values, 0.90f), kTolerance) && ok;
+    ok = Near(scenario.name, "p99", stats.p99Ms, NearestRank(values, 0.99f), kTolerance) && ok;
+    ok = Near(scenario.name, "max", stats.maxMs, *std::max_element(values.begin(), values.end()), 0.0f) && ok;
+    ok = Near(scenario.name, "slowest 1%", slowest, SlowestMean(values, 1.0f), kTolerance) && ok;
+    return ok;
+}
+
+bool CheckEviction() {
+    FrameTimeHistogram histogram;
+    for (int i = 0; i < FrameTimeHistogram::kWindowFrames; ++i) {
+        histogram.Add(i % 50 == 0 ? 120.0f : 33.3f);
+    }
+    for (int i = 0; i < FrameTimeHistogram::kWindowFrames; ++i) {
+        histogram.Add(8.33f);
+    }
+    const FrameTimeStats stats = histogram.Summarize();
+    bool ok = Near("eviction", "max", stats.maxMs, 8.33f, 0.0f);
+    ok = Near("eviction", "p99", stats.p99Ms, 8.33f, kTolerance) && ok;
+    ok = Near("eviction", "slowest 1%", histogram.SlowestMeanMs(1.0f), 8.33f, kTolerance) && ok;
+
+    histogram.Reset();
+    ok = histogram.Count() == 0 && histogram.Summarize().maxMs == 0.0f && ok;
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"steady 60 fps", 16.67f, 0.3f, 0.0f, 0.0f, 2'000},
+        {"120 fps, 2% spikes", 8.33f, 0.5f, 2.0f, 25.0f, 2'000},
+        {"30-40 ms, noisy", 35.0f, 5.0f, 0.0f, 0.0f, 1'000},
+        {"partial window", 11.1f, 1.0f, 1.0f, 50.0f, 150},
+        {"stalls past the range", 16.67f, 0.3f, 1.5f, 250.0f, 3'000},
+    };
+
+    engine::bench::Random rng(24u);
+    bool ok = true;
+    std::printf("%-24s %6s %8s %8s %8s %8s %10s\n", "scenario", "window", "p50", "p90", "p99", "max", "1% low");
+    for (const Scenario& scenario : scenarios) {
+        ok = Check(scenario, rng) && ok;
+    }
+    ok = CheckEviction() && ok;
+
+    FrameTimeHistogram histogram;
+    FrameTimeStats stats;
+    const double ns = engine::bench::MeasureNsPerIteration(20'000, 5, [&](int64_t i) {
+        histogram.Add(8.0f + static_cast<float>(i % 17) * 0.1f);
+        stats = histogram.Summarize();
+        engine::bench::DoNotOptimize(stats);
+    });
+    std::printf("Add + Summarize: %.0f ns per frame\n", ns);
+
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// Simulates frame pacing (engine/core/frame_pacer.h) against a display with
+// a fixed refresh rate, on a fake clock, and reports per scenario:
+//   - the estimated refresh period and the chosen swap interval;
+//   - the late histogram: frames queued 0, 1, 2, ... refreshes late;
+//   - judder: consecutive frames shown a different number of refreshes
+//     apart than the swap interval.
+// For comparison, "timer" rows post frames at 1 / fps like the fallback
+// loop, and show each one at the first refresh after it is queued.
+//
+// The display model: vsync k at k * period (plus jitter); a frame queued by
+// the refresh before its presentation time is shown at the first refresh at
+// or after that time. The render thread takes one frame at a time, and a
+// frame posted while it is busy replaces the pending one, as in
+// EngineRenderer.
+//
+// Exits non-zero if the period estimate is off by more than 1%, the interval
+// is wrong, or a scenario that fits its budget misses deadlines or judders.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/frame_pacer.h"
+
+namespace {
+
+using engine::FramePacer;
+
+constexpr double kSimulatedSeconds = 10.0;
+constexpr int64_t kCallbackLatencyNanos = 300'000;
+
+struct Scenario {
+    const char* name;
+    double refreshHz;
+    int fps;
+    double costMs;           // Render thread time per frame, up to the queued swap.
+    double costJitter;       // Uniform, +- this fraction.
+    double lostTickPercent;  // Ticks the looper never delivers.
+    double vsyncJitterMs;
+    int expectedInterval;
+    bool fitsBudget;         // Must not miss deadlines or judder.
+    double switchToHz{0.0};  // Refresh rate after half the run, if set.
+};
+
+struct Result {
+    double periodMs{0.0};
+    int interval{0};
+    FramePacer::Stats stats{};
+    int shown{0};
+    int uneven{0};
+};
+
+// Vsync times, index k at roughly k * period, switching rate halfway if asked.
+std::vector<int64_t> MakeVsyncs(const Scenario& scenario, engine::bench::Random& rng) {
+    std::vector<int64_t> vsyncs;
+    const double switchAt = scenario.switchToHz > 0.0 ? kSimulatedSeconds / 2 : kSimulatedSeconds;
+    double t = 0.1;
+    while (t < kSimulatedSeconds) {
+        const double hz = t < switchAt ? scenario.refreshHz : scenario.switchToHz;
+        const double jitter = rng.NextFloat(-1.0f, 1.0f) * scenario.vsyncJitterMs / 1000.0;
+        vsyncs.push_back(static_cast<int64_t>((t + jitter) * 1e9));
+        t += 1.0 / hz;
+    }
+    return vsyncs;
+}
+
+// Index of the refresh a frame is shown at: the first vsync at or after
+// `presentNanos` whose previous vsync came after the swap was queued.
+std::size_t ShownAt(const std::vector<int64_t>& vsyncs, int64_t queuedNanos, int64_t presentNanos) {
+    const auto latch = std::upper_bound(vsyncs.begin(), vsyncs.end(), queuedNanos);
+    std::size_t index = static_cast<std::size_t>(latch - vsyncs.begin()) + 1;
+    while (index < vsyncs.size() && vsyncs[index] < presentNanos) {
+        ++index;
+    }
+    return index;
+}
+
+Result Simulate(const Scenario& scenario, bool paced, engine::bench::Random& rng) {
+    const std::vector<int64_t> vsyncs = MakeVsyncs(scenario, rng);
+    int64_t now = 0;
+    FramePacer pacer([&now]() { return now; });
+    pacer.SetTargetFps(scenario.fps);
+
+    std::vector<std::size_t> shown;
+    int64_t busyUntil = 0;
+    std::optional<FramePacer::Frame> pending;
+    auto render = [&](const FramePacer::Frame& frame, int64_t start) {
+        const double jitter = 1.0 + rng.NextFloat(-1.0f, 1.0f) * scenario.costJitter;
+        busyUntil = start + static_cast<int64_t>(scenario.costMs * jitter * 1e6);
+        now = busyUntil;
+        pacer.OnFrameQueued(frame);
+        const std::size_t at = ShownAt(vsyncs, busyUntil, frame.presentNanos);
+        if (at < vsyncs.size() && (shown.empty() || at > shown.back())) {
+            shown.push_back(at);
+        }
+    };
+    auto post = [&](const FramePacer::Frame& frame, int64_t at) {
+        if (pending && busyUntil <= at) {
+            render(*pending, busyUntil);
+            pending.reset();
+        }
+        if (busyUntil <= at) {
+            render(frame, at);
+        } else {
+            pending = frame;
+        }
+    };
+
+    const int64_t timerNanos = 1'000'000'000 / scenario.fps;
+    int64_t nextTimer = vsyncs.front();
+    for (const int64_t vsync : vsyncs) {
+        if (paced) {
+            if (rng.NextFloat(0.0f, 100.0f) < scenario.lostTickPercent) {
+                continue;
+            }
+            const FramePacer::Frame frame = pacer.OnVsync(vsync);
+            if (frame.render) {
+                post(frame, vsync + kCallbackLatencyNanos);
+            }
+            continue;
+        }
+        // Timer: frames at 1 / fps regardless of the display, shown when ready.
+        while (nextTimer <= vsync) {
+            FramePacer::Frame frame;
+            frame.render = true;
+            frame.vsyncNanos = nextTimer;
+            post(frame, nextTimer);
+            nextTimer += timerNanos;
+        }
+    }
+
+    Result result;
+    result.periodMs = pacer.VsyncPeriodNanos() / 1e6;
+    result.interval = paced ? pacer.SwapInterval() : 0;
+    result.stats = pacer.GetStats();
+    result.shown = static_cast<int>(shown.size());
+    // Cadence over the last 40%, after any rate switch has been learned.
+    const int expected = paced ? pacer.SwapInterval() : scenario.expectedInterval;
+    for (std::size_t i = shown.size() * 6 / 10 + 1; i < shown.size(); ++i) {
+        if (static_cast<int>(shown[i] - shown[i - 1]) != expected) {
+            ++result.uneven;
+        }
+    }
+    return result;
+}
+
+void PrintPaced(const char* name, const Result& result) {
+    std::printf("%-30s %-6s %7.3f %4d %6d %6d  ", name, "paced", result.periodMs, result.interval, result.shown,
+                result.uneven);
+    for (const uint64_t count : result.stats.lateVsyncs) {
+        std::printf(" %5llu", static_cast<unsigned long long>(count));
+    }
+    std::printf("\n");
+}
+
+// The timer has no vsync estimate or deadlines.
+void PrintTimer(const Result& result) {
+    std::printf("%-30s %-6s %7s %4s %6d %6d\n", "", "timer", "-", "-", result.shown, result.uneven);
+}
+
+}  // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"60 Hz, 60 fps", 60.0, 60, 6.0, 0.2, 0.0, 0.2, 1, true},
+        {"120 Hz, 60 fps", 120.0, 60, 6.0, 0.2, 0.0, 0.2, 2, true},
+        {"90 Hz, 60 fps", 90.0, 60, 6.0, 0.2, 0.0, 0.2, 2, true},
+        {"120 Hz, 120 fps, 10% lost", 120.0, 120, 4.0, 0.2, 10.0, 0.5, 1, false},
+        {"60 Hz, 60 fps, 1.3x budget", 60.0, 60, 21.7, 0.1, 0.0, 0.2, 1, false},
+        {"60 -> 120 Hz, 60 fps", 60.0, 60, 6.0, 0.2, 0.0, 0.2, 2, true, 120.0},
+    };
+
+    engine::bench::Random rng(22u);
+    bool ok = true;
+    std::printf("%-30s %-6s %7s %4s %6s %6s   late by 0..%d+ refreshes\n", "scenario", "mode", "vsync", "N",
+                "shown", "judder", FramePacer::kLateBuckets - 1);
+    for (const Scenario& scenario : scenarios) {
+        const Result paced = Simulate(scenario, true, rng);
+        PrintPaced(scenario.name, paced);
+        if (!scenario.lostTickPercent) {
+            PrintTimer(Simulate(scenario, false, rng));
+        }
+
+        const double refreshHz = scenario.switchToHz > 0.0 ? scenario.switchToHz : scenario.refreshHz;
+        const double periodMs = 1000.0 / refreshHz;
+        if (std::abs(paced.periodMs - periodMs) > periodMs * 0.01) {
+            std::fprintf(stderr, "%s: period %.3f ms, expected %.3f ms\n", scenario.name, paced.periodMs, periodMs);
+            ok = false;
+        }
+        if (paced.interval != scenario.expectedInterval) {
+            std::fprintf(stderr, "%s: swap interval %d, expected %d\n", scenario.name, paced.interval,
+                         scenario.expectedInterval);
+            ok = false;
+        }
+        if (scenario.fitsBudget && scenario.switchToHz == 0.0 && paced.stats.missedDeadlines > 0) {
+            std::fprintf(stderr, "%s: %llu missed deadlines\n", scenario.name,
+                         static_cast<unsigned long long>(paced.stats.missedDeadlines));
+            ok = false;
+        }
+        if (scenario.fitsBudget && paced.uneven > 0) {
+            std::fprintf(stderr, "%s: %d uneven frames\n", scenario.name, paced.uneven);
+            ok = false;
+        }
+        if (!scenario.fitsBudget && !scenario.lostTickPercent && paced.stats.missedDeadlines == 0) {
+            std::fprintf(stderr, "%s: over budget but no missed deadlines recorded\n", scenario.name);
+            ok = false;
+        }
+    }
+
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+// Loads every .glb in a directory (assets/3d by default) with the zero-copy
+// GlbAsset reader, validates the geometry it exposes and compares load plus
+// a full read of the vertex/index data against reading the file into a heap
+// buffer first. Also checks that a small GLB with out-of-range, negative,
+// fractional or huge JSON numbers is rejected. Exits non-zero if any asset
+// fails to load or validate, or a malformed file loads.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/glb_asset.h"
+
+namespace {
+
+constexpr std::size_t kBytesPerSample = 64u << 20;
+constexpr int kBenchSamples = 5;
+constexpr float kBoundsSlack = 1e-4f;
+
+struct GeometryStats {
+    std::size_t primitives{0};
+    std::size_t vertices{0};
+    std::size_t triangles{0};
+    uint64_t checksum{0};
+};
+
+bool Validate(const engine::GlbAsset& asset, GeometryStats* stats, std::string* problem) {
+    const auto& accessors = asset.Accessors();
+    for (const engine::GltfMesh& mesh : asset.Meshes()) {
+        for (const engine::GltfPrimitive& prim : mesh.primitives) {
+            const engine::GltfAccessor& position = accessors[static_cast<std::size_t>(prim.position)];
+            ++stats->primitives;
+            stats->vertices += position.count;
+
+            for (uint32_t v = 0; v < position.count; ++v) {
+                const engine::Vec3 p = position.Vec3At(v);
+                if (position.hasBounds &&
+                    (p.x < position.min.x - kBoundsSlack || p.x > position.max.x + kBoundsSlack ||
+                     p.y < position.min.y - kBoundsSlack || p.y > position.max.y + kBoundsSlack ||
+                     p.z < position.min.z - kBoundsSlack || p.z > position.max.z + kBoundsSlack)) {
+                    *problem = "position outside accessor bounds in mesh '" + mesh.name + "'";
+                    return false;
+                }
+            }
+
+            if (prim.indices >= 0) {
+                const engine::GltfAccessor& indices = accessors[static_cast<std::size_t>(prim.indices)];
+                for (uint32_t i = 0; i < indices.count; ++i) {
+                    const uint32_t index = indices.UintAt(i);
+                    if (index >= position.count) {
+                        *problem = "index out of range in mesh '" + mesh.name + "'";
+                        return false;
+                    }
+                    stats->checksum = stats->checksum * 31u + index;
+                }
+                stats->triangles += prim.mode == 4 ? indices.count / 3 : 0;
+            } else {
+                stats->triangles += prim.mode == 4 ? position.count / 3 : 0;
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t TouchGeometry(const engine::GlbAsset& asset) {
+    uint64_t sum = 0;
+    for (const engine::GltfAccessor& accessor : asset.Accessors()) {
+        sum += engine::bench::SumBytes(accessor.data);
+    }
+    return sum;
+}
+
+// Baseline: the conventional path of reading the whole file into a heap
+// buffer before parsing it.
+bool LoadCopied(const std::string& path, std::vector<uint8_t>* buffer, engine::GlbAsset* asset) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    buffer->resize(static_cast<std::size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    const bool read = std::fread(buffer->data(), 1, buffer->size(), file) == buffer->size();
+    std::fclose(file);
+    return read && asset->Parse(*buffer, nullptr);
+}
+
+// A one-triangle GLB around `json`, padded as the format requires.
+std::vector<uint8_t> BuildGlb(std::string json) {
+    json.resize((json.size() + 3u) & ~std::size_t{3}, ' ');
+    const float positions[9] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    const uint32_t header[5] = {0x46546C67u, 2u, static_cast<uint32_t>(12 + 8 + json.size() + 8 + sizeof(positions)),
+                                static_cast<uint32_t>(json.size()), 0x4E4F534Au};
+    const uint32_t binHeader[2] = {sizeof(positions), 0x004E4942u};
+    std::vector<uint8_t> glb(header[2]);
+    uint8_t* out = glb.data();
+    std::memcpy(out, header, sizeof(header));
+    std::memcpy(out += sizeof(header), json.data(), json.size());
+    std::memcpy(out += json.size(), binHeader, sizeof(binHeader));
+    std::memcpy(out + sizeof(binHeader), positions, sizeof(positions));
+    return glb;
+}
+
+// Numbers that must be rejected before they are cast to an integer type.
+bool CheckMalformedNumbers() {
+    const std::string valid =
+        R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":36}],)"
+        R"("bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":36}],)"
+        R"("accessors":[{"bufferView":0,"componentType":5126,"count":3,"type":"VEC3","byteOffset":0}],)"
+        R"("meshes":[{"primitives":[{"attributes":{"POSITION":0},"mode":4}]}],)"
+        R"("nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}]})";
+    const std::pair<const char*, const char*> edits[] = {
+        {R"("count":3)", R"("count":-1)"},
+        {R"("count":3)", R"("count":1.5)"},
+        {R"("count":3)", R"("count":1e30)"},
+        {R"("componentType":5126)", R"("componentType":5126.5)"},
+        {R"("VEC3","byteOffset":0)", R"("VEC3","byteOffset":1e30)"},
+        {R"("VEC3","byteOffset":0)", R"("VEC3","byteOffset":-4)"},
+        {R"([{"byteLength":36}])", R"([{"byteLength":-36}])"},
+        {R"("buffer":0,"byteOffset":0)", R"("buffer":0,"byteOffset":0.5)"},
+        {R"("byteOffset":0,"byteLength":36})", R"("byteOffset":0,"byteLength":1e300})"},
+        {R"("buffer":0,)", R"("buffer":0,"byteStride":-12,)"},
+        {R"("buffer":0,)", R"("buffer":0,"target":1e20,)"},
+        {R"("mode":4)", R"("mode":-4)"},
+        {R"("nodes":[0])", R"("nodes":[0.5])"},
+    };
+
+    std::vector<uint8_t> bytes = BuildGlb(valid);
+    engine::GlbAsset asset;
+    std::string error;
+    if (!asset.Parse(bytes, &error)) {
+        std::fprintf(stderr, "malformed numbers: baseline GLB rejected: %s\n", error.c_str());
+        return false;
+    }
+    bool ok = true;
+    for (const auto& [from, to] : edits) {
+        std::string json = valid;
+        json.replace(json.find(from), std::strlen(from), to);
+        bytes = BuildGlb(json);
+        if (asset.Parse(bytes, &error)) {
+            std::fprintf(stderr, "malformed numbers: accepted %s\n", to);
+            ok = false;
+        }
+    }
+    std::printf("malformed numbers: %zu variants rejected\n", ok ? std::size(edits) : 0);
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path directory = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", directory.c_str());
+        return 1;
+    }
+
+    std::printf("%-26s %9s %6s %6s %8s %8s %11s %11s %8s\n", "asset", "KiB", "meshes", "prims", "verts", "tris",
+                "mmap", "read+copy", "speedup");
+
+    bool ok = true;
+    for (const auto& file : files) {
+        const std::string path = file.string();
+        const std::string name = file.filename().string();
+
+        engine::GlbAsset asset;
+        std::string error;
+        if (!asset.Open(path.c_str(), &error)) {
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+
+        GeometryStats stats;
+        std::string problem;
+        if (!Validate(asset, &stats, &problem)) {
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), problem.c_str());
+            ok = false;
+            continue;
+        }
+
+        const std::size_t size = std::filesystem::file_size(file);
+        const int64_t iterations = static_cast<int64_t>(std::max<std::size_t>(1, kBytesPerSample / size));
+        const double mappedNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            engine::GlbAsset loaded;
+            loaded.Open(path.c_str(), nullptr);
+            engine::bench::DoNotOptimize(TouchGeometry(loaded));
+        });
+        const double copiedNs = engine::bench::MeasureNsPerIteration(iterations, kBenchSamples, [&](int64_t) {
+            engine::GlbAsset loaded;
+            std::vector<uint8_t> buffer;
+            LoadCopied(path, &buffer, &loaded);
+            engine::bench::DoNotOptimize(TouchGeometry(loaded));
+        });
+
+        std::printf("%-26s %9.1f %6zu %6zu %8zu %8zu %8.1f us %8.1f us %7.2fx\n", name.c_str(), size / 1024.0,
+                    asset.Meshes().size(), stats.primitives, stats.vertices, stats.triangles, mappedNs / 1000.0,
+                    copiedNs / 1000.0, mappedNs > 0.0 ? copiedNs / mappedNs : 0.0);
+    }
+
+    ok = CheckMalformedNumbers() && ok;
+    return ok ? 0 : 1;
+}
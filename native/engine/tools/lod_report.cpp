@@ -0,0 +1,144 @@
+// Reports the LOD chains the cooker builds (engine/core/mesh_simplifier.h)
+// for every .glb in a directory (assets/3d by default), then sweeps the
+// orbit camera from near to its 50-unit zoom limit and sums the triangles
+// that screen-space LOD selection (engine/core/lod_selector.h) would submit
+// for every instance of each asset at a 1080x2400 viewport.
+//
+//   lod_report [input_dir] [max_error_pixels=1]
+//
+// Exits non-zero if an asset fails to cook, a cooked blob does not load back,
+// or the submitted triangle count grows as the camera moves away.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "engine/core/camera.h"
+#include "engine/core/cooked_mesh.h"
+#include "engine/core/glb_asset.h"
+#include "engine/core/lod_selector.h"
+#include "engine/core/mesh_cooker.h"
+
+namespace {
+
+using engine::Vec3;
+
+constexpr float kDistances[] = {0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 50.0f};
+constexpr int kViewportWidth = 1080;
+constexpr int kViewportHeight = 2400;
+
+std::size_t SubmittedTriangles(const engine::CookedMesh& mesh, const engine::LodView& view) {
+    std::size_t triangles = 0;
+    for (const engine::cooked::Instance& instance : mesh.Instances()) {
+        engine::Mat4 world;
+        std::copy(std::begin(instance.world), std::end(instance.world), world.data.begin());
+        const engine::cooked::Submesh& submesh = mesh.Submeshes()[instance.submesh];
+        triangles += submesh.lods[engine::SelectLod(submesh, world, view)].indexCount / 3;
+    }
+    return triangles;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    const float maxErrorPixels = argc > 2 ? std::strtof(argv[2], nullptr) : 1.0f;
+
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    engine::OrbitCamera camera;
+    camera.SetViewport(kViewportWidth, kViewportHeight);
+    const Vec3 viewDirection = engine::Normalize(camera.EyePosition() - camera.Target());
+
+    std::printf("LOD chains (triangles per level, max object-space error of the coarsest level)\n");
+    std::printf("%-26s %8s %8s %8s %8s %10s %8s\n", "asset", "lod0", "lod1", "lod2", "lod3", "error", "cook");
+
+    bool ok = true;
+    std::vector<std::string> names;
+    std::vector<std::vector<uint8_t>> blobs;
+    for (const auto& file : files) {
+        const std::string name = file.filename().string();
+        engine::GlbAsset asset;
+        std::string error;
+        std::vector<uint8_t> blob;
+        engine::CookStats stats;
+        const auto start = std::chrono::steady_clock::now();
+        if (!asset.Open(file.c_str(), &error) || !engine::CookGlb(asset, &blob, &stats, &error)) {
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+        const double cookMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        engine::CookedMesh mesh;
+        if (!mesh.Parse(blob, &error)) {
+            std::fprintf(stderr, "%s: cooked output does not load back: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+        float coarsestError = 0.0f;
+        for (const engine::cooked::Submesh& submesh : mesh.Submeshes()) {
+            coarsestError = std::max(coarsestError, submesh.lods[submesh.lodCount - 1].error);
+        }
+        std::printf("%-26s %8zu %8zu %8zu %8zu %10.2e %5.0f ms\n", name.c_str(), stats.lodTriangles[0],
+                    stats.lodTriangles[1], stats.lodTriangles[2], stats.lodTriangles[3], coarsestError, cookMs);
+        names.push_back(name);
+        blobs.push_back(std::move(blob));
+    }
+
+    std::printf("\nTriangles submitted at %.1f px max error, by camera distance (%% of full detail)\n",
+                maxErrorPixels);
+    std::printf("%-26s", "asset");
+    for (const float distance : kDistances) {
+        std::printf(" %11.1f", distance);
+    }
+    std::printf("\n");
+
+    for (std::size_t i = 0; i < blobs.size(); ++i) {
+        engine::CookedMesh mesh;
+        mesh.Parse(blobs[i], nullptr);
+        const engine::cooked::Header& header = mesh.Header();
+        const Vec3 center((header.boundsMin[0] + header.boundsMax[0]) * 0.5f,
+                          (header.boundsMin[1] + header.boundsMax[1]) * 0.5f,
+                          (header.boundsMin[2] + header.boundsMax[2]) * 0.5f);
+
+        engine::LodView view = engine::MakeLodView(camera, maxErrorPixels);
+        view.eye = center;
+        const std::size_t full = SubmittedTriangles(mesh, view);
+
+        std::printf("%-26s", names[i].c_str());
+        std::size_t previous = full;
+        for (const float distance : kDistances) {
+            view.eye = center + viewDirection * distance;
+            const std::size_t submitted = SubmittedTriangles(mesh, view);
+            std::printf(" %7zu %3.0f", submitted, full ? 100.0 * submitted / full : 0.0);
+            if (submitted > previous) {
+                ok = false;
+            }
+            previous = submitted;
+        }
+        std::printf("\n");
+    }
+
+    if (!ok) {
+        std::fprintf(stderr, "LOD report failed\n");
+    }
+    return ok ? 0 : 1;
+}
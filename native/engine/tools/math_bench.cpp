@@ -0,0 +1,215 @@
+// Compares the SIMD math kernels in engine/core/math_types.h against the
+// scalar reference path: first a tolerance check over random inputs, then a
+// timing pass. Exits non-zero on a mismatch, or if Mat4 x Mat4 dispatches to
+// a SIMD kernel that is not faster than the scalar reference.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/math_types.h"
+
+namespace {
+
+using engine::Mat4;
+using engine::Vec3;
+using engine::Vec4;
+using engine::bench::Random;
+
+constexpr int kVerifyCases = 200'000;
+// Operands stay in L1, so the timings are the kernels' and not cache misses.
+constexpr int kBenchCount = 256;
+constexpr int64_t kBenchIterations = 2'000'000;
+constexpr int kBenchSamples = 5;
+
+// Results within kMaxUlp units in the last place, or within kAbsEpsilon of
+// each other (for values near zero where ULP distance is meaningless), pass.
+constexpr uint32_t kMaxUlp = 4;
+constexpr float kAbsEpsilon = 1e-6f;
+
+uint32_t UlpDistance(float a, float b) {
+    if (a == b) {
+        return 0;
+    }
+    int32_t ia = 0;
+    int32_t ib = 0;
+    std::memcpy(&ia, &a, sizeof(a));
+    std::memcpy(&ib, &b, sizeof(b));
+    // Map the sign-magnitude representation onto a monotonic integer line.
+    if (ia < 0) {
+        ia = INT32_MIN - ia;
+    }
+    if (ib < 0) {
+        ib = INT32_MIN - ib;
+    }
+    const int64_t diff = static_cast<int64_t>(ia) - static_cast<int64_t>(ib);
+    return static_cast<uint32_t>(std::min<int64_t>(diff < 0 ? -diff : diff, UINT32_MAX));
+}
+
+struct Tolerance {
+    uint32_t maxUlp{0};
+    int failures{0};
+
+    void Check(const float* expected, const float* actual, int count) {
+        for (int i = 0; i < count; ++i) {
+            const uint32_t ulp = UlpDistance(expected[i], actual[i]);
+            if (std::fabs(expected[i] - actual[i]) <= kAbsEpsilon) {
+                continue;
+            }
+            maxUlp = std::max(maxUlp, ulp);
+            if (ulp > kMaxUlp) {
+                ++failures;
+            }
+        }
+    }
+};
+
+Mat4 RandomMat4(Random& rng) {
+    Mat4 m;
+    for (float& value : m.data) {
+        value = rng.NextFloat(-4.0f, 4.0f);
+    }
+    return m;
+}
+
+Vec3 RandomVec3(Random& rng, float extent) {
+    return Vec3{rng.NextFloat(-extent, extent), rng.NextFloat(-extent, extent), rng.NextFloat(-extent, extent)};
+}
+
+#if defined(ENGINE_MATH_SIMD)
+bool Verify() {
+    Random rng(0xC0FFEEu);
+    Tolerance mulMat;
+    Tolerance mulVec;
+    Tolerance lookAt;
+    Tolerance perspective;
+
+    for (int i = 0; i < kVerifyCases; ++i) {
+        const Mat4 a = RandomMat4(rng);
+        const Mat4 b = RandomMat4(rng);
+        const Mat4 refMM = engine::scalar::Multiply(a, b);
+        const Mat4 simdMM = engine::simd::Multiply(a, b);
+        mulMat.Check(refMM.Ptr(), simdMM.Ptr(), 16);
+
+        const Vec4 v{rng.NextFloat(-8.0f, 8.0f), rng.NextFloat(-8.0f, 8.0f), rng.NextFloat(-8.0f, 8.0f), 1.0f};
+        const Vec4 refMV = engine::scalar::Multiply(a, v);
+        const Vec4 simdMV = engine::simd::Multiply(a, v);
+        mulVec.Check(&refMV.x, &simdMV.x, 4);
+
+        const Vec3 eye = RandomVec3(rng, 50.0f);
+        const Vec3 center = RandomVec3(rng, 5.0f);
+        const Vec3 up{0.0f, 1.0f, 0.0f};
+        const Mat4 refLA = engine::scalar::LookAt(eye, center, up);
+        const Mat4 simdLA = engine::simd::LookAt(eye, center, up);
+        lookAt.Check(refLA.Ptr(), simdLA.Ptr(), 16);
+
+        const float fovy = rng.NextFloat(0.2f, 2.5f);
+        const float aspect = rng.NextFloat(0.3f, 3.0f);
+        const Mat4 refP = engine::scalar::Perspective(fovy, aspect, 0.1f, 500.0f);
+        const Mat4 simdP = engine::simd::Perspective(fovy, aspect, 0.1f, 500.0f);
+        perspective.Check(refP.Ptr(), simdP.Ptr(), 16);
+    }
+
+    const struct {
+        const char* name;
+        const Tolerance& tolerance;
+    } results[] = {
+        {"Multiply(Mat4, Mat4)", mulMat},
+        {"Multiply(Mat4, Vec4)", mulVec},
+        {"LookAt", lookAt},
+        {"Perspective", perspective},
+    };
+
+    bool ok = true;
+    std::printf("Tolerance check (%d cases, max %u ulp)\n", kVerifyCases, kMaxUlp);
+    for (const auto& result : results) {
+        std::printf("  %-24s max %u ulp, %d failures\n", result.name, result.tolerance.maxUlp, result.tolerance.failures);
+        ok = ok && result.tolerance.failures == 0;
+    }
+    return ok;
+}
+#endif
+
+bool Bench() {
+    Random rng(1234u);
+    std::vector<Mat4> mats(kBenchCount);
+    std::vector<Vec4> vecs(kBenchCount);
+    std::vector<Vec3> eyes(kBenchCount);
+    for (int i = 0; i < kBenchCount; ++i) {
+        mats[i] = RandomMat4(rng);
+        vecs[i] = Vec4{rng.NextFloat(-8.0f, 8.0f), rng.NextFloat(-8.0f, 8.0f), rng.NextFloat(-8.0f, 8.0f), 1.0f};
+        eyes[i] = RandomVec3(rng, 50.0f);
+    }
+    const Vec3 center{0.0f, 0.0f, 0.0f};
+    const Vec3 up{0.0f, 1.0f, 0.0f};
+    constexpr int kMask = kBenchCount - 1;
+
+    std::printf("\n%-28s %13s %13s %9s\n", "kernel", "scalar", engine::kMathBackend, "speedup");
+
+    using engine::bench::DoNotOptimize;
+    using engine::bench::MeasureNsPerIteration;
+    using engine::bench::PrintRow;
+
+    const double scalarMulMatNs = MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+        DoNotOptimize(engine::scalar::Multiply(mats[i & kMask], mats[(i + 1) & kMask]));
+    });
+    const double mulMatNs = MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+        DoNotOptimize(engine::Multiply(mats[i & kMask], mats[(i + 1) & kMask]));
+    });
+    PrintRow("Multiply(Mat4, Mat4)", scalarMulMatNs, mulMatNs);
+
+    PrintRow("Multiply(Mat4, Vec4)",
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::scalar::Multiply(mats[i & kMask], vecs[i & kMask]));
+             }),
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::Multiply(mats[i & kMask], vecs[i & kMask]));
+             }));
+
+    PrintRow("LookAt",
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::scalar::LookAt(eyes[i & kMask], center, up));
+             }),
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::LookAt(eyes[i & kMask], center, up));
+             }));
+
+    PrintRow("Perspective",
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::scalar::Perspective(0.87f, 1.0f + static_cast<float>(i & 7), 0.1f, 500.0f));
+             }),
+             MeasureNsPerIteration(kBenchIterations, kBenchSamples, [&](int64_t i) {
+                 DoNotOptimize(engine::Perspective(0.87f, 1.0f + static_cast<float>(i & 7), 0.1f, 500.0f));
+             }));
+
+#if defined(ENGINE_MATH_SIMD_MAT4_MULTIPLY)
+    if (mulMatNs >= scalarMulMatNs) {
+        std::fprintf(stderr, "SIMD Multiply(Mat4, Mat4) is not faster than the scalar reference\n");
+        return false;
+    }
+#else
+    std::printf("Multiply(Mat4, Mat4) uses the scalar reference on this backend\n");
+#endif
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Math backend: %s\n", engine::kMathBackend);
+
+#if defined(ENGINE_MATH_SIMD)
+    if (!Verify()) {
+        std::fprintf(stderr, "SIMD kernels diverge from the scalar reference\n");
+        return 1;
+    }
+#else
+    std::printf("Scalar backend selected; nothing to verify\n");
+#endif
+
+    return Bench() ? 0 : 1;
+}
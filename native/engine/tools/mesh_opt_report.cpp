@@ -0,0 +1,215 @@
+// Reports what the cooker's index optimisation (engine/core/mesh_optimizer.h)
+// does for every .glb in a directory (assets/3d by default): ACMR and ATVR
+// for 16- and 32-entry FIFO post-transform caches, vertex fetch overfetch for
+// cooked 12-byte vertices, and optimisation time. Exported index order is
+// often already cache friendly, so each primitive is also optimised from a
+// randomly shuffled triangle order to show what the optimiser recovers.
+//
+//   mesh_opt_report [input_dir]
+//
+// Exits non-zero if an optimised primitive no longer draws the same
+// triangles or ends up with a worse 32-entry ACMR than its input order.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/cooked_mesh.h"
+#include "engine/core/glb_asset.h"
+#include "engine/core/mesh_optimizer.h"
+
+namespace {
+
+using engine::Vec3;
+
+constexpr uint32_t kTriangles = 4;
+constexpr float kOverdrawThreshold = 1.05f;
+constexpr unsigned kCacheSizes[] = {16, 32};
+
+struct Totals {
+    std::size_t triangles{0};
+    std::size_t referenced{0};
+    std::size_t transformed[2]{};
+    double fetchedVertices{0.0};
+
+    void Add(const std::vector<uint32_t>& indices, std::size_t vertexCount) {
+        triangles += indices.size() / 3;
+        for (std::size_t c = 0; c < 2; ++c) {
+            transformed[c] +=
+                engine::AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, kCacheSizes[c]).transformed;
+        }
+        std::vector<uint8_t> seen(vertexCount, 0);
+        std::size_t unique = 0;
+        for (const uint32_t index : indices) {
+            unique += seen[index] ? 0 : 1;
+            seen[index] = 1;
+        }
+        referenced += unique;
+        fetchedVertices += engine::AnalyzeVertexFetch(indices.data(), indices.size(), vertexCount,
+                                                      sizeof(engine::cooked::Vertex)) *
+                           static_cast<double>(vertexCount);
+    }
+
+    void Merge(const Totals& other) {
+        triangles += other.triangles;
+        referenced += other.referenced;
+        transformed[0] += other.transformed[0];
+        transformed[1] += other.transformed[1];
+        fetchedVertices += other.fetchedVertices;
+    }
+
+    double Acmr(std::size_t c) const { return triangles ? static_cast<double>(transformed[c]) / triangles : 0.0; }
+    double Atvr(std::size_t c) const { return referenced ? static_cast<double>(transformed[c]) / referenced : 0.0; }
+    double Overfetch() const { return referenced ? fetchedVertices / referenced : 0.0; }
+};
+
+void ShuffleTriangles(std::vector<uint32_t>* indices, engine::bench::Random* rng) {
+    for (std::size_t t = indices->size() / 3; t > 1; --t) {
+        const std::size_t other = rng->NextU32() % t;
+        std::swap_ranges(indices->begin() + static_cast<std::ptrdiff_t>((t - 1) * 3),
+                         indices->begin() + static_cast<std::ptrdiff_t>(t * 3),
+                         indices->begin() + static_cast<std::ptrdiff_t>(other * 3));
+    }
+}
+
+// The cooker's passes, in its order; returns the referenced vertex count.
+std::size_t Optimise(std::vector<uint32_t>* indices, const std::vector<Vec3>& positions,
+                     std::vector<uint32_t>* oldToNew) {
+    engine::OptimizeVertexCache(indices->data(), indices->size(), positions.size());
+    engine::OptimizeOverdraw(indices->data(), indices->size(), positions.data(), positions.size(), kOverdrawThreshold);
+    return engine::OptimizeVertexFetch(indices->data(), indices->size(), positions.size(), oldToNew);
+}
+
+// Triangles rotated to start at their smallest index (keeping winding), sorted.
+std::vector<std::array<uint32_t, 3>> CanonicalTriangles(const std::vector<uint32_t>& indices) {
+    std::vector<std::array<uint32_t, 3>> tris;
+    tris.reserve(indices.size() / 3);
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<uint32_t, 3> t{indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        tris.push_back(t);
+    }
+    std::sort(tris.begin(), tris.end());
+    return tris;
+}
+
+bool SameTriangles(const std::vector<uint32_t>& source, const std::vector<uint32_t>& optimised,
+                   const std::vector<uint32_t>& oldToNew) {
+    std::vector<uint32_t> remapped(source.size());
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        remapped[i] = oldToNew[source[i]];
+    }
+    return CanonicalTriangles(remapped) == CanonicalTriangles(optimised);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    std::printf("%-26s %7s %13s %13s %13s %11s %13s %8s\n", "asset", "tris", "ACMR16", "ACMR32", "ATVR32",
+                "overfetch", "shuffled32", "time");
+
+    engine::bench::Random rng(7u);
+    bool ok = true;
+    Totals allBefore;
+    Totals allAfter;
+    Totals allShuffledBefore;
+    Totals allShuffledAfter;
+    for (const auto& file : files) {
+        const std::string name = file.filename().string();
+        engine::GlbAsset asset;
+        std::string error;
+        if (!asset.Open(file.c_str(), &error)) {
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), error.c_str());
+            ok = false;
+            continue;
+        }
+
+        Totals before;
+        Totals after;
+        Totals shuffledBefore;
+        Totals shuffledAfter;
+        double optimiseMs = 0.0;
+        for (const engine::GltfMesh& mesh : asset.Meshes()) {
+            for (const engine::GltfPrimitive& primitive : mesh.primitives) {
+                if (primitive.mode != kTriangles || primitive.indices < 0) {
+                    continue;
+                }
+                const engine::GltfAccessor& positionAccessor =
+                    asset.Accessors()[static_cast<std::size_t>(primitive.position)];
+                const engine::GltfAccessor& indexAccessor =
+                    asset.Accessors()[static_cast<std::size_t>(primitive.indices)];
+                std::vector<Vec3> positions(positionAccessor.count);
+                for (std::size_t i = 0; i < positions.size(); ++i) {
+                    positions[i] = positionAccessor.Vec3At(i);
+                }
+                std::vector<uint32_t> indices(indexAccessor.count / 3 * 3);
+                for (std::size_t i = 0; i < indices.size(); ++i) {
+                    indices[i] = indexAccessor.UintAt(i);
+                }
+
+                std::vector<uint32_t> optimised = indices;
+                std::vector<uint32_t> oldToNew;
+                const auto start = std::chrono::steady_clock::now();
+                const std::size_t usedCount = Optimise(&optimised, positions, &oldToNew);
+                optimiseMs +=
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                before.Add(indices, positions.size());
+                after.Add(optimised, usedCount);
+                bool same = SameTriangles(indices, optimised, oldToNew);
+
+                std::vector<uint32_t> shuffled = indices;
+                ShuffleTriangles(&shuffled, &rng);
+                std::vector<uint32_t> shuffledOptimised = shuffled;
+                const std::size_t shuffledUsed = Optimise(&shuffledOptimised, positions, &oldToNew);
+                shuffledBefore.Add(shuffled, positions.size());
+                shuffledAfter.Add(shuffledOptimised, shuffledUsed);
+                same = same && SameTriangles(shuffled, shuffledOptimised, oldToNew);
+
+                if (!same) {
+                    std::fprintf(stderr, "%s: optimised primitive draws different triangles\n", name.c_str());
+                    ok = false;
+                }
+            }
+        }
+
+        if (after.Acmr(1) > before.Acmr(1) + 1e-6 || shuffledAfter.Acmr(1) > shuffledBefore.Acmr(1) + 1e-6) {
+            std::fprintf(stderr, "%s: ACMR32 got worse\n", name.c_str());
+            ok = false;
+        }
+        std::printf("%-26s %7zu %6.3f/%-6.3f %6.3f/%-6.3f %6.3f/%-6.3f %5.2f/%-5.2f %6.3f/%-6.3f %5.1f ms\n",
+                    name.c_str(), before.triangles, before.Acmr(0), after.Acmr(0), before.Acmr(1), after.Acmr(1),
+                    before.Atvr(1), after.Atvr(1), before.Overfetch(), after.Overfetch(), shuffledBefore.Acmr(1),
+                    shuffledAfter.Acmr(1), optimiseMs);
+
+        allBefore.Merge(before);
+        allAfter.Merge(after);
+        allShuffledBefore.Merge(shuffledBefore);
+        allShuffledAfter.Merge(shuffledAfter);
+    }
+
+    std::printf("total over %zu triangles: ACMR32 %.3f -> %.3f, shuffled %.3f -> %.3f, overfetch %.2f -> %.2f\n",
+                allBefore.triangles, allBefore.Acmr(1), allAfter.Acmr(1), allShuffledBefore.Acmr(1),
+                allShuffledAfter.Acmr(1), allBefore.Overfetch(), allAfter.Overfetch());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+// Streams every .glb in a directory (assets/3d by default) through
+// AssetStreamer and GpuModel on a headless EGL context, with the same
+// per-frame upload budget as the Android renderer, and reports when each
+// model becomes drawable. For comparison it also times the old synchronous
+// path (decode + full upload on the render thread). Exits non-zero if a model
+// fails to load, a frame exceeds the byte budget, or GL reports an error.
+//
+//   stream_check [input_dir]
+
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headless_egl.h"
+#include "engine/core/asset_streamer.h"
+#include "engine/core/gl_state_cache.h"
+#include "engine/core/gpu_model.h"
+#include "engine/core/shader_program.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Mirrors engine_renderer.cpp.
+constexpr std::size_t kUploadBudgetBytes = 1024 * 1024;
+constexpr double kUploadBudgetMs = 2.0;
+constexpr auto kFrameInterval = std::chrono::microseconds(16'667);
+constexpr auto kTimeout = std::chrono::seconds(60);
+
+const char* kVertexSrc = R"(#version 300 es
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aNormal;
+void main() {
+    gl_Position = vec4(aPosition * 2.0 - 1.0 + vec3(aNormal, 0.0) * 0.0, 1.0);
+}
+)";
+
+const char* kFragmentSrc = R"(#version 300 es
+precision mediump float;
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(1.0);
+}
+)";
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void DrawAll(const engine::GpuModel& model) {
+    for (std::size_t i = 0; i < model.Submeshes().size(); ++i) {
+        const engine::cooked::Submesh& submesh = model.Submeshes()[i];
+        model.Bind(i);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(submesh.lods[0].indexCount), submesh.indexType,
+                       reinterpret_cast<const void*>(static_cast<uintptr_t>(submesh.lods[0].indexOffset)));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path inputDir = argc > 1 ? argv[1] : ENGINE_ASSETS_DIR;
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".glb") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No .glb files found in %s\n", inputDir.c_str());
+        return 1;
+    }
+
+    engine::tools::HeadlessContext headless;
+    if (!headless.Create()) {
+        std::fprintf(stderr, "No headless EGL/GLES 3 context available (0x%x)\n", eglGetError());
+        return 1;
+    }
+    engine::ShaderProgram program;
+    if (!program.Compile(kVertexSrc, kFragmentSrc)) {
+        std::fprintf(stderr, "Failed to build the draw program\n");
+        return 1;
+    }
+    engine::GlStateCache::Current().UseProgram(program.Id());
+
+    bool ok = true;
+
+    // Synchronous baseline: what the first frame would wait for if every
+    // model were decoded and uploaded inline.
+    double synchronousMs = 0.0;
+    for (const auto& file : files) {
+        const Clock::time_point start = Clock::now();
+        engine::AssetStreamer single(1);
+        single.Request(file.filename().string(), engine::AssetStreamer::FileReader(file.string()));
+        std::vector<std::unique_ptr<engine::DecodedModel>> done;
+        while (done.empty()) {
+            single.TakeCompleted(&done);
+        }
+        if (!done.front()->ok) {
+            continue;
+        }
+        engine::GpuModel model(std::move(done.front()));
+        while (!model.Ready()) {
+            model.Upload(SIZE_MAX);
+        }
+        glFinish();
+        synchronousMs += MsSince(start);
+    }
+
+    engine::AssetStreamer streamer;
+    const Clock::time_point start = Clock::now();
+    struct Slot {
+        std::string name;
+        uint64_t id{0};
+        std::unique_ptr<engine::GpuModel> gpu;
+        double visibleMs{-1.0};
+        int uploadFrames{0};
+    };
+    std::vector<Slot> slots;
+    for (const auto& file : files) {
+        Slot slot;
+        slot.name = file.filename().string();
+        slot.id = streamer.Request(slot.name, engine::AssetStreamer::FileReader(file.string()));
+        slots.push_back(std::move(slot));
+    }
+    const double requestMs = MsSince(start);
+
+    int frames = 0;
+    std::size_t visible = 0;
+    std::size_t maxFrameBytes = 0;
+    double maxFrameUploadMs = 0.0;
+    double firstFrameMs = -1.0;
+    Clock::time_point nextFrame = Clock::now();
+    while (visible < slots.size() && Clock::now() - start < kTimeout) {
+        std::this_thread::sleep_until(nextFrame);
+        nextFrame += kFrameInterval;
+        ++frames;
+
+        std::vector<std::unique_ptr<engine::DecodedModel>> completed;
+        streamer.TakeCompleted(&completed);
+        for (auto& decoded : completed) {
+            auto slot = std::find_if(slots.begin(), slots.end(), [&](const Slot& s) { return s.id == decoded->id; });
+            if (!decoded->ok) {
+                std::fprintf(stderr, "%s: %s\n", decoded->name.c_str(), decoded->error.c_str());
+                ok = false;
+                slot->visibleMs = 0.0;
+                ++visible;
+                continue;
+            }
+            slot->gpu = std::make_unique<engine::GpuModel>(std::move(decoded));
+        }
+
+        const Clock::time_point uploadStart = Clock::now();
+        std::size_t uploaded = 0;
+        for (Slot& slot : slots) {
+            if (!slot.gpu || slot.gpu->Ready()) {
+                continue;
+            }
+            ++slot.uploadFrames;
+            while (!slot.gpu->Ready() && uploaded < kUploadBudgetBytes && MsSince(uploadStart) < kUploadBudgetMs) {
+                uploaded += slot.gpu->Upload(kUploadBudgetBytes - uploaded);
+            }
+            if (slot.gpu->Ready()) {
+                slot.visibleMs = MsSince(start);
+                ++visible;
+            }
+        }
+        maxFrameBytes = std::max(maxFrameBytes, uploaded);
+        maxFrameUploadMs = std::max(maxFrameUploadMs, MsSince(uploadStart));
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (const Slot& slot : slots) {
+            if (slot.gpu && slot.gpu->Ready()) {
+                DrawAll(*slot.gpu);
+            }
+        }
+        glFinish();
+        if (firstFrameMs < 0.0) {
+            firstFrameMs = MsSince(start);
+        }
+    }
+
+    std::printf("%-26s %12s %14s\n", "asset", "visible at", "upload frames");
+    for (const Slot& slot : slots) {
+        std::printf("%-26s %9.1f ms %14d\n", slot.name.c_str(), slot.visibleMs, slot.uploadFrames);
+        if (slot.visibleMs < 0.0) {
+            std::fprintf(stderr, "%s never became visible\n", slot.name.c_str());
+            ok = false;
+        }
+    }
+    std::printf("requests queued in %.3f ms, first frame %.1f ms after start, all visible after %d frames\n",
+                requestMs, firstFrameMs, frames);
+    std::printf("per-frame upload: max %.1f KiB (budget %zu KiB), max %.2f ms (budget %.1f ms)\n",
+                maxFrameBytes / 1024.0, kUploadBudgetBytes / 1024, maxFrameUploadMs, kUploadBudgetMs);
+    std::printf("synchronous decode + upload of the same assets: %.1f ms on the render thread\n", synchronousMs);
+
+    const GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        std::fprintf(stderr, "GL error 0x%x\n", glError);
+        ok = false;
+    }
+    if (maxFrameBytes > kUploadBudgetBytes) {
+        std::fprintf(stderr, "a frame uploaded more than the budget\n");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
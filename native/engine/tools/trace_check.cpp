@@ -0,0 +1,211 @@
+// Checks hot-path tracing (engine/core/trace.h), built here with
+// ENGINE_TRACE defined whatever engine_core was configured with:
+//   - zones and counters recorded on several threads at once all reach the
+//     export, on their own named tracks, nested inside their parents;
+//   - the export is valid JSON in the Chrome trace event format;
+//   - Start discards the previous recording, and nothing is recorded while
+//     stopped;
+//   - a full thread buffer drops events and reports how many.
+// Then times a zone while recording and while stopped, the cost a traced
+// build adds to every instrumented scope.
+//
+// Exits non-zero if any check fails.
+
+#include <cstdio>
+#include <cstring>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/json.h"
+#include "engine/core/trace.h"
+
+namespace {
+
+constexpr int kThreads = 4;
+constexpr int kFramesPerThread = 1'000;
+// ts and dur are exported rounded to the nanosecond.
+constexpr double kRoundingUs = 0.002;
+
+struct EventCounts {
+    int zones{0};
+    int counters{0};
+    int threadNames{0};
+    int nested{0};
+    double dropped{-1.0};
+};
+
+bool Fail(const char* what) {
+    std::fprintf(stderr, "%s\n", what);
+    return false;
+}
+
+void RecordFrames(int frames) {
+    for (int i = 0; i < frames; ++i) {
+        ENGINE_TRACE_SCOPE("Frame");
+        {
+            ENGINE_TRACE_SCOPE("Draw \"quoted\"");
+            engine::bench::DoNotOptimize(i);
+        }
+        ENGINE_TRACE_COUNTER("frame", i);
+    }
+}
+
+// Parses the export and counts what it holds; false if it is not a trace.
+bool Parse(EventCounts* counts) {
+    engine::JsonValue root;
+    std::string error;
+    if (!engine::ParseJson(engine::trace::ChromeJson(), &root, &error)) {
+        std::fprintf(stderr, "Invalid trace JSON: %s\n", error.c_str());
+        return false;
+    }
+    const engine::JsonValue* events = root.Find("traceEvents");
+    if (!events || !events->IsArray()) {
+        return Fail("No traceEvents array");
+    }
+
+    // "X" events of one thread are written in end order, so a zone's parent
+    // follows it and encloses it.
+    struct Span {
+        double tid;
+        double start;
+        double end;
+    };
+    std::vector<Span> spans;
+    for (const engine::JsonValue& event : events->array) {
+        const std::string_view phase = event.StringOr("ph", "");
+        if (phase == "X") {
+            ++counts->zones;
+            const double ts = event.NumberOr("ts", -1.0);
+            const double dur = event.NumberOr("dur", -1.0);
+            if (ts < 0.0 || dur < 0.0 || !event.Find("tid")) {
+                return Fail("Zone without a timestamp, duration or thread");
+            }
+            spans.push_back({event.NumberOr("tid", 0.0), ts, ts + dur});
+        } else if (phase == "C") {
+            ++counts->counters;
+            const engine::JsonValue* args = event.Find("args");
+            if (!args || !args->Find("value")) {
+                return Fail("Counter without a value");
+            }
+        } else if (phase == "M") {
+            ++counts->threadNames;
+        } else {
+            return Fail("Unexpected event phase");
+        }
+    }
+    for (std::size_t i = 0; i + 1 < spans.size(); ++i) {
+        const Span& child = spans[i];
+        const Span& parent = spans[i + 1];
+        if (child.tid == parent.tid && parent.start <= child.start && child.end <= parent.end + kRoundingUs) {
+            ++counts->nested;
+        }
+    }
+    if (const engine::JsonValue* other = root.Find("otherData")) {
+        counts->dropped = other->NumberOr("droppedEvents", -1.0);
+    }
+    return true;
+}
+
+bool CheckThreads() {
+    engine::trace::Start();
+    // Held until every thread has recorded: a thread that exits early hands
+    // its buffer to the next one.
+    std::latch done(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&done]() {
+            ENGINE_TRACE_THREAD_NAME("TraceWorker");
+            RecordFrames(kFramesPerThread);
+            done.arrive_and_wait();
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    engine::trace::Stop();
+
+    EventCounts counts;
+    if (!Parse(&counts)) {
+        return false;
+    }
+    std::printf("threads: %d zones, %d counters, %d named threads, %d nested\n", counts.zones, counts.counters,
+                counts.threadNames, counts.nested);
+    bool ok = true;
+    if (counts.zones != kThreads * kFramesPerThread * 2 || counts.counters != kThreads * kFramesPerThread) {
+        ok = Fail("Events missing from a multithreaded recording");
+    }
+    if (counts.threadNames < kThreads) {
+        ok = Fail("Thread names missing");
+    }
+    if (counts.nested != kThreads * kFramesPerThread) {
+        ok = Fail("Inner zones not enclosed by their frames");
+    }
+    return counts.dropped == 0.0 && ok;
+}
+
+bool CheckRestart() {
+    engine::trace::Start();
+    RecordFrames(10);
+    engine::trace::Start();
+    RecordFrames(3);
+    engine::trace::Stop();
+    RecordFrames(5);
+
+    EventCounts counts;
+    if (!Parse(&counts)) {
+        return false;
+    }
+    std::printf("restart: %d zones, %d counters\n", counts.zones, counts.counters);
+    if (counts.zones != 6 || counts.counters != 3) {
+        return Fail("Start kept the previous recording or events were recorded while stopped");
+    }
+    return !engine::trace::IsRecording();
+}
+
+bool CheckOverflow() {
+    engine::trace::Start();
+    constexpr int kFrames = 20'000;  // 60k events, more than a buffer holds.
+    std::thread([]() { RecordFrames(kFrames); }).join();
+    engine::trace::Stop();
+
+    EventCounts counts;
+    if (!Parse(&counts)) {
+        return false;
+    }
+    const int recorded = counts.zones + counts.counters;
+    std::printf("overflow: %d recorded, %.0f dropped\n", recorded, counts.dropped);
+    if (counts.dropped <= 0.0 || recorded + static_cast<int>(counts.dropped) != kFrames * 3) {
+        return Fail("Dropped events not accounted for");
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = CheckThreads();
+    ok = CheckRestart() && ok;
+    ok = CheckOverflow() && ok;
+
+    const double stoppedNs = engine::bench::MeasureNsPerIteration(1'000'000, 5, [](int64_t i) {
+        ENGINE_TRACE_SCOPE("Stopped");
+        engine::bench::DoNotOptimize(i);
+    });
+    // Restarted per sample so the buffer never fills; a dropped event would
+    // be cheaper than a recorded one.
+    const double recordingNs = engine::bench::MeasureNsPerIteration(20'000, 5, [](int64_t i) {
+        if (i == 0) {
+            engine::trace::Start();
+        }
+        ENGINE_TRACE_SCOPE("Recording");
+        engine::bench::DoNotOptimize(i);
+    });
+    engine::trace::Stop();
+    std::printf("zone: %.1f ns recording, %.1f ns stopped\n", recordingNs, stoppedNs);
+
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
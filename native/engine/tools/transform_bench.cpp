@@ -0,0 +1,103 @@
+// Benchmarks engine::ComputeWorldTransforms (SoA, SIMD) against the scalar
+// per-instance path for batches of 10 to 100k parts, after checking that both
+// produce the same matrices.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "bench_util.h"
+#include "engine/core/math_types.h"
+#include "engine/core/transform_batch.h"
+
+namespace {
+
+using engine::Mat4;
+using engine::Vec3;
+using engine::Vec4;
+using engine::bench::Random;
+
+constexpr std::size_t kBatchSizes[] = {10, 100, 1'000, 10'000, 100'000};
+constexpr std::size_t kInstancesPerSample = 2'000'000;
+constexpr int kBenchSamples = 5;
+constexpr float kRelativeTolerance = 1e-5f;
+
+void FillRandom(engine::TransformSoA& locals, std::size_t count, Random& rng) {
+    locals.Resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Vec4 q{rng.NextFloat(-1.0f, 1.0f), rng.NextFloat(-1.0f, 1.0f), rng.NextFloat(-1.0f, 1.0f), rng.NextFloat(-1.0f, 1.0f)};
+        const float invLen = 1.0f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        q = Vec4{q.x * invLen, q.y * invLen, q.z * invLen, q.w * invLen};
+        locals.Set(i,
+                   Vec3{rng.NextFloat(-10.0f, 10.0f), rng.NextFloat(-10.0f, 10.0f), rng.NextFloat(-10.0f, 10.0f)},
+                   q,
+                   Vec3{rng.NextFloat(0.5f, 2.0f), rng.NextFloat(0.5f, 2.0f), rng.NextFloat(0.5f, 2.0f)});
+    }
+}
+
+int CountMismatches(const std::vector<Mat4>& expected, const std::vector<Mat4>& actual) {
+    int mismatches = 0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        for (int e = 0; e < 16; ++e) {
+            const float a = expected[i].data[e];
+            const float b = actual[i].data[e];
+            const float scale = std::fmax(1.0f, std::fabs(a));
+            if (std::fabs(a - b) > kRelativeTolerance * scale) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+int main() {
+    Random rng(42u);
+    const Mat4 root = engine::ComposeTransform(Vec3{0.0f, 1.0f, 0.0f}, Vec4{0.0f, 0.38268343f, 0.0f, 0.92387953f}, Vec3{1.0f, 1.0f, 1.0f});
+    const Mat4 viewProj = engine::Multiply(
+        engine::Perspective(engine::Radians(50.0f), 16.0f / 9.0f, 0.1f, 500.0f),
+        engine::LookAt(Vec3{4.0f, 3.5f, 4.0f}, Vec3{0.0f, 0.0f, 0.0f}, Vec3{0.0f, 1.0f, 0.0f}));
+
+    std::printf("Math backend: %s\n", engine::kMathBackend);
+    std::printf("%10s %14s %14s %12s %12s %9s\n", "instances", "scalar/frame", "batch/frame", "scalar/inst", "batch/inst", "speedup");
+
+    bool ok = true;
+    for (const std::size_t count : kBatchSizes) {
+        engine::TransformSoA locals;
+        FillRandom(locals, count, rng);
+
+        std::vector<Mat4> refWorld(count);
+        std::vector<Mat4> refWvp(count);
+        std::vector<Mat4> world(count);
+        std::vector<Mat4> wvp(count);
+
+        engine::ComputeWorldTransformsScalar(locals, root, viewProj, refWorld.data(), refWvp.data());
+        engine::ComputeWorldTransforms(locals, root, viewProj, world.data(), wvp.data());
+        const int mismatches = CountMismatches(refWorld, world) + CountMismatches(refWvp, wvp);
+        if (mismatches > 0) {
+            std::fprintf(stderr, "%zu instances: %d elements outside tolerance\n", count, mismatches);
+            ok = false;
+        }
+
+        const int64_t frames = static_cast<int64_t>(kInstancesPerSample / count);
+        const double scalarNs = engine::bench::MeasureNsPerIteration(frames, kBenchSamples, [&](int64_t) {
+            engine::ComputeWorldTransformsScalar(locals, root, viewProj, world.data(), wvp.data());
+        });
+        const double batchNs = engine::bench::MeasureNsPerIteration(frames, kBenchSamples, [&](int64_t) {
+            engine::ComputeWorldTransforms(locals, root, viewProj, world.data(), wvp.data());
+        });
+        engine::bench::DoNotOptimize(wvp.front());
+
+        std::printf("%10zu %11.2f us %11.2f us %9.2f ns %9.2f ns %8.2fx\n",
+                    count,
+                    scalarNs / 1000.0,
+                    batchNs / 1000.0,
+                    scalarNs / static_cast<double>(count),
+                    batchNs / static_cast<double>(count),
+                    batchNs > 0.0 ? scalarNs / batchNs : 0.0);
+    }
+
+    return ok ? 0 : 1;
+}
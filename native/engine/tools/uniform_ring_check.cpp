@@ -0,0 +1,260 @@
+// Exercises the per-frame uniform ring (engine/core/uniform_ring.h) on a
+// headless EGL context.
+//
+// Correctness: it renders several times more frames than the ring has
+// segments, without waiting on the GPU in between. Each frame draws one-pixel
+// quads into its own row, coloured from that frame's object blocks. The
+// image is read back only at the end, so a block overwritten while its frame
+// was still in flight would show up as a wrong pixel.
+//
+// Cost: it times the CPU side of many small draws, with the uniforms set by
+// glUniform* per draw versus written to the ring and bound by offset.
+//
+// Exits non-zero on a wrong pixel or a GL error.
+
+#include <GLES3/gl3.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "headless_egl.h"
+#include "engine/core/gl_state_cache.h"
+#include "engine/core/shader_program.h"
+#include "engine/core/uniform_ring.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kObjectsPerFrame = 64;
+constexpr int kFrames = engine::UniformRing::kFramesInFlight * 4;
+constexpr int kTimedDraws = 10'000;
+constexpr int kTimedFrames = 10;
+constexpr GLuint kFrameBinding = 0;
+constexpr GLuint kObjectBinding = 1;
+
+// One quad from gl_VertexID; no vertex buffers needed.
+const char* kVertexBody = R"(
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    gl_Position = vec4(mix(uRect.xy, uRect.zw, corner), 0.0, 1.0);
+}
+)";
+
+const char* kFragmentBody = R"(
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(uColor.rgb + uTint.rgb, 1.0);
+}
+)";
+
+const char* kBlockDeclarations = R"(
+layout(std140) uniform FrameUniforms {
+    highp vec4 uTint;
+};
+layout(std140) uniform ObjectUniforms {
+    highp vec4 uRect;
+    highp vec4 uColor;
+};
+)";
+
+const char* kPlainDeclarations = R"(
+uniform highp vec4 uTint;
+uniform highp vec4 uRect;
+uniform highp vec4 uColor;
+)";
+
+struct FrameBlock {
+    float tint[4];
+};
+
+struct ObjectBlock {
+    float rect[4];
+    float color[4];
+};
+
+std::string Source(const char* header, const char* declarations, const char* body) {
+    return std::string(header) + declarations + body;
+}
+
+// Exact 8-bit values so the read-back can be compared exactly.
+uint8_t ExpectedChannel(int frame, int object, int channel) {
+    return static_cast<uint8_t>((frame * 37 + object * 11 + channel * 71) % 200 + 20);
+}
+
+ObjectBlock MakeObject(int frame, int object, int width, int height) {
+    ObjectBlock block{};
+    block.rect[0] = -1.0f + 2.0f * object / width;
+    block.rect[1] = -1.0f + 2.0f * frame / height;
+    block.rect[2] = -1.0f + 2.0f * (object + 1) / width;
+    block.rect[3] = -1.0f + 2.0f * (frame + 1) / height;
+    for (int c = 0; c < 3; ++c) {
+        // 10/255 of each channel comes from the frame block, so both blocks are checked.
+        block.color[c] = static_cast<float>(ExpectedChannel(frame, object, c) - 10) / 255.0f;
+    }
+    return block;
+}
+
+template <typename Block>
+GLintptr Write(engine::UniformRing& ring, const Block& block) {
+    GLintptr offset = 0;
+    if (void* destination = ring.Allocate(sizeof(Block), &offset)) {
+        std::memcpy(destination, &block, sizeof(Block));
+    }
+    return offset;
+}
+
+void BindBlocks(GLuint program) {
+    glUniformBlockBinding(program, glGetUniformBlockIndex(program, "FrameUniforms"), kFrameBinding);
+    glUniformBlockBinding(program, glGetUniformBlockIndex(program, "ObjectUniforms"), kObjectBinding);
+}
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+int main() {
+    engine::tools::HeadlessContext headless;
+    if (!headless.Create()) {
+        std::fprintf(stderr, "No headless EGL/GLES 3 context available (0x%x)\n", eglGetError());
+        return 1;
+    }
+
+    const char* vertexHeader = "#version 300 es\n";
+    const char* fragmentHeader = "#version 300 es\nprecision mediump float;\n";
+    engine::ShaderProgram ringProgram;
+    engine::ShaderProgram plainProgram;
+    if (!ringProgram.Compile(Source(vertexHeader, kBlockDeclarations, kVertexBody).c_str(),
+                             Source(fragmentHeader, kBlockDeclarations, kFragmentBody).c_str()) ||
+        !plainProgram.Compile(Source(vertexHeader, kPlainDeclarations, kVertexBody).c_str(),
+                              Source(fragmentHeader, kPlainDeclarations, kFragmentBody).c_str())) {
+        std::fprintf(stderr, "Failed to build the test programs\n");
+        return 1;
+    }
+    BindBlocks(ringProgram.Id());
+    const GLint tintLocation = glGetUniformLocation(plainProgram.Id(), "uTint");
+    const GLint rectLocation = glGetUniformLocation(plainProgram.Id(), "uRect");
+    const GLint colorLocation = glGetUniformLocation(plainProgram.Id(), "uColor");
+
+    engine::UniformRing ring;
+    if (!ring.Initialize(1024)) {
+        std::fprintf(stderr, "Failed to create the uniform ring\n");
+        return 1;
+    }
+
+    const int width = kObjectsPerFrame;
+    const int height = kFrames;
+    GLuint framebuffer = 0;
+    GLuint colorbuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colorbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorbuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::fprintf(stderr, "Offscreen framebuffer incomplete\n");
+        return 1;
+    }
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    engine::GlStateCache& state = engine::GlStateCache::Current();
+    state.BindVertexArray(vao);
+    state.UseProgram(ringProgram.Id());
+
+    // Frames back to back through the ring, read back once at the end.
+    const std::size_t objectBytes = ring.AlignedSize(sizeof(ObjectBlock));
+    std::vector<GLintptr> objectOffsets(kObjectsPerFrame);
+    for (int frame = 0; frame < kFrames; ++frame) {
+        ring.BeginFrame(ring.AlignedSize(sizeof(FrameBlock)) + kObjectsPerFrame * objectBytes);
+        const GLintptr frameOffset = Write(ring, FrameBlock{{10.0f / 255.0f, 10.0f / 255.0f, 10.0f / 255.0f, 0.0f}});
+        for (int object = 0; object < kObjectsPerFrame; ++object) {
+            objectOffsets[object] = Write(ring, MakeObject(frame, object, width, height));
+        }
+        ring.Flush();
+        ring.Bind(kFrameBinding, frameOffset, sizeof(FrameBlock));
+        for (int object = 0; object < kObjectsPerFrame; ++object) {
+            ring.Bind(kObjectBinding, objectOffsets[object], sizeof(ObjectBlock));
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        ring.EndFrame();
+    }
+
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    int wrong = 0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        for (int object = 0; object < kObjectsPerFrame; ++object) {
+            const uint8_t* pixel = &pixels[(static_cast<std::size_t>(frame) * width + object) * 4];
+            for (int c = 0; c < 3; ++c) {
+                if (std::abs(pixel[c] - ExpectedChannel(frame, object, c)) > 1) {
+                    ++wrong;
+                    break;
+                }
+            }
+        }
+    }
+    std::printf("%d frames through %d ring segments (alignment %zu B): %d of %d pixels wrong\n", kFrames,
+                engine::UniformRing::kFramesInFlight, ring.AlignedSize(1), wrong, kFrames * kObjectsPerFrame);
+
+    // CPU cost of the uniform traffic for kTimedDraws one-pixel draws.
+    double plainMs = 0.0;
+    double ringMs = 0.0;
+    for (int frame = 0; frame < kTimedFrames; ++frame) {
+        Clock::time_point start = Clock::now();
+        state.UseProgram(plainProgram.Id());
+        glUniform4f(tintLocation, 0.0f, 0.0f, 0.0f, 0.0f);
+        for (int draw = 0; draw < kTimedDraws; ++draw) {
+            const ObjectBlock block = MakeObject(0, draw % width, width, height);
+            glUniform4fv(rectLocation, 1, block.rect);
+            glUniform4fv(colorLocation, 1, block.color);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        plainMs += MsSince(start);
+        glFinish();
+
+        start = Clock::now();
+        state.UseProgram(ringProgram.Id());
+        ring.BeginFrame(ring.AlignedSize(sizeof(FrameBlock)) + kTimedDraws * objectBytes);
+        const GLintptr frameOffset = Write(ring, FrameBlock{});
+        objectOffsets.resize(kTimedDraws);
+        for (int draw = 0; draw < kTimedDraws; ++draw) {
+            objectOffsets[draw] = Write(ring, MakeObject(0, draw % width, width, height));
+        }
+        ring.Flush();
+        ring.Bind(kFrameBinding, frameOffset, sizeof(FrameBlock));
+        for (int draw = 0; draw < kTimedDraws; ++draw) {
+            ring.Bind(kObjectBinding, objectOffsets[draw], sizeof(ObjectBlock));
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        ring.EndFrame();
+        ringMs += MsSince(start);
+        glFinish();
+    }
+    std::printf("%d draws/frame CPU: glUniform per draw %.3f ms, ring + bind range %.3f ms\n", kTimedDraws,
+                plainMs / kTimedFrames, ringMs / kTimedFrames);
+
+    bool ok = wrong == 0;
+    const GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        std::fprintf(stderr, "GL error 0x%x\n", glError);
+        ok = false;
+    }
+
+    ring.Destroy();
+    state.DeleteVertexArrays(1, &vao);
+    glDeleteRenderbuffers(1, &colorbuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    return ok ? 0 : 1;
+}